@@ -0,0 +1,77 @@
+// Benchmark: arrival-stream fast path against the general virtual-time engines.
+//
+// For 10k, 100k and 1M trucks (one station per 25 trucks) it runs the full 72 hour
+// simulation with EVENT_DRIVEN on its fastest event queue (timing wheel), FIXED_STEP and
+// ARRIVAL_STREAM, checks ARRIVAL_STREAM matches FIXED_STEP and reports truck-cycles per second.
+#include <iostream>
+#include <iomanip>
+#include <span>
+#include <chrono>
+
+#include "../include/Simulator.h"
+#include "../include/WorkloadRecursion.h"
+
+namespace
+{
+    constexpr int kTrucksPerStation = 25; // Keeps stations busy without a permanent queue
+    constexpr std::uint64_t kSeed = 2024; // Same mining durations for every engine
+
+    using Clock = std::chrono::steady_clock;
+
+    struct EngineResult
+    {
+        double cyclesPerSecond; // Completed truck cycles (unloads) per second
+        long long totalHelium;  // Helium unloaded by every truck
+        long long totalWait;    // Queue wait of every truck, to check the engines agree
+    };
+
+    EngineResult runEngine(const int numTrucks, const Simulator::EngineMode engineMode)
+    {
+        Simulator miningSim(numTrucks, numTrucks / kTrucksPerStation, engineMode);
+        miningSim.setSeed(kSeed);
+        miningSim.setWriteSummary(false);
+        miningSim.setEventQueue(EventQueue::Kind::TIMING_WHEEL);
+
+        const auto start = Clock::now();
+        miningSim.startSimulator();
+        const std::chrono::duration<double> seconds = Clock::now() - start;
+
+        EngineResult result{0.0, 0, 0};
+        long long numCycles = 0;
+        for (const Truck &truck : miningSim.getTruckView())
+        {
+            numCycles += truck.getTotalNumberUnloads();
+            result.totalHelium += truck.getTotalMinedHelium();
+            result.totalWait += truck.getTotalQueueWait();
+        }
+        result.cyclesPerSecond = numCycles / seconds.count();
+        return result;
+    }
+}
+
+int main()
+{
+    std::cout << "Arrival-stream benchmark (1 thread, " << WorkloadRecursion::getInstructionSet() << "), truck-cycles per second" << std::endl
+              << std::endl
+              << std::left << std::setw(10) << "Trucks"
+              << std::right << std::setw(16) << "EVENT_DRIVEN" << std::setw(16) << "FIXED_STEP" << std::setw(16) << "ARRIVAL_STREAM"
+              << std::setw(12) << "vs EVENT" << std::setw(12) << "vs FIXED" << std::setw(8) << "Match" << std::endl;
+
+    for (const int numTrucks : {10000, 100000, 1000000})
+    {
+        const EngineResult eventDriven = runEngine(numTrucks, Simulator::EngineMode::EVENT_DRIVEN);
+        const EngineResult fixedStep = runEngine(numTrucks, Simulator::EngineMode::FIXED_STEP);
+        const EngineResult arrivalStream = runEngine(numTrucks, Simulator::EngineMode::ARRIVAL_STREAM);
+        const bool isMatching = (fixedStep.totalHelium == arrivalStream.totalHelium) && (fixedStep.totalWait == arrivalStream.totalWait);
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::left << std::setw(10) << numTrucks
+                  << std::right << std::setw(16) << eventDriven.cyclesPerSecond << std::setw(16) << fixedStep.cyclesPerSecond
+                  << std::setw(16) << arrivalStream.cyclesPerSecond << std::setprecision(1)
+                  << std::setw(11) << (arrivalStream.cyclesPerSecond / eventDriven.cyclesPerSecond) << "x"
+                  << std::setw(11) << (arrivalStream.cyclesPerSecond / fixedStep.cyclesPerSecond) << "x"
+                  << std::setw(8) << (isMatching ? "yes" : "NO") << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
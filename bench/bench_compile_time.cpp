@@ -0,0 +1,82 @@
+// Benchmark: compile-time scenario engine against the runtime-configurable engine.
+//
+// For 10k, 100k and 1M trucks (one station per 25 trucks) it runs the full 72 hour
+// simulation with Simulator in EVENT_DRIVEN mode and with SimulatorT<DefaultScenario>,
+// checks both unloaded the same helium and reports truck-cycles per second on one core.
+#include <iostream>
+#include <iomanip>
+#include <span>
+#include <chrono>
+
+#include "../include/Simulator.h"
+#include "../include/SimulatorT.h"
+
+namespace
+{
+    constexpr int kTrucksPerStation = 25; // Keeps stations busy without a permanent queue
+    constexpr std::uint64_t kSeed = 2024; // Same mining durations for both engines
+
+    using Clock = std::chrono::steady_clock;
+
+    struct EngineResult
+    {
+        double cyclesPerSecond; // Completed truck cycles (unloads) per second
+        long long totalHelium;  // Helium unloaded by every truck, to check both engines agree
+    };
+
+    EngineResult summarize(const std::span<const Truck> trucks, const std::chrono::duration<double> seconds)
+    {
+        long long numCycles = 0;
+        long long totalHelium = 0;
+        for (const Truck &truck : trucks)
+        {
+            numCycles += truck.getTotalNumberUnloads();
+            totalHelium += truck.getTotalMinedHelium();
+        }
+        return {numCycles / seconds.count(), totalHelium};
+    }
+
+    EngineResult runRuntimeEngine(const int numTrucks)
+    {
+        Simulator miningSim(numTrucks, numTrucks / kTrucksPerStation, Simulator::EngineMode::EVENT_DRIVEN);
+        miningSim.setSeed(kSeed);
+        miningSim.setWriteSummary(false);
+
+        const auto start = Clock::now();
+        miningSim.startSimulator();
+        return summarize(miningSim.getTruckView(), Clock::now() - start);
+    }
+
+    EngineResult runCompileTimeEngine(const int numTrucks)
+    {
+        SimulatorT<DefaultScenario> miningSim(numTrucks, numTrucks / kTrucksPerStation);
+        miningSim.setSeed(kSeed);
+
+        const auto start = Clock::now();
+        miningSim.startSimulator();
+        return summarize(miningSim.getTruckView(), Clock::now() - start);
+    }
+}
+
+int main()
+{
+    std::cout << "Compile-time scenario benchmark (1 thread), truck-cycles per second" << std::endl
+              << std::endl
+              << std::left << std::setw(10) << "Trucks"
+              << std::right << std::setw(16) << "EVENT_DRIVEN" << std::setw(16) << "SimulatorT"
+              << std::setw(10) << "Speedup" << std::setw(10) << "Match" << std::endl;
+
+    for (const int numTrucks : {10000, 100000, 1000000})
+    {
+        const EngineResult runtime = runRuntimeEngine(numTrucks);
+        const EngineResult compileTime = runCompileTimeEngine(numTrucks);
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::left << std::setw(10) << numTrucks
+                  << std::right << std::setw(16) << runtime.cyclesPerSecond << std::setw(16) << compileTime.cyclesPerSecond
+                  << std::setw(9) << std::setprecision(1) << (compileTime.cyclesPerSecond / runtime.cyclesPerSecond) << "x"
+                  << std::setw(10) << ((runtime.totalHelium == compileTime.totalHelium) ? "yes" : "NO") << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
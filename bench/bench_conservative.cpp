@@ -0,0 +1,81 @@
+// Benchmark: conservative parallel engine against the sequential event loop.
+//
+// For 100k trucks (one station per 25 trucks) it runs the full 72 hour simulation with
+// EVENT_DRIVEN on its fastest event queue (timing wheel), FIXED_STEP and CONSERVATIVE on 1, 2,
+// 4, 8 and 16 worker threads, checks every CONSERVATIVE run matches FIXED_STEP's totals, and
+// reports wall time and speedup. Speedup needs as many free cores as worker threads.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+
+#include "../include/Simulator.h"
+
+namespace
+{
+    constexpr int kNumTrucks = 100000;    // Large mine where one event loop is the bottleneck
+    constexpr int kTrucksPerStation = 25; // Keeps stations busy without a permanent queue
+    constexpr std::uint64_t kSeed = 2024; // Same mining durations for every run
+
+    using Clock = std::chrono::steady_clock;
+
+    struct EngineResult
+    {
+        double millis;         // Wall time of the simulation
+        long long totalHelium; // Helium unloaded by every truck
+        long long totalWait;   // Queue wait of every truck, to check the runs agree
+    };
+
+    EngineResult runEngine(const Simulator::EngineMode engineMode, const int numWorkerThreads)
+    {
+        Simulator miningSim(kNumTrucks, kNumTrucks / kTrucksPerStation, engineMode);
+        miningSim.setSeed(kSeed);
+        miningSim.setWriteSummary(false);
+        miningSim.setEventQueue(EventQueue::Kind::TIMING_WHEEL);
+        miningSim.setNumWorkerThreads(numWorkerThreads);
+
+        const auto start = Clock::now();
+        miningSim.startSimulator();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+        EngineResult result{elapsed.count(), 0, 0};
+        for (const Truck &truck : miningSim.getTruckView())
+        {
+            result.totalHelium += truck.getTotalMinedHelium();
+            result.totalWait += truck.getTotalQueueWait();
+        }
+        return result;
+    }
+}
+
+int main()
+{
+    const EngineResult sequential = runEngine(Simulator::EngineMode::EVENT_DRIVEN, 1);
+    const EngineResult fixedStep = runEngine(Simulator::EngineMode::FIXED_STEP, 1);
+
+    std::cout << "Conservative PDES benchmark, " << kNumTrucks << " trucks, " << kNumTrucks / kTrucksPerStation << " stations, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl
+              << "EVENT_DRIVEN (timing wheel): " << std::fixed << std::setprecision(1) << sequential.millis << " ms, FIXED_STEP: " << fixedStep.millis << " ms" << std::endl
+              << std::endl
+              << std::left << std::setw(10) << "Threads"
+              << std::right << std::setw(12) << "ms" << std::setw(12) << "vs 1" << std::setw(12) << "vs EVENT" << std::setw(8) << "Match" << std::endl;
+
+    double singleThreadMillis = 0.0;
+    for (const int numWorkerThreads : {1, 2, 4, 8, 16})
+    {
+        const EngineResult conservative = runEngine(Simulator::EngineMode::CONSERVATIVE, numWorkerThreads);
+        if (numWorkerThreads == 1)
+        {
+            singleThreadMillis = conservative.millis;
+        }
+        const bool isMatching = (conservative.totalHelium == fixedStep.totalHelium) && (conservative.totalWait == fixedStep.totalWait);
+
+        std::cout << std::left << std::setw(10) << numWorkerThreads
+                  << std::right << std::setw(12) << conservative.millis
+                  << std::setw(11) << (singleThreadMillis / conservative.millis) << "x"
+                  << std::setw(11) << (sequential.millis / conservative.millis) << "x"
+                  << std::setw(8) << (isMatching ? "yes" : "NO") << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+// Benchmark: queue wait and helium throughput of every dispatch policy, and the THREADED lanes.
+//
+// Part one runs 30 EVENT_DRIVEN replications per policy on the same seeds for a heavily loaded
+// (100 trucks / 2 stations), a balanced (200 / 4), a lightly loaded (60 / 3) and a large (1000 / 40)
+// yard, and prints the mean queue wait per unload with its 95% confidence half width and the helium
+// unloaded per hour. Part two runs 500 trucks / 20 stations THREADED at 50 us per minute with the
+// shared lane and with one lane per station, and prints the wall time and the mean wake-up drift.
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "../include/Simulator.h"
+#include "../include/Dispatcher.h"
+#include "../include/ReplicationRunner.h"
+
+namespace
+{
+    constexpr int kNumReplications = 30;  // Replications per policy and yard
+    constexpr std::uint64_t kSeed = 2024; // Same mining durations for every policy
+
+    using Clock = std::chrono::steady_clock;
+
+    const Dispatcher::Kind kKinds[] = {Dispatcher::Kind::SHARED_QUEUE, Dispatcher::Kind::JOIN_SHORTEST_QUEUE, Dispatcher::Kind::POWER_OF_TWO,
+                                       Dispatcher::Kind::ROUND_ROBIN, Dispatcher::Kind::LEAST_EXPECTED_WORK};
+}
+
+int main()
+{
+    const SimulationConfig config;
+
+    std::cout << "Dispatch policies, " << kNumReplications << " EVENT_DRIVEN replications each" << std::endl
+              << std::endl
+              << std::left << std::setw(14) << "Trucks/Sta" << std::setw(22) << "Policy"
+              << std::right << std::setw(16) << "Wait/unload" << std::setw(12) << "95% CI" << std::setw(16) << "Helium/hour" << std::endl;
+
+    for (const auto &[numTrucks, numStations] : {std::pair{100, 2}, std::pair{200, 4}, std::pair{60, 3}, std::pair{1000, 40}})
+    {
+        for (const Dispatcher::Kind kind : kKinds)
+        {
+            ReplicationRunner replications(numTrucks, numStations, kNumReplications);
+            replications.setMasterSeed(kSeed);
+            std::string error;
+            if (!replications.setDispatchPolicy(kind, error) || !replications.run(error))
+            {
+                std::cerr << error << std::endl;
+                return 1;
+            }
+
+            // Wait per unload of each replication, then over the replications
+            const std::vector<double> queueWaits = replications.getSamples(ReplicationRunner::TRUCK_QUEUE_WAIT);
+            const std::vector<double> unloads = replications.getSamples(ReplicationRunner::TRUCK_UNLOADED_TRIPS);
+            std::vector<double> waitsPerUnload;
+            for (std::size_t i = 0; i < queueWaits.size(); ++i)
+            {
+                waitsPerUnload.push_back(queueWaits[i] / std::max(unloads[i], 1.0));
+            }
+            const ReplicationRunner::Statistic waitPerUnload = ReplicationRunner::summarize(waitsPerUnload);
+            const double heliumPerHour = replications.getStatistic(ReplicationRunner::STATION_HELIUM_RECEIVED).mean * numStations * 60.0 / config.horizonMins;
+
+            std::cout << std::left << std::setw(14) << (std::to_string(numTrucks) + "/" + std::to_string(numStations))
+                      << std::setw(22) << Dispatcher::getName(kind)
+                      << std::right << std::fixed << std::setprecision(2) << std::setw(16) << waitPerUnload.mean
+                      << std::setw(12) << waitPerUnload.confidenceHalfWidth << std::setw(16) << heliumPerHour << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "THREADED lanes, 500 trucks / 20 stations at 50 us per minute" << std::endl
+              << std::endl
+              << std::left << std::setw(22) << "Policy" << std::right << std::setw(14) << "Wall ms" << std::setw(18) << "Mean drift us" << std::endl;
+    for (const Dispatcher::Kind kind : kKinds)
+    {
+        Simulator miningSim(500, 20);
+        miningSim.setSeed(kSeed);
+        miningSim.setWriteSummary(false);
+        miningSim.setTimeScale(std::chrono::microseconds(50));
+        miningSim.setDispatchPolicy(kind);
+
+        const auto start = Clock::now();
+        miningSim.startSimulator();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        const std::chrono::duration<double, std::micro> meanDrift = miningSim.getDriftReport().meanDrift;
+
+        std::cout << std::left << std::setw(22) << Dispatcher::getName(kind)
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(14) << elapsed.count()
+                  << std::setw(18) << meanDrift.count() << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
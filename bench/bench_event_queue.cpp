@@ -0,0 +1,130 @@
+// Benchmark: insert/pop cost of every EventQueue on traces of real Simulator runs.
+//
+// For 1k, 10k and 100k trucks (one station per 25 trucks) it records a binary trace of a
+// 72 hour EVENT_DRIVEN run and replays it as a hold model: every truck's transitions are
+// events at their traced times, each popped event inserts the truck's next one, and every
+// unload also inserts the station's completion 5 minutes later. This keeps the run's mix of
+// 60-300 minute mining, fixed 30 minute travel and 5 minute unload delays and its ties.
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "../include/Simulator.h"
+#include "../include/EventQueue.h"
+#include "../include/TraceFile.h"
+
+namespace
+{
+    constexpr int kTrucksPerStation = 25;                             // Keeps stations busy without a permanent queue
+    constexpr std::uint64_t kSeed = 2024;                             // Same trace for every structure
+    constexpr const char *kTracePath = "Bench_Event_Queue_Trace.bin"; // Temporary trace, removed after reading
+
+    using Clock = std::chrono::steady_clock;
+
+    struct TracedTransition
+    {
+        int time;      // Minute of the transition
+        int stationId; // Station that unloaded the truck, -1 if none
+    };
+
+    // Transitions of every truck in time order, read from the trace of a real run
+    std::vector<std::vector<TracedTransition>> recordTrace(const int numTrucks)
+    {
+        Simulator miningSim(numTrucks, numTrucks / kTrucksPerStation, Simulator::EngineMode::EVENT_DRIVEN);
+        miningSim.setSeed(kSeed);
+        miningSim.setWriteSummary(false);
+        miningSim.setTraceFile(kTracePath);
+        miningSim.startSimulator();
+
+        std::vector<TraceRecord> records;
+        TraceFile::read(kTracePath, records);
+        std::remove(kTracePath);
+
+        std::vector<std::vector<TracedTransition>> transitions(numTrucks);
+        for (const TraceRecord &record : records)
+        {
+            transitions[record.truckId].push_back({record.timestamp, record.stationId});
+        }
+        return transitions;
+    }
+
+    // Returns nanoseconds per hold (one pop plus its inserts) and counts the holds
+    double replay(const EventQueue::Kind kind, const std::vector<std::vector<TracedTransition>> &transitions, long long &numHolds)
+    {
+        std::unique_ptr<EventQueue> queue = EventQueue::create(kind);
+        std::vector<std::size_t> nextTransition(transitions.size(), 0);
+        long long sequence = 0;
+        numHolds = 0;
+
+        const auto start = Clock::now();
+        for (std::size_t id = 0; id < transitions.size(); ++id)
+        {
+            if (!transitions[id].empty())
+            {
+                queue->push(Event(transitions[id][0].time, sequence++, Event::TRUCK_STATE_COMPLETE, static_cast<int>(id)));
+            }
+        }
+        while (!queue->empty())
+        {
+            const Event event = queue->pop();
+            ++numHolds;
+            if (event.getType() != Event::TRUCK_STATE_COMPLETE)
+            {
+                continue;
+            }
+
+            const std::vector<TracedTransition> &truckTransitions = transitions[event.getId()];
+            const TracedTransition &current = truckTransitions[nextTransition[event.getId()]++];
+            if (current.stationId >= 0)
+            {
+                queue->push(Event(current.time + Simulator::kUnloadTimeMins, sequence++, Event::STATION_UNLOAD_COMPLETE, current.stationId));
+            }
+            if (nextTransition[event.getId()] < truckTransitions.size())
+            {
+                queue->push(Event(truckTransitions[nextTransition[event.getId()]].time, sequence++, Event::TRUCK_STATE_COMPLETE, event.getId()));
+            }
+        }
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        return elapsed.count() / numHolds;
+    }
+}
+
+int main()
+{
+    const EventQueue::Kind kinds[] = {EventQueue::Kind::BINARY_HEAP, EventQueue::Kind::PAIRING_HEAP,
+                                      EventQueue::Kind::CALENDAR_QUEUE, EventQueue::Kind::TIMING_WHEEL};
+
+    std::cout << "Event queue benchmark on Simulator traces, nanoseconds per hold (pop + inserts)" << std::endl
+              << std::endl
+              << std::left << std::setw(10) << "Trucks" << std::setw(12) << "Events";
+    for (const EventQueue::Kind kind : kinds)
+    {
+        std::cout << std::right << std::setw(16) << EventQueue::getName(kind);
+    }
+    std::cout << std::endl;
+
+    for (const int numTrucks : {1000, 10000, 100000})
+    {
+        const std::vector<std::vector<TracedTransition>> transitions = recordTrace(numTrucks);
+
+        long long numHolds = 0;
+        std::vector<double> nanosPerHold;
+        for (const EventQueue::Kind kind : kinds)
+        {
+            nanosPerHold.push_back(replay(kind, transitions, numHolds));
+        }
+
+        std::cout << std::left << std::setw(10) << numTrucks << std::setw(12) << numHolds
+                  << std::right << std::fixed << std::setprecision(1);
+        for (const double nanos : nanosPerHold)
+        {
+            std::cout << std::setw(16) << nanos;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+// Benchmark: truck-cycles per second of the virtual-time engines on one core.
+//
+// For 10k, 100k and 1M trucks (one station per 25 trucks) it runs the full 72 hour
+// simulation with EVENT_DRIVEN, WORKER_POOL on a single worker and FIXED_STEP and
+// reports completed unload cycles per second of wall clock time.
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+
+#include "../include/Simulator.h"
+#include "../include/FixedStepKernel.h"
+
+namespace
+{
+    constexpr int kTrucksPerStation = 25; // Keeps stations busy without a permanent queue
+    constexpr std::uint64_t kSeed = 2024; // Same mining durations for every engine
+
+    using Clock = std::chrono::steady_clock;
+
+    // Returns completed truck cycles (unloads) per second
+    double runEngine(const Simulator::EngineMode engineMode, const int numTrucks)
+    {
+        Simulator miningSim(numTrucks, numTrucks / kTrucksPerStation, engineMode);
+        miningSim.setSeed(kSeed);
+        miningSim.setWriteSummary(false);
+        miningSim.setNumWorkerThreads(1);
+
+        const auto start = Clock::now();
+        miningSim.startSimulator();
+        const std::chrono::duration<double> seconds = Clock::now() - start;
+
+        long long numCycles = 0;
+        for (const Truck &truck : miningSim.getTruckView())
+        {
+            numCycles += truck.getTotalNumberUnloads();
+        }
+        return numCycles / seconds.count();
+    }
+}
+
+int main()
+{
+    std::cout << "Virtual-time engine benchmark (1 thread, kernel compiled for "
+              << FixedStepKernel::getInstructionSet() << "), truck-cycles per second" << std::endl
+              << std::endl
+              << std::left << std::setw(10) << "Trucks"
+              << std::right << std::setw(16) << "EVENT_DRIVEN" << std::setw(16) << "WORKER_POOL"
+              << std::setw(16) << "FIXED_STEP" << std::setw(10) << "Speedup" << std::endl;
+
+    for (const int numTrucks : {10000, 100000, 1000000})
+    {
+        const double eventDriven = runEngine(Simulator::EngineMode::EVENT_DRIVEN, numTrucks);
+        const double workerPool = runEngine(Simulator::EngineMode::WORKER_POOL, numTrucks);
+        const double fixedStep = runEngine(Simulator::EngineMode::FIXED_STEP, numTrucks);
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::left << std::setw(10) << numTrucks
+                  << std::right << std::setw(16) << eventDriven << std::setw(16) << workerPool
+                  << std::setw(16) << fixedStep
+                  << std::setw(9) << std::setprecision(1) << (fixedStep / eventDriven) << "x" << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
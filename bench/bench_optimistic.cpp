@@ -0,0 +1,87 @@
+// Benchmark: optimistic Time Warp engine against the conservative one.
+//
+// On the high-contention 1000 trucks / 3 stations mine, a 10000 trucks / 40 stations mine and
+// the 100k trucks / 4000 stations mine of bench_conservative it runs CONSERVATIVE and
+// OPTIMISTIC on 1, 2, 4 and 8 worker threads, checks both match FIXED_STEP, and reports wall
+// time with the rollbacks, anti-messages, GVT rounds and peak saved states of OPTIMISTIC.
+// Small mines repeat each run so the times are measurable.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include "../include/Simulator.h"
+
+namespace
+{
+    constexpr std::uint64_t kSeed = 2024; // Same mining durations for every run
+
+    using Clock = std::chrono::steady_clock;
+
+    struct EngineResult
+    {
+        double millis;                  // Mean wall time of one simulation
+        long long totalHelium;          // Helium unloaded by every truck
+        long long totalWait;            // Queue wait of every truck, to check the runs agree
+        Simulator::TimeWarpStats stats; // Speculation of the last OPTIMISTIC run
+    };
+
+    EngineResult runEngine(const int numTrucks, const int numStations, const Simulator::EngineMode engineMode,
+                           const int numWorkerThreads, const int numRepeats)
+    {
+        Simulator miningSim(numTrucks, numStations, engineMode);
+        miningSim.setSeed(kSeed);
+        miningSim.setWriteSummary(false);
+        miningSim.setNumWorkerThreads(numWorkerThreads);
+
+        const auto start = Clock::now();
+        for (int repeat = 0; repeat < numRepeats; ++repeat)
+        {
+            miningSim.startSimulator();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+        EngineResult result{elapsed.count() / numRepeats, 0, 0, miningSim.getTimeWarpStats()};
+        for (const Truck &truck : miningSim.getTruckView())
+        {
+            result.totalHelium += truck.getTotalMinedHelium();
+            result.totalWait += truck.getTotalQueueWait();
+        }
+        return result;
+    }
+}
+
+int main()
+{
+    const int mines[][3] = {{1000, 3, 50}, {10000, 40, 5}, {100000, 4000, 1}}; // Trucks, stations, repeats
+
+    std::cout << "Time Warp benchmark, " << std::thread::hardware_concurrency() << " hardware threads, ms per simulation" << std::endl
+              << std::endl
+              << std::left << std::setw(16) << "Mine" << std::setw(9) << "Threads"
+              << std::right << std::setw(14) << "CONSERVATIVE" << std::setw(12) << "OPTIMISTIC" << std::setw(10) << "Ratio"
+              << std::setw(11) << "Rollbacks" << std::setw(8) << "Anti" << std::setw(8) << "GVTs" << std::setw(9) << "Saved"
+              << std::setw(8) << "Match" << std::endl;
+
+    for (const auto &mine : mines)
+    {
+        const EngineResult fixedStep = runEngine(mine[0], mine[1], Simulator::EngineMode::FIXED_STEP, 1, 1);
+        for (const int numWorkerThreads : {1, 2, 4, 8})
+        {
+            const EngineResult conservative = runEngine(mine[0], mine[1], Simulator::EngineMode::CONSERVATIVE, numWorkerThreads, mine[2]);
+            const EngineResult optimistic = runEngine(mine[0], mine[1], Simulator::EngineMode::OPTIMISTIC, numWorkerThreads, mine[2]);
+            const bool isMatching = (conservative.totalHelium == fixedStep.totalHelium) && (conservative.totalWait == fixedStep.totalWait) &&
+                                    (optimistic.totalHelium == fixedStep.totalHelium) && (optimistic.totalWait == fixedStep.totalWait);
+
+            std::cout << std::left << std::setw(16) << (std::to_string(mine[0]) + "/" + std::to_string(mine[1])) << std::setw(9) << numWorkerThreads
+                      << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(14) << conservative.millis << std::setw(12) << optimistic.millis
+                      << std::setw(9) << (conservative.millis / optimistic.millis) << "x"
+                      << std::setw(11) << optimistic.stats.numRollbacks << std::setw(8) << optimistic.stats.numAntiMessages
+                      << std::setw(8) << optimistic.stats.numGvtRounds << std::setw(9) << optimistic.stats.peakSavedStates
+                      << std::setw(8) << (isMatching ? "yes" : "NO") << std::endl;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+// Benchmark: station unload queue, MpmcQueue vs the former std::vector + std::mutex path.
+//
+// For 1k, 10k and 100k trucks it measures pushes and pops per second in two patterns:
+//   burst      - every truck is queued first and the stations drain the backlog afterwards
+//   concurrent - trucks and stations push and pop at the same time
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include "../include/MpmcQueue.h"
+#include "../include/Truck.h"
+
+namespace
+{
+    constexpr int kNumProducers = 4; // Truck threads pushing
+    constexpr int kNumConsumers = 4; // Station threads popping
+
+    // Former Simulator.cpp path: vector drained from the front under one mutex
+    class VectorMutexQueue
+    {
+    public:
+        explicit VectorMutexQueue(std::size_t) {}
+        bool tryPush(Truck *const &truck)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_data.push_back(truck);
+            return true;
+        }
+        bool tryPop(Truck *&truck)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_data.empty())
+            {
+                return false;
+            }
+            truck = m_data.front();
+            m_data.erase(m_data.begin());
+            return true;
+        }
+
+    private:
+        std::vector<Truck *> m_data;
+        std::mutex m_mutex;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    // Splits the trucks over the worker threads and runs body(first, last) on each
+    template <typename Body>
+    void runOnThreads(const int numThreads, const int numTrucks, Body body)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back(body, numTrucks * t / numThreads, numTrucks * (t + 1) / numThreads);
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    template <typename Queue>
+    void pushRange(Queue &queue, std::vector<Truck> &trucks, const int first, const int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            while (!queue.tryPush(&trucks[i]))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template <typename Queue>
+    void popRange(Queue &queue, const int first, const int last)
+    {
+        Truck *truck = nullptr;
+        for (int i = first; i < last; ++i)
+        {
+            while (!queue.tryPop(truck))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Returns operations (pushes + pops) per second
+    template <typename Queue>
+    double runBurst(std::vector<Truck> &trucks)
+    {
+        const int numTrucks = static_cast<int>(trucks.size());
+        Queue queue(numTrucks);
+        const auto start = Clock::now();
+        runOnThreads(kNumProducers, numTrucks, [&](int first, int last)
+                     { pushRange(queue, trucks, first, last); });
+        runOnThreads(kNumConsumers, numTrucks, [&](int first, int last)
+                     { popRange(queue, first, last); });
+        const std::chrono::duration<double> seconds = Clock::now() - start;
+        return (2.0 * numTrucks) / seconds.count();
+    }
+
+    template <typename Queue>
+    double runConcurrent(std::vector<Truck> &trucks)
+    {
+        const int numTrucks = static_cast<int>(trucks.size());
+        Queue queue(numTrucks);
+        const auto start = Clock::now();
+        std::thread producers([&]()
+                              { runOnThreads(kNumProducers, numTrucks, [&](int first, int last)
+                                             { pushRange(queue, trucks, first, last); }); });
+        runOnThreads(kNumConsumers, numTrucks, [&](int first, int last)
+                     { popRange(queue, first, last); });
+        producers.join();
+        const std::chrono::duration<double> seconds = Clock::now() - start;
+        return (2.0 * numTrucks) / seconds.count();
+    }
+}
+
+int main()
+{
+    std::cout << "Unload queue benchmark (" << kNumProducers << " truck threads, "
+              << kNumConsumers << " station threads), operations = pushes + pops" << std::endl
+              << std::endl
+              << std::left << std::setw(10) << "Trucks" << std::setw(12) << "Pattern"
+              << std::right << std::setw(20) << "vector+mutex ops/s" << std::setw(20) << "MpmcQueue ops/s"
+              << std::setw(10) << "Speedup" << std::endl;
+
+    for (const int numTrucks : {1000, 10000, 100000})
+    {
+        std::vector<Truck> trucks;
+        trucks.reserve(numTrucks);
+        for (int i = 0; i < numTrucks; ++i)
+        {
+            trucks.emplace_back(i);
+        }
+
+        const double burstVector = runBurst<VectorMutexQueue>(trucks);
+        const double burstMpmc = runBurst<MpmcQueue<Truck *>>(trucks);
+        const double concurrentVector = runConcurrent<VectorMutexQueue>(trucks);
+        const double concurrentMpmc = runConcurrent<MpmcQueue<Truck *>>(trucks);
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::left << std::setw(10) << numTrucks << std::setw(12) << "burst"
+                  << std::right << std::setw(20) << burstVector << std::setw(20) << burstMpmc
+                  << std::setw(9) << std::setprecision(1) << (burstMpmc / burstVector) << "x" << std::endl
+                  << std::setprecision(0)
+                  << std::left << std::setw(10) << numTrucks << std::setw(12) << "concurrent"
+                  << std::right << std::setw(20) << concurrentVector << std::setw(20) << concurrentMpmc
+                  << std::setw(9) << std::setprecision(1) << (concurrentMpmc / concurrentVector) << "x" << std::endl;
+    }
+
+    return 0;
+}
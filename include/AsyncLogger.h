@@ -0,0 +1,197 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ProfiledMutex.h"
+
+class AsyncLogger
+{
+public:
+  static constexpr std::size_t kMaxMessageLength = 254;      // Longer messages are truncated
+  static constexpr std::size_t kDefaultRingCapacity = 256;   // Messages a thread's ring starts with, 64 KiB
+  static constexpr std::size_t kMaxRingCapacity = 64 * 1024; // Messages a thread's ring can grow to, 16 MiB
+
+  /**
+   * @brief Initialize logger and start its drain thread.
+   *
+   * This function will start one background thread that collects the
+   * messages of every logging thread and writes them to the output in
+   * batches.
+   *
+   * @param output Stream the messages are written to, one per line
+   * @param ringCapacity Messages each thread can buffer before its ring grows
+   * @param maxRingCapacity Messages each thread can buffer before new ones are dropped
+   */
+  explicit AsyncLogger(std::ostream &output, const std::size_t ringCapacity = kDefaultRingCapacity,
+                       const std::size_t maxRingCapacity = kMaxRingCapacity);
+
+  /**
+   * @brief Write every buffered message and stop the drain thread.
+   */
+  ~AsyncLogger();
+
+  AsyncLogger(const AsyncLogger &) = delete;
+  AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+  /**
+   * @brief Format a message into the calling thread's ring buffer.
+   *
+   * This function will format the message straight into a fixed-size
+   * slot of the calling thread's single-producer ring, without locking
+   * or allocating. A full ring is replaced by one twice its size, so
+   * only threads that log in bursts use more memory. Once a ring has
+   * reached the largest capacity the message is dropped and counted
+   * instead of waiting for the drain thread.
+   *
+   * @param format Format string as for std::format
+   * @param args Format arguments
+   */
+  template <typename... Args>
+  void log(std::format_string<Args...> format, Args &&...args)
+  {
+    LogRing *ring = &threadRing();
+    std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) > ring->mask)
+    {
+      if (ring->mask + 1 >= m_maxRingCapacity)
+      {
+        m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      ring = &growRing(*ring);
+      tail = 0;
+    }
+
+    LogRecord &record = ring->records[tail & ring->mask];
+    const auto result = std::format_to_n(record.text, kMaxMessageLength, format, std::forward<Args>(args)...);
+    record.length = static_cast<unsigned short>(std::min<std::ptrdiff_t>(result.size, kMaxMessageLength));
+    ring->tail.store(tail + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Block until every message logged so far is written.
+   *
+   * This function will wait for the drain thread to write out every
+   * message logged before the call and flush the output stream.
+   */
+  void flush();
+
+  /**
+   * @brief Get number of dropped messages.
+   *
+   * @return Messages dropped because a thread's ring was full
+   */
+  std::size_t getDroppedMessages() const { return m_droppedMessages.load(std::memory_order_relaxed); }
+
+#ifdef DEBUG
+  /**
+   * @brief Get the lock profile of the ring registry.
+   *
+   * @return Profile of the lock taken by registering and draining threads
+   */
+  ProfiledMutex::Profile getLockProfile() { return m_ringsMutex.getProfile(); }
+#endif
+
+private:
+  static constexpr std::size_t kCacheLineSize = 64;     // Keeps producer and consumer positions on separate cache lines
+  static constexpr std::size_t kBatchBytes = 64 * 1024; // Drained text is written once this much is collected
+
+  struct LogRecord
+  {
+    unsigned short length;        // Number of valid characters in text
+    char text[kMaxMessageLength]; // Formatted message without newline
+  };
+
+  struct LogRing
+  {
+    LogRing(const std::size_t capacity, const std::thread::id ownerThread)
+        : records(std::make_unique<LogRecord[]>(capacity)), mask(capacity - 1), owner(ownerThread), next(nullptr), head(0), tail(0) {}
+
+    std::unique_ptr<LogRecord[]> records;                  // Ring storage, capacity is a power of two
+    std::size_t mask;                                      // capacity - 1
+    std::thread::id owner;                                 // Only thread allowed to produce into this ring
+    std::unique_ptr<LogRing> grown;                        // Larger ring the owner moved on to once this one was full
+    std::atomic<LogRing *> next;                           // grown.get(), published to the drain thread
+    alignas(kCacheLineSize) std::atomic<std::size_t> head; // Next record the drain thread reads
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail; // Next record the owner writes
+  };
+
+  /**
+   * @brief Get the calling thread's ring, creating it on first use.
+   *
+   * @return Ring the calling thread produces into
+   */
+  LogRing &threadRing();
+
+  /**
+   * @brief Create and register a ring for the calling thread.
+   *
+   * @return Newly registered ring
+   */
+  LogRing &registerThread();
+
+  /**
+   * @brief Replace the calling thread's full ring by one twice its size.
+   *
+   * This function will chain the new ring behind the full one. The
+   * owner no longer writes the full ring, and the drain thread moves
+   * on to the new ring once it has emptied the full one.
+   *
+   * @param fullRing Calling thread's current ring
+   * @return Ring the calling thread produces into from now on
+   */
+  LogRing &growRing(LogRing &fullRing);
+
+  /**
+   * @brief Drain thread loop.
+   */
+  void drainLoop();
+
+  /**
+   * @brief Move every published message of every ring to the output.
+   *
+   * This function will refresh the drain thread's snapshot of the rings
+   * only when a thread has registered since the last pass, so a pass
+   * normally takes no lock and allocates nothing.
+   *
+   * @param rings Drain thread's snapshot of m_rings
+   * @param batch Reusable text buffer for batched writes
+   * @return Number of messages drained
+   */
+  std::size_t drainRings(std::vector<LogRing *> &rings, std::string &batch);
+
+  /**
+   * @brief Move every published message of one ring to the batch.
+   *
+   * @param ring Ring to drain
+   * @param batch Reusable text buffer for batched writes
+   * @return Number of messages drained
+   */
+  std::size_t drainRing(LogRing &ring, std::string &batch);
+
+  std::ostream &m_output;                        // Destination of the messages
+  std::size_t m_ringCapacity;                    // Records a new ring starts with, a power of two
+  std::size_t m_maxRingCapacity;                 // Records a ring can grow to, a power of two
+  unsigned long long m_loggerId;                 // Process-unique id used by the thread-local ring cache
+  ProfiledMutex m_ringsMutex;                    // Protects m_rings while threads register
+  std::vector<std::unique_ptr<LogRing>> m_rings; // One ring per logging thread
+  std::atomic<std::size_t> m_numRings;           // Size of m_rings, published after every registration
+  std::atomic<std::size_t> m_droppedMessages;    // Messages dropped because a ring was full
+  std::atomic<unsigned> m_flushRequests;         // Bumped by every flush()
+  std::atomic<unsigned> m_completedFlushes;      // Last flush request the drain thread has completed
+  std::atomic<bool> m_isStopping;                // Set by the destructor
+  std::thread m_drainThread;                     // Background thread writing the messages
+};
+
+#endif
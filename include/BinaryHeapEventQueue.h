@@ -0,0 +1,36 @@
+#ifndef BINARY_HEAP_EVENT_QUEUE_H
+#define BINARY_HEAP_EVENT_QUEUE_H
+
+#include <vector>
+
+#include "EventQueue.h"
+
+class BinaryHeapEventQueue : public EventQueue
+{
+public:
+  /**
+   * @brief Add an Event to the heap.
+   *
+   * @param event Event to add
+   */
+  void push(const Event &event) override;
+
+  /**
+   * @brief Remove the earliest Event from the heap.
+   *
+   * @return Next Event
+   */
+  Event pop() override;
+
+  /**
+   * @brief Get number of Events in the heap.
+   *
+   * @return Number of Events
+   */
+  std::size_t size() const override { return m_heap.size(); }
+
+private:
+  std::vector<Event> m_heap; // Min-heap ordered by Event::operator>
+};
+
+#endif
\ No newline at end of file
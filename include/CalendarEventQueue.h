@@ -0,0 +1,100 @@
+#ifndef CALENDAR_EVENT_QUEUE_H
+#define CALENDAR_EVENT_QUEUE_H
+
+#include <vector>
+
+#include "EventQueue.h"
+
+class CalendarEventQueue : public EventQueue
+{
+public:
+  static constexpr std::size_t kMinBuckets = 2;       // Fewest buckets the calendar shrinks to
+  static constexpr std::size_t kWidthSampleSize = 25; // Earliest Events sampled to choose the bucket width
+
+  /**
+   * @brief Initialize an empty calendar of kMinBuckets one minute buckets.
+   */
+  CalendarEventQueue();
+
+  /**
+   * @brief Add an Event to its day of the calendar.
+   *
+   * This function will insert the Event into the bucket of its time,
+   * keeping the bucket in firing order. The calendar doubles its number
+   * of buckets once it holds more than two Events per bucket.
+   *
+   * @param event Event to add
+   */
+  void push(const Event &event) override;
+
+  /**
+   * @brief Remove the earliest Event.
+   *
+   * This function will walk the buckets from the current one until it
+   * finds an Event of the current year, falling back to a direct search
+   * after a whole year without one. The calendar halves its number of
+   * buckets once it holds less than one Event per two buckets.
+   *
+   * @return Next Event
+   */
+  Event pop() override;
+
+  /**
+   * @brief Get number of Events in the calendar.
+   *
+   * @return Number of Events
+   */
+  std::size_t size() const override { return m_size; }
+
+  /**
+   * @brief Get number of buckets.
+   *
+   * @return Current number of buckets
+   */
+  std::size_t getNumBuckets() const { return m_buckets.size(); }
+
+  /**
+   * @brief Get bucket width.
+   *
+   * @return Minutes covered by one bucket
+   */
+  int getBucketWidth() const { return m_bucketWidth; }
+
+private:
+  struct Bucket
+  {
+    std::vector<Event> events; // Events in firing order, the ones before head are already popped
+    std::size_t head = 0;      // First Event not yet popped
+
+    bool isEmpty() const { return head == events.size(); }
+  };
+
+  std::vector<Bucket> m_buckets; // One bucket per day, Events fall into bucket (time / width) % numBuckets
+  std::size_t m_bucketMask;      // Number of buckets - 1, the number of buckets is a power of two
+  int m_bucketWidth;             // Minutes covered by one bucket
+  std::size_t m_currentBucket;   // Bucket of the last popped Event
+  long long m_bucketTop;         // End of the current bucket's day in the current year
+  int m_lastTime;                // Time of the last popped Event
+  std::size_t m_size;            // Number of Events in the calendar
+
+  /**
+   * @brief Take the first Event of a bucket.
+   *
+   * @param bucket Bucket to take from, must not be empty
+   * @return Earliest Event of the bucket
+   */
+  Event takeFirst(Bucket &bucket);
+
+  /**
+   * @brief Rebuild the calendar with a new number of buckets.
+   *
+   * This function will choose the bucket width as three times the mean
+   * gap between the earliest kWidthSampleSize Events and redistribute
+   * every Event.
+   *
+   * @param numBuckets New number of buckets, a power of two
+   */
+  void resize(const std::size_t numBuckets);
+};
+
+#endif
\ No newline at end of file
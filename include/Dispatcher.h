@@ -0,0 +1,122 @@
+#ifndef DISPATCHER_H
+#define DISPATCHER_H
+
+#include <atomic>
+#include <memory>
+
+#include "RandomStream.h"
+
+class Dispatcher
+{
+public:
+  enum class Kind
+  {
+    SHARED_QUEUE,        // No dispatching, every Station pulls the oldest Truck from one shared FIFO
+    JOIN_SHORTEST_QUEUE, // Station with the fewest Trucks waiting or unloading, lowest id on ties
+    POWER_OF_TWO,        // Fewer Trucks of two Stations drawn at random, the first one drawn on ties
+    ROUND_ROBIN,         // Stations in turn, whatever their queues
+    LEAST_EXPECTED_WORK  // Station that finishes its committed Trucks first, lowest id on ties
+  };
+
+  /**
+   * @brief Initialize the loads of idle Stations.
+   *
+   * @param numStations Number of Stations Trucks are dispatched to
+   * @param unloadTimeMins Unload time per Truck, the work a Truck adds to its Station
+   */
+  Dispatcher(const int numStations, const int unloadTimeMins);
+
+  Dispatcher(const Dispatcher &) = delete;
+  Dispatcher &operator=(const Dispatcher &) = delete;
+
+  virtual ~Dispatcher() = default;
+
+  /**
+   * @brief Create a dispatcher.
+   *
+   * @param kind Dispatch policy
+   * @param numStations Number of Stations Trucks are dispatched to
+   * @param unloadTimeMins Unload time per Truck
+   * @return Dispatcher with every Station idle, nullptr for SHARED_QUEUE
+   */
+  static std::unique_ptr<Dispatcher> create(const Kind kind, const int numStations, const int unloadTimeMins);
+
+  /**
+   * @brief Get name of a dispatch policy.
+   *
+   * @param kind Dispatch policy
+   * @return Lower case name, as accepted by the --dispatch option
+   */
+  static const char *getName(const Kind kind);
+
+  /**
+   * @brief Commit an arriving Truck to a Station.
+   *
+   * This function will choose a Station with the policy and add the
+   * Truck to its load. It may be called from several threads at once;
+   * Trucks dispatched at the same moment may then not see each other,
+   * like drivers reading the same yard board.
+   *
+   * @param now Minute the Truck arrives at the Stations
+   * @param randomStream Random draws of the randomized policies
+   * @return Station ID whose queue the Truck joins
+   */
+  int dispatch(const int now, RandomStream &randomStream);
+
+  /**
+   * @brief Remove an unloaded Truck from its Station's load.
+   *
+   * @param stationId Station that finished unloading the Truck
+   */
+  void completeUnload(const int stationId) { m_loads[stationId].numTrucks.fetch_sub(1, std::memory_order_relaxed); }
+
+  /**
+   * @brief Get number of Trucks committed to a Station.
+   *
+   * @param stationId Station ID
+   * @return Trucks waiting for the Station or being unloaded
+   */
+  int getNumTrucks(const int stationId) const { return m_loads[stationId].numTrucks.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Get the work left at a Station.
+   *
+   * This function will return the minutes until the Station has
+   * unloaded every Truck committed to it, if each takes the unload time.
+   *
+   * @param stationId Station ID
+   * @param now Current minute
+   * @return Expected minutes of work, 0 if the Station is idle
+   */
+  int getExpectedWorkMins(const int stationId, const int now) const;
+
+  /**
+   * @brief Get number of Stations.
+   *
+   * @return Number of Stations Trucks are dispatched to
+   */
+  int getNumStations() const { return m_numStations; }
+
+protected:
+  /**
+   * @brief Choose the Station for an arriving Truck.
+   *
+   * @param now Minute the Truck arrives at the Stations
+   * @param randomStream Random draws of the randomized policies
+   * @return Station ID
+   */
+  virtual int selectStation(const int now, RandomStream &randomStream) = 0;
+
+private:
+  struct alignas(64) StationLoad
+  {
+    std::atomic<int> numTrucks; // Trucks committed to the Station, waiting or unloading
+    std::atomic<int> freeTime;  // Minute the Station is expected to finish every committed Truck
+  };
+
+  std::unique_ptr<StationLoad[]> m_loads; // Load per Station, a cache line each so Stations do not share one
+  int m_numStations;                      // Number of Stations
+  int m_unloadTimeMins;                   // Work a Truck adds to its Station
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef EVENT_H
+#define EVENT_H
+
+class Event
+{
+public:
+  enum Type
+  {
+    TRUCK_STATE_COMPLETE,   // Truck finished the action of its previous state
+    STATION_UNLOAD_COMPLETE // Station finished unloading a Truck and is idle again
+  };
+
+  /**
+   * @brief Initialize Event with its timestamp and owner.
+   *
+   * This function will initialize an Event that fires at the given
+   * virtual time for the Truck or Station with the given ID.
+   *
+   * @param time Virtual time in minutes at which the Event fires
+   * @param sequence Insertion order used to break ties between Events at the same time
+   * @param type Kind of Event
+   * @param id Truck ID or Station ID, depending on the type
+   */
+  Event(const int time, const long long sequence, const Type type, const int id)
+      : m_time(time), m_sequence(sequence), m_type(type), m_id(id) {}
+
+  /**
+   * @brief Get Event's virtual time.
+   *
+   * This function will return the virtual time at which the Event fires.
+   *
+   * @return Event time in minutes
+   */
+  int getTime() const { return m_time; }
+
+  /**
+   * @brief Get Event's insertion order.
+   *
+   * This function will return the sequence number that breaks ties
+   * between Events at the same time.
+   *
+   * @return Event sequence number
+   */
+  long long getSequence() const { return m_sequence; }
+
+  /**
+   * @brief Get Event's type.
+   *
+   * This function will return the kind of Event.
+   *
+   * @return Event type
+   */
+  Type getType() const { return m_type; }
+
+  /**
+   * @brief Get Event's owner ID.
+   *
+   * This function will return the Truck ID or Station ID that
+   * the Event belongs to.
+   *
+   * @return Truck ID or Station ID
+   */
+  int getId() const { return m_id; }
+
+  /**
+   * @brief Compare Events by firing order.
+   *
+   * This function will order Events by time and then by insertion order
+   * so that Events scheduled for the same minute fire first in, first out.
+   *
+   * @param other Event to compare against
+   * @return True if this Event fires after the other Event
+   */
+  bool operator>(const Event &other) const
+  {
+    return (m_time != other.m_time) ? (m_time > other.m_time) : (m_sequence > other.m_sequence);
+  }
+
+  /**
+   * @brief Compare Events by firing order.
+   *
+   * @param other Event to compare against
+   * @return True if this Event fires before the other Event
+   */
+  bool operator<(const Event &other) const { return other > *this; }
+
+private:
+  int m_time;            // Virtual time in minutes
+  long long m_sequence;  // Insertion order for tie breaking
+  Type m_type;           // Kind of event
+  int m_id;              // Truck or station id
+};
+
+#endif
\ No newline at end of file
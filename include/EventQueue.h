@@ -0,0 +1,75 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <cstddef>
+#include <memory>
+
+#include "Event.h"
+
+class EventQueue
+{
+public:
+  enum class Kind
+  {
+    BINARY_HEAP,    // std::push_heap/pop_heap on a vector, O(log n) insert and pop
+    PAIRING_HEAP,   // Pairing heap in a node pool, O(1) insert and amortized O(log n) pop
+    CALENDAR_QUEUE, // Brown's calendar queue, O(1) expected insert and pop with self-tuning bucket width
+    TIMING_WHEEL    // Hierarchical timing wheel of 64 slot levels, O(1) insert and pop plus cascading
+  };
+
+  virtual ~EventQueue() = default;
+
+  /**
+   * @brief Create an event queue.
+   *
+   * @param kind Priority structure to use
+   * @return Empty event queue
+   */
+  static std::unique_ptr<EventQueue> create(const Kind kind);
+
+  /**
+   * @brief Get name of a priority structure.
+   *
+   * @param kind Priority structure
+   * @return Lower case name, as accepted by the --event-queue option
+   */
+  static const char *getName(const Kind kind);
+
+  /**
+   * @brief Add an Event.
+   *
+   * This function will schedule the Event. Its time must not be earlier
+   * than the time of the last Event popped, as in any discrete event
+   * simulation.
+   *
+   * @param event Event to add
+   */
+  virtual void push(const Event &event) = 0;
+
+  /**
+   * @brief Remove the next Event.
+   *
+   * This function will remove and return the Event with the lowest time,
+   * and among those the lowest sequence number, so every implementation
+   * fires Events in exactly the same order. The queue must not be empty.
+   *
+   * @return Next Event
+   */
+  virtual Event pop() = 0;
+
+  /**
+   * @brief Get number of Events in the queue.
+   *
+   * @return Number of Events
+   */
+  virtual std::size_t size() const = 0;
+
+  /**
+   * @brief Check if the queue is empty.
+   *
+   * @return True if no Event is scheduled
+   */
+  bool empty() const { return size() == 0; }
+};
+
+#endif
\ No newline at end of file
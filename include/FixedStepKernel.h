@@ -0,0 +1,114 @@
+#ifndef FIXED_STEP_KERNEL_H
+#define FIXED_STEP_KERNEL_H
+
+#include <algorithm>
+#include <vector>
+
+class FixedStepKernel
+{
+public:
+  static constexpr int kBatchSize = 8; // Trucks per batch, one AVX2 register of 32-bit lanes
+
+  /**
+   * @brief Initialize kernel over a Fleet's state and next event time columns.
+   *
+   * This function will remember the columns and build the earliest next
+   * event time of every batch of kBatchSize Trucks, so a minute only has
+   * to look at batches with a Truck due in it. The columns are not owned.
+   *
+   * @param states Truck::State column of the Fleet
+   * @param nextEventTimes Next event time column of the Fleet
+   * @param numTrucks Number of Trucks in both columns
+   * @param travelTimeMins Duration of both travel states
+   */
+  FixedStepKernel(int *states, int *nextEventTimes, const int numTrucks, const int travelTimeMins);
+
+  /**
+   * @brief Advance every Truck whose action completes this minute.
+   *
+   * This function will compare the batches' earliest next event times
+   * against now 8 (AVX2) or 4 (SSE2) at a time and then update the due
+   * batches in SIMD registers. Due Trucks that are travelling (odd
+   * Truck::State values) move to their next state and get their next
+   * event time set to now + travelTimeMins. Due Trucks that are MINING or
+   * UNLOADING need a random draw or a Station, so their ids are appended
+   * to rareTruckIds in increasing order for the caller's scalar path. The
+   * caller must call refreshTruck() for each of them once it has set
+   * their next event time.
+   *
+   * @param now Current minute
+   * @param rareTruckIds Receives the ids of due MINING and UNLOADING Trucks
+   */
+  void advanceTravellingTrucks(const int now, std::vector<int> &rareTruckIds);
+
+  /**
+   * @brief Update a batch after the caller changed a Truck's next event time.
+   *
+   * This function will lower the batch's earliest next event time to the
+   * Truck's, which takes constant time. It is only valid for a Truck last
+   * reported in rareTruckIds or one whose next event time moved earlier.
+   *
+   * @param id Truck whose next event time changed
+   */
+  void refreshTruck(const int id)
+  {
+    int &batchNextEventTime = m_batchNextEventTimes[id / kBatchSize];
+    batchNextEventTime = std::min(batchNextEventTime, m_nextEventTimes[id]);
+  }
+
+  /**
+   * @brief Reference version of advanceTravellingTrucks() without SIMD.
+   *
+   * This function will scan trucks [first, last) one at a time and produce
+   * exactly the same columns and rareTruckIds. It is used to check the
+   * vectorized kernel.
+   *
+   * @param states Truck::State column
+   * @param nextEventTimes Next event time column
+   * @param first First Truck id to scan
+   * @param last One past the last Truck id to scan
+   * @param now Current minute
+   * @param travelTimeMins Duration of both travel states
+   * @param rareTruckIds Receives the ids of due MINING and UNLOADING Trucks
+   */
+  static void advanceTravellingTrucksScalar(int *states, int *nextEventTimes, const int first, const int last,
+                                            const int now, const int travelTimeMins, std::vector<int> &rareTruckIds);
+
+  /**
+   * @brief Get the instruction set the kernel was compiled for.
+   *
+   * @return "AVX2", "SSE2" or "scalar"
+   */
+  static const char *getInstructionSet();
+
+private:
+  /**
+   * @brief Advance the due Trucks of one batch.
+   *
+   * @param batch Index of the batch
+   * @param now Current minute
+   * @param rareTruckIds Receives the ids of due MINING and UNLOADING Trucks
+   */
+  void advanceBatch(const int batch, const int now, std::vector<int> &rareTruckIds);
+
+  /**
+   * @brief Calculate the earliest next event time of a batch.
+   *
+   * This function will skip Trucks whose next event time is not after now,
+   * i.e. rare Trucks the caller has yet to reschedule.
+   *
+   * @param batch Index of the batch
+   * @param now Current minute
+   * @return Earliest next event time of the batch's other Trucks
+   */
+  int calcBatchNextEventTime(const int batch, const int now) const;
+
+  int *m_states;                          // Truck::State column of the Fleet
+  int *m_nextEventTimes;                  // Next event time column of the Fleet
+  int m_numTrucks;                        // Number of Trucks in both columns
+  int m_travelTimeMins;                   // Duration of both travel states
+  std::vector<int> m_batchNextEventTimes; // Earliest next event time of every batch of kBatchSize Trucks
+  std::vector<int> m_dueBatches;          // Batches with a Truck due this minute, reused every minute
+};
+
+#endif
\ No newline at end of file
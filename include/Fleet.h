@@ -0,0 +1,196 @@
+#ifndef FLEET_H
+#define FLEET_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Truck.h"
+#include "RandomStream.h"
+#include "RunningStats.h"
+#include "Site.h"
+
+class Fleet
+{
+public:
+  class TruckRef
+  {
+  public:
+    /**
+     * @brief Initialize a view of one Truck of a Fleet.
+     *
+     * This function will create a lightweight handle that reads and writes
+     * the Truck's fields in the Fleet's columns. It offers the same getters
+     * and setters as Truck, so code written for a Truck works on it.
+     *
+     * @param fleet Fleet holding the Truck
+     * @param id Truck id, also its index in every column
+     */
+    TruckRef(Fleet &fleet, const int id) : m_fleet(&fleet), m_id(id) {}
+
+    int getId() const { return m_id; }
+
+    Truck::State getCurrentState() const { return static_cast<Truck::State>(m_fleet->m_states[m_id]); }
+
+    void setCurrentState(const Truck::State newState) const { m_fleet->m_states[m_id] = newState; }
+
+    int getCurrentMiningTime() const { return m_fleet->m_currentMiningTimes[m_id]; }
+
+    void setCurrentMiningTime(const int time) const { m_fleet->m_currentMiningTimes[m_id] = time; }
+
+    int getCurrentMinedHelium() const { return m_fleet->m_currentHelium[m_id]; }
+
+    void setCurrentMinedHelium(const int value) const { m_fleet->m_currentHelium[m_id] = value; }
+
+    int getCurrentTripQueueWait() const { return m_fleet->m_currentTripQueueWaits[m_id]; }
+
+    void setCurrentTripQueueWait(const int value) const { m_fleet->m_currentTripQueueWaits[m_id] = value; }
+
+    int getTotalMiningTime() const { return m_fleet->m_totalMiningTimes[m_id]; }
+
+    void setTotalMiningTime(const int time) const { m_fleet->m_totalMiningTimes[m_id] = time; }
+
+    int getTotalMinedHelium() const { return m_fleet->m_totalHelium[m_id]; }
+
+    void setTotalMinedHelium(const int value) const { m_fleet->m_totalHelium[m_id] = value; }
+
+    int getTotalNumberUnloads() const { return m_fleet->m_unloadCounts[m_id]; }
+
+    void incrementTotalNumberUnloads() const { m_fleet->m_unloadCounts[m_id]++; }
+
+    int getTotalQueueWait() const { return m_fleet->m_totalQueueWaits[m_id]; }
+
+    void setTotalQueueWait(const int value) const { m_fleet->m_totalQueueWaits[m_id] = value; }
+
+    bool getIsInDataQueue() const { return m_fleet->m_isInDataQueue[m_id] != 0; }
+
+    void setIsInDataQueue(const bool flag) const { m_fleet->m_isInDataQueue[m_id] = flag; }
+
+    int getNextEventTime() const { return m_fleet->m_nextEventTimes[m_id]; }
+
+    void setNextEventTime(const int time) const { m_fleet->m_nextEventTimes[m_id] = time; }
+
+    RandomStream &getRandomStream() const { return m_fleet->m_randomStreams[m_id]; }
+
+    void saveMiningDuration(const int value) const
+    {
+      m_fleet->m_miningStats[m_id].add(value);
+      if (!m_fleet->m_miningHistories.empty())
+      {
+        m_fleet->m_miningHistories[m_id].push_back(value);
+      }
+    }
+
+    const RunningStats &getMiningStats() const { return m_fleet->m_miningStats[m_id]; }
+
+    int calculateTotalMiningDuration() const { return static_cast<int>(m_fleet->m_miningStats[m_id].getSum()); }
+
+  private:
+    Fleet *m_fleet; // Fleet holding the Truck
+    int m_id;       // Truck id, also its index in every column
+  };
+
+  /**
+   * @brief Initialize a Fleet of Trucks stored column by column.
+   *
+   * This function will create numTrucks Trucks with ids 0 to numTrucks - 1,
+   * all MINING at time 0, and give each the same random stream a Truck
+   * with that id and seed would get.
+   *
+   * @param numTrucks Number of Trucks
+   * @param seed Master seed the Trucks' random streams are derived from
+   */
+  Fleet(const int numTrucks, const std::uint64_t seed);
+
+  /**
+   * @brief Get number of Trucks.
+   *
+   * @return Number of Trucks in the Fleet
+   */
+  int size() const { return static_cast<int>(m_states.size()); }
+
+  /**
+   * @brief Get a Truck-like view of one Truck.
+   *
+   * @param id Truck id
+   * @return View reading and writing the Truck's columns
+   */
+  TruckRef operator[](const int id) { return TruckRef(*this, id); }
+
+  /**
+   * @brief Set if every Truck keeps every mining duration.
+   *
+   * This function will switch the full mining history of the whole Fleet
+   * on or off, see Truck::setKeepMiningHistory(). Call it before any
+   * duration is saved.
+   *
+   * @param flag If every mining duration is kept
+   */
+  void setKeepMiningHistory(const bool flag);
+
+  /**
+   * @brief Set the mining duration range of every Truck's statistics.
+   *
+   * This function will reset every Truck's statistics to empty ones with
+   * histogram buckets over [lowest, highest]. Call it before any duration
+   * is saved.
+   *
+   * @param lowest Shortest mining duration
+   * @param highest Longest mining duration
+   */
+  void setMiningStatsRange(const int lowest, const int highest);
+
+  /**
+   * @brief Copy one Truck out of the Fleet.
+   *
+   * This function will build a standalone Truck with the same results and
+   * mining statistics, e.g. for getTrucks() and printTruckResults(). Its
+   * mining history is copied too when the Fleet keeps it.
+   *
+   * @param id Truck id
+   * @return Copy of the Truck
+   */
+  Truck toTruck(const int id) const;
+
+  /**
+   * @brief Start loading one Truck's columns into the cache.
+   *
+   * This function will issue a prefetch for every column a state
+   * transition touches, so a loop over scattered ids can call it a few
+   * ids ahead of the Truck it is working on.
+   *
+   * @param id Truck id
+   */
+  void prefetch(const int id) const;
+
+  // Columns for bulk passes, indexed by Truck id
+  std::vector<int> &getStates() { return m_states; }
+  std::vector<int> &getNextEventTimes() { return m_nextEventTimes; }
+  std::vector<int> &getCurrentHelium() { return m_currentHelium; }
+  std::vector<int> &getTotalHelium() { return m_totalHelium; }
+  std::vector<int> &getTotalQueueWaits() { return m_totalQueueWaits; }
+  std::vector<int> &getUnloadCounts() { return m_unloadCounts; }
+  const std::vector<int> &getStates() const { return m_states; }
+  const std::vector<int> &getNextEventTimes() const { return m_nextEventTimes; }
+  const std::vector<int> &getCurrentHelium() const { return m_currentHelium; }
+  const std::vector<int> &getTotalHelium() const { return m_totalHelium; }
+  const std::vector<int> &getTotalQueueWaits() const { return m_totalQueueWaits; }
+  const std::vector<int> &getUnloadCounts() const { return m_unloadCounts; }
+
+private:
+  std::uint64_t m_seed;                            // Master seed the random streams were derived from
+  std::vector<int> m_states;                       // Truck::State of every Truck
+  std::vector<int> m_nextEventTimes;               // Minute each Truck's current action completes
+  std::vector<int> m_currentMiningTimes;           // Current mining trip time in minutes
+  std::vector<int> m_currentHelium;                // Helium mined in the current trip
+  std::vector<int> m_currentTripQueueWaits;        // Queue wait of the current trip
+  std::vector<int> m_totalHelium;                  // Total helium unloaded so far
+  std::vector<int> m_totalMiningTimes;             // Total time spent mining in minutes
+  std::vector<int> m_totalQueueWaits;              // Total time spent waiting in the queue in minutes
+  std::vector<int> m_unloadCounts;                 // Total number of unload trips
+  std::vector<RunningStats> m_miningStats;         // Running statistics of every Truck's mining durations
+  std::vector<std::vector<int>> m_miningHistories; // Every Truck's mining durations, empty unless the history is kept
+  std::vector<unsigned char> m_isInDataQueue;      // Nonzero while the Truck waits for a Station
+  std::vector<RandomStream> m_randomStreams;       // Every Truck's own reproducible random stream
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#ifndef FLEET_SWEEP_H
+#define FLEET_SWEEP_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Simulator.h"
+
+class FleetSweep
+{
+public:
+  static constexpr double kDefaultKneeFraction = 0.1; // Extra Station must add at least 10% of an average Station's helium
+
+  struct Range
+  {
+    int first; // First value of the range
+    int last;  // Last value of the range, inclusive
+    int step;  // Distance between values, at least 1
+  };
+
+  struct Cell
+  {
+    int numTrucks;           // Trucks simulated in this cell
+    int numStations;         // Stations simulated in this cell
+    double totalHelium;      // Helium received by all Stations, mean over the replications
+    double heliumPerStation; // totalHelium / numStations
+    double heliumPerTruck;   // totalHelium / numTrucks
+    double queueWaitMins;    // Total queue wait per Truck in minutes, mean over the replications
+    double truckEfficiency;  // heliumPerTruck / Simulator::calcMaxHeliumPossible() in percent
+    double stationBusy;      // Unloading time per Station over the 72 hours in percent, above 100 once the queue drains past the end
+  };
+
+  /**
+   * @brief Initialize sweep over a grid of fleet sizes.
+   *
+   * This function will set up one cell for every combination of a
+   * Truck count from truckRange and a Station count from stationRange.
+   *
+   * @param truckRange Truck counts to simulate
+   * @param stationRange Station counts to simulate
+   */
+  FleetSweep(const Range &truckRange, const Range &stationRange);
+
+  /**
+   * @brief Set number of replications averaged in every cell.
+   *
+   * @param numReplications Replications per cell, defaults to 1
+   */
+  void setNumReplications(const int numReplications) { m_numReplications = numReplications; }
+
+  /**
+   * @brief Set the master seed shared by every cell.
+   *
+   * This function will set the seed every cell starts from. Sharing it
+   * gives every Truck the same mining durations in every cell, so
+   * differences between cells come from the fleet size and not from noise.
+   *
+   * @param masterSeed Master seed, random by default
+   */
+  void setMasterSeed(const std::uint64_t masterSeed) { m_masterSeed = masterSeed; }
+
+  /**
+   * @brief Set number of threads the cells are spread over.
+   *
+   * @param numWorkerThreads Number of threads, defaults to the number of hardware threads
+   */
+  void setNumWorkerThreads(const int numWorkerThreads) { m_numWorkerThreads = numWorkerThreads; }
+
+  /**
+   * @brief Set the constants every cell simulates with.
+   *
+   * @param config Simulation constants, defaults to SimulationConfig()
+   */
+  void setConfig(const SimulationConfig &config) { m_config = config; }
+
+  /**
+   * @brief Set the knee threshold.
+   *
+   * This function will set how much helium, as a fraction of what an
+   * average Station receives, the next Station count must add per extra
+   * Station to still count as an improvement.
+   *
+   * @param kneeFraction Knee threshold, defaults to kDefaultKneeFraction
+   */
+  void setKneeFraction(const double kneeFraction) { m_kneeFraction = kneeFraction; }
+
+  /**
+   * @brief Simulate every cell of the grid.
+   *
+   * This function will run the cells as tasks on a WorkerPool in virtual
+   * time. The results do not depend on the number of threads. If the
+   * replications of a cell cannot run, the sweep stops and no cells are
+   * kept.
+   *
+   * @param error Receives the reason when a cell cannot run
+   * @return True if every cell ran
+   */
+  bool run(std::string &error);
+
+  /**
+   * @brief Get the simulated cells.
+   *
+   * @return Cells ordered by Truck count, then by Station count
+   */
+  const std::vector<Cell> &getCells() const { return m_cells; }
+
+  /**
+   * @brief Find the knee of a Truck count.
+   *
+   * This function will return the smallest Station count after which
+   * adding Stations stops improving the helium delivered, i.e. the next
+   * Station count adds less than the knee fraction of the helium per
+   * Station for every extra Station.
+   *
+   * @param numTrucks Truck count of the grid
+   * @return Knee Station count, or -1 if numTrucks is not in the grid
+   */
+  int findKneeStations(const int numTrucks) const;
+
+  /**
+   * @brief Write the grid as CSV.
+   *
+   * This function will write a header line and one line per cell with
+   * the throughput and queue wait surface.
+   *
+   * @param out Stream to write to
+   */
+  void writeCsv(std::ostream &out) const;
+
+  /**
+   * @brief Print the knee of every Truck count.
+   *
+   * @param out Stream to write to
+   */
+  void printKnees(std::ostream &out) const;
+
+private:
+  /**
+   * @brief Expand a Range into its values.
+   *
+   * @param range Range to expand
+   * @return Values of the range in increasing order
+   */
+  static std::vector<int> expandRange(const Range &range);
+
+  std::vector<int> m_truckCounts;   // Truck counts of the grid
+  std::vector<int> m_stationCounts; // Station counts of the grid
+  int m_numReplications;            // Replications averaged in every cell
+  std::uint64_t m_masterSeed;       // Seed shared by every cell
+  int m_numWorkerThreads;           // Threads the cells are spread over
+  SimulationConfig m_config;        // Constants of every cell
+  double m_kneeFraction;            // Knee threshold
+  std::vector<Cell> m_cells;        // Simulated cells, truck-major
+};
+
+#endif
\ No newline at end of file
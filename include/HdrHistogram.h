@@ -0,0 +1,115 @@
+#ifndef HDR_HISTOGRAM_H
+#define HDR_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+class HdrHistogram
+{
+public:
+  static constexpr int kSubBucketBits = 7;                    // Linear sub-buckets per power of two = 2^kSubBucketBits
+  static constexpr int kSubBucketCount = 1 << kSubBucketBits; // Every recorded value is kept within 1 / kSubBucketCount of itself
+
+  /**
+   * @brief Initialize an empty histogram.
+   *
+   * This function will create a high dynamic range histogram for any
+   * value from 0 to 2^64 - 1. Values below 2 * kSubBucketCount are
+   * counted exactly, larger ones in buckets whose width is a fixed
+   * fraction of their value, so e.g. nanosecond waits from a few
+   * nanoseconds up to hours keep 3 significant digits. Buckets are only
+   * allocated up to the largest value recorded.
+   */
+  HdrHistogram() : m_count(0), m_total(0), m_min(UINT64_MAX), m_max(0) {}
+
+  /**
+   * @brief Add one value.
+   *
+   * @param value Value to add
+   */
+  void record(const std::uint64_t value);
+
+  /**
+   * @brief Add every value of another histogram.
+   *
+   * @param other Histogram to merge into this one
+   */
+  void add(const HdrHistogram &other);
+
+  /**
+   * @brief Remove every value.
+   */
+  void reset();
+
+  /**
+   * @brief Get number of values recorded.
+   *
+   * @return Number of values recorded
+   */
+  std::uint64_t getCount() const { return m_count; }
+
+  /**
+   * @brief Get sum of the values recorded.
+   *
+   * @return Exact sum of the values recorded
+   */
+  std::uint64_t getTotal() const { return m_total; }
+
+  /**
+   * @brief Get mean of the values recorded.
+   *
+   * @return Exact mean, 0 if no value was recorded
+   */
+  double getMean() const { return (m_count == 0) ? 0.0 : static_cast<double>(m_total) / static_cast<double>(m_count); }
+
+  /**
+   * @brief Get smallest value recorded.
+   *
+   * @return Exact smallest value, 0 if no value was recorded
+   */
+  std::uint64_t getMin() const { return (m_count == 0) ? 0 : m_min; }
+
+  /**
+   * @brief Get largest value recorded.
+   *
+   * @return Exact largest value, 0 if no value was recorded
+   */
+  std::uint64_t getMax() const { return m_max; }
+
+  /**
+   * @brief Get the value below which a percentage of the values fall.
+   *
+   * This function will walk the buckets until they hold the requested
+   * share of the values and return the highest value of that bucket,
+   * but never more than the largest value recorded.
+   *
+   * @param percentile Percentage from 0 to 100
+   * @return Value at the percentile, within 1 / kSubBucketCount, 0 if no value was recorded
+   */
+  std::uint64_t getValueAtPercentile(const double percentile) const;
+
+private:
+  /**
+   * @brief Get the bucket a value is counted in.
+   *
+   * @param value Value to look up
+   * @return Bucket index
+   */
+  static int getIndex(const std::uint64_t value);
+
+  /**
+   * @brief Get the highest value counted in a bucket.
+   *
+   * @param index Bucket index
+   * @return Highest value of the bucket
+   */
+  static std::uint64_t getHighestValue(const int index);
+
+  std::vector<std::uint64_t> m_counts; // Values per bucket, up to the bucket of the largest value
+  std::uint64_t m_count;               // Number of values recorded
+  std::uint64_t m_total;               // Sum of the values recorded
+  std::uint64_t m_min;                 // Smallest value recorded
+  std::uint64_t m_max;                 // Largest value recorded
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+template <typename T>
+class MpmcQueue
+{
+public:
+  /**
+   * @brief Initialize queue with a fixed capacity.
+   *
+   * This function will allocate a ring of cells large enough to hold
+   * capacity elements. The capacity is rounded up to a power of two so
+   * positions can be mapped to cells with a mask.
+   *
+   * @param capacity Minimum number of elements the queue can hold
+   */
+  explicit MpmcQueue(const std::size_t capacity) : m_capacity(roundUpToPowerOfTwo(capacity)), m_mask(m_capacity - 1),
+                                                   m_cells(std::make_unique<Cell[]>(m_capacity)),
+                                                   m_enqueuePosition(0), m_dequeuePosition(0)
+  {
+    for (std::size_t i = 0; i < m_capacity; ++i)
+    {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcQueue(const MpmcQueue &) = delete;
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+  /**
+   * @brief Push an element without blocking.
+   *
+   * This function will claim the next free cell and publish the element
+   * to consumers. Any number of threads may push concurrently.
+   *
+   * @param value Element to push
+   * @return False if the queue is full, otherwise true
+   */
+  bool tryPush(const T &value)
+  {
+    std::size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Cell &cell = m_cells[position & m_mask];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0)
+      {
+        // Cell is free for this lap, try to claim it
+        if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          cell.value = value;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (difference < 0)
+      {
+        return false; // Cell still holds an element from the previous lap
+      }
+      else
+      {
+        position = m_enqueuePosition.load(std::memory_order_relaxed); // Another producer claimed it, reload
+      }
+    }
+  }
+
+  /**
+   * @brief Pop the oldest element without blocking.
+   *
+   * This function will take the element from the next published cell and
+   * hand the cell back to producers. Any number of threads may pop
+   * concurrently.
+   *
+   * @param value Receives the popped element
+   * @return False if no element is published yet, otherwise true
+   */
+  bool tryPop(T &value)
+  {
+    std::size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Cell &cell = m_cells[position & m_mask];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+      if (difference == 0)
+      {
+        // Cell holds a published element, try to claim it
+        if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          value = cell.value;
+          cell.sequence.store(position + m_capacity, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (difference < 0)
+      {
+        return false; // Producer has not published this cell yet
+      }
+      else
+      {
+        position = m_dequeuePosition.load(std::memory_order_relaxed); // Another consumer claimed it, reload
+      }
+    }
+  }
+
+  /**
+   * @brief Get queue capacity.
+   *
+   * This function will return the number of elements the queue can hold.
+   *
+   * @return Queue capacity after rounding up to a power of two
+   */
+  std::size_t getCapacity() const { return m_capacity; }
+
+private:
+  static constexpr std::size_t kCacheLineSize = 64; // Keeps producer and consumer positions on separate cache lines
+
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence; // Lap marker telling producers and consumers who owns the cell
+    T value;                           // Stored element
+  };
+
+  static std::size_t roundUpToPowerOfTwo(const std::size_t value)
+  {
+    std::size_t result = 2;
+    while (result < value)
+    {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  std::size_t m_capacity;                                           // Number of cells, always a power of two
+  std::size_t m_mask;                                               // m_capacity - 1
+  std::unique_ptr<Cell[]> m_cells;                                  // Ring storage
+  alignas(kCacheLineSize) std::atomic<std::size_t> m_enqueuePosition; // Next position producers claim
+  alignas(kCacheLineSize) std::atomic<std::size_t> m_dequeuePosition; // Next position consumers claim
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef PAIRING_HEAP_EVENT_QUEUE_H
+#define PAIRING_HEAP_EVENT_QUEUE_H
+
+#include <vector>
+
+#include "EventQueue.h"
+
+class PairingHeapEventQueue : public EventQueue
+{
+public:
+  /**
+   * @brief Add an Event to the heap.
+   *
+   * This function will meld a single node heap with the root, which
+   * takes constant time.
+   *
+   * @param event Event to add
+   */
+  void push(const Event &event) override;
+
+  /**
+   * @brief Remove the earliest Event from the heap.
+   *
+   * This function will remove the root and meld its children in two
+   * passes, pairing them left to right and then melding the pairs right
+   * to left.
+   *
+   * @return Next Event
+   */
+  Event pop() override;
+
+  /**
+   * @brief Get number of Events in the heap.
+   *
+   * @return Number of Events
+   */
+  std::size_t size() const override { return m_size; }
+
+private:
+  static constexpr int kNoNode = -1; // Missing child or sibling
+
+  struct Node
+  {
+    Event event; // Scheduled Event
+    int child;   // First child, kNoNode if none
+    int sibling; // Next sibling, kNoNode if none
+  };
+
+  std::vector<Node> m_nodes;     // Node pool, nodes are linked by index so growing the pool keeps links valid
+  std::vector<int> m_freeNodes;  // Pool nodes free for reuse
+  std::vector<int> m_meldBuffer; // Children of the popped root, kept to avoid allocating on every pop
+  int m_root = kNoNode;          // Root node holding the earliest Event
+  std::size_t m_size = 0;        // Number of Events in the heap
+
+  /**
+   * @brief Meld two heaps.
+   *
+   * @param first Root of the first heap, may be kNoNode
+   * @param second Root of the second heap, may be kNoNode
+   * @return Root of the melded heap
+   */
+  int meld(const int first, const int second);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef PROFILED_MUTEX_H
+#define PROFILED_MUTEX_H
+
+#include <chrono>
+#include <mutex>
+
+#include "HdrHistogram.h"
+
+class ProfiledMutex
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Profile
+  {
+    const char *name;                   // Name the lock is reported under
+    long long numAcquisitions;          // Times the lock was taken
+    long long numContended;             // Times it was taken after waiting for another thread
+    std::chrono::nanoseconds totalWait; // Time threads spent blocked on the lock
+    std::chrono::nanoseconds totalHold; // Time the lock was held
+    HdrHistogram waitHistogram;         // Wait per acquisition in nanoseconds, 0 if uncontended
+    HdrHistogram holdHistogram;         // Hold per acquisition in nanoseconds
+  };
+
+  /**
+   * @brief Initialize an unlocked, named mutex.
+   *
+   * This function will create a std::mutex that, if the DEBUG flag was
+   * included during compiling, records every acquisition in its Profile.
+   * Otherwise it is a plain std::mutex: nothing is timed or stored.
+   *
+   * @param name Name the lock is reported under, must outlive the mutex
+   */
+  explicit ProfiledMutex(const char *name)
+#ifdef DEBUG
+      : m_profile{name, 0, 0, {}, {}, {}, {}}
+#endif
+  {
+    (void)name;
+  }
+
+  ProfiledMutex(const ProfiledMutex &) = delete;
+  ProfiledMutex &operator=(const ProfiledMutex &) = delete;
+
+  /**
+   * @brief Take the lock, blocking while another thread holds it.
+   *
+   * This function will first try the lock without blocking. Only if
+   * that fails is the acquisition counted as contended and its wait timed.
+   */
+  void lock()
+  {
+#ifdef DEBUG
+    std::chrono::nanoseconds wait{0};
+    if (!m_mutex.try_lock())
+    {
+      const Clock::time_point waitStart = Clock::now();
+      m_mutex.lock();
+      m_acquireTime = Clock::now();
+      wait = m_acquireTime - waitStart;
+      ++m_profile.numContended;
+    }
+    else
+    {
+      m_acquireTime = Clock::now();
+    }
+    ++m_profile.numAcquisitions;
+    m_profile.totalWait += wait;
+    m_profile.waitHistogram.record(static_cast<std::uint64_t>(wait.count()));
+#else
+    m_mutex.lock();
+#endif
+  }
+
+  /**
+   * @brief Take the lock if it is free.
+   *
+   * @return True if the lock was taken
+   */
+  bool try_lock()
+  {
+    if (!m_mutex.try_lock())
+    {
+      return false;
+    }
+#ifdef DEBUG
+    m_acquireTime = Clock::now();
+    ++m_profile.numAcquisitions;
+    m_profile.waitHistogram.record(0);
+#endif
+    return true;
+  }
+
+  /**
+   * @brief Release the lock.
+   *
+   * This function will record the hold time before releasing, so the
+   * Profile is only ever written by the thread holding the lock.
+   */
+  void unlock()
+  {
+#ifdef DEBUG
+    const std::chrono::nanoseconds hold = Clock::now() - m_acquireTime;
+    m_profile.totalHold += hold;
+    m_profile.holdHistogram.record(static_cast<std::uint64_t>(hold.count()));
+#endif
+    m_mutex.unlock();
+  }
+
+#ifdef DEBUG
+  /**
+   * @brief Get a copy of the lock's Profile.
+   *
+   * This function will take the underlying lock, without recording it,
+   * so it may be called while other threads use the mutex.
+   *
+   * @return Counters and histograms since construction or resetProfile()
+   */
+  Profile getProfile()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_profile;
+  }
+
+  /**
+   * @brief Clear the lock's Profile.
+   */
+  void resetProfile()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_profile = Profile{m_profile.name, 0, 0, {}, {}, {}, {}};
+  }
+#endif
+
+private:
+  std::mutex m_mutex; // Lock being profiled
+#ifdef DEBUG
+  Profile m_profile;               // Written only by the thread holding m_mutex
+  Clock::time_point m_acquireTime; // When the current holder took the lock
+#endif
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef QUEUEING_ESTIMATOR_H
+#define QUEUEING_ESTIMATOR_H
+
+#include <cstdint>
+#include <ostream>
+
+#include "SimulationConfig.h"
+
+class QueueingEstimator
+{
+public:
+  struct Estimate
+  {
+    double arrivalRate;     // Truck arrivals at the Stations per minute
+    double utilization;     // Fraction of the time a Station is unloading
+    double meanQueueWait;   // Minutes a Truck waits for a Station per unload
+    double meanQueueLength; // Trucks waiting for a Station on average
+    double cycleTime;       // Minutes of one Truck cycle including the wait
+    double unloadsPerTruck; // Unloads a Truck completes within the horizon
+  };
+
+  struct Validation
+  {
+    Estimate estimate;               // Analytic prediction
+    double simulatedUtilization;     // Unloading time over the horizon per Station, mean over the replications
+    double simulatedQueueWait;       // Queue wait per unload in minutes, mean over the replications
+    double simulatedUnloadsPerTruck; // Unloads per Truck, mean over the replications
+    double utilizationError;         // Predicted minus simulated utilization
+    double queueWaitError;           // Predicted minus simulated queue wait in minutes
+    double unloadsError;             // Predicted minus simulated unloads per Truck
+    double estimateMicros;           // Wall time of the prediction in microseconds
+    double simulationMillis;         // Wall time of the simulations in milliseconds
+  };
+
+  /**
+   * @brief Initialize estimator for a configuration.
+   *
+   * @param config Simulation constants, defaults to SimulationConfig()
+   */
+  explicit QueueingEstimator(const SimulationConfig &config = SimulationConfig()) : m_config(config) {}
+
+  /**
+   * @brief Predict steady state queueing at the Stations.
+   *
+   * This function will treat the Stations as an M/G/c queue with a
+   * deterministic unload time and use the Allen-Cunneen approximation:
+   * the Erlang C wait of M/M/c scaled by (Ca^2 + Cs^2) / 2. The arrival
+   * variability Ca^2 is the QNA superposition of the Trucks' renewal
+   * cycles, which tends to Poisson as the fleet grows. Because the fleet
+   * is a finite source, the arrival rate N / (cycle time) depends on the
+   * wait itself; the fixed point is found by bisection. Runs in
+   * microseconds, so whole design spaces can be screened before
+   * simulating.
+   *
+   * @param numTrucks Number of Trucks
+   * @param numStations Number of Stations
+   * @return Predicted rates, utilization and waits
+   */
+  Estimate estimate(const int numTrucks, const int numStations) const;
+
+  /**
+   * @brief Compare the prediction with the simulator.
+   *
+   * This function will run EVENT_DRIVEN simulations of the same fleet
+   * and configuration and report the error of every predicted value.
+   *
+   * @param numTrucks Number of Trucks
+   * @param numStations Number of Stations
+   * @param seed Master seed of the first replication, the others use the following seeds
+   * @param numReplications Simulations averaged
+   * @return Prediction, simulated values and errors
+   */
+  Validation validate(const int numTrucks, const int numStations, const std::uint64_t seed, const int numReplications = 1) const;
+
+  /**
+   * @brief Write the CSV header of writeCsvRow().
+   *
+   * @param out Stream to write to
+   * @param isValidated True for Validation rows, false for Estimate rows
+   */
+  static void writeCsvHeader(std::ostream &out, const bool isValidated);
+
+  /**
+   * @brief Write a prediction as one CSV row.
+   *
+   * @param out Stream to write to
+   * @param numTrucks Number of Trucks of the prediction
+   * @param numStations Number of Stations of the prediction
+   * @param estimate Prediction to write
+   */
+  static void writeCsvRow(std::ostream &out, const int numTrucks, const int numStations, const Estimate &estimate);
+
+  /**
+   * @brief Write a validation as one CSV row.
+   *
+   * @param out Stream to write to
+   * @param numTrucks Number of Trucks of the validation
+   * @param numStations Number of Stations of the validation
+   * @param validation Validation to write
+   */
+  static void writeCsvRow(std::ostream &out, const int numTrucks, const int numStations, const Validation &validation);
+
+  /**
+   * @brief Calculate the Erlang C probability of waiting.
+   *
+   * @param offeredLoad Arrival rate times service time, in Erlangs
+   * @param numServers Number of servers
+   * @return Probability that an arrival waits, 1 if the load reaches the servers
+   */
+  static double calcErlangC(const double offeredLoad, const int numServers);
+
+private:
+  SimulationConfig m_config; // Constants the prediction is made for
+
+  /**
+   * @brief Predict the queue wait for a given arrival rate.
+   *
+   * @param arrivalRate Truck arrivals per minute
+   * @param numTrucks Number of Trucks
+   * @param numStations Number of Stations
+   * @return Allen-Cunneen queue wait in minutes, infinite if the Stations are overloaded
+   */
+  double calcQueueWait(const double arrivalRate, const int numTrucks, const int numStations) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <cstdint>
+
+class RandomStream
+{
+public:
+  /**
+   * @brief Initialize an independent random stream.
+   *
+   * This function will derive the stream's starting point from the
+   * master seed and the stream id, so every (seed, streamId) pair
+   * produces its own reproducible sequence without shared state.
+   *
+   * @param seed Master seed of the simulation
+   * @param streamId Id of the stream, e.g. the Truck ID
+   */
+  explicit RandomStream(const std::uint64_t seed = 0, const std::uint64_t streamId = 0)
+      : m_state(mix(seed ^ mix(streamId + kGoldenGamma))) {}
+
+  /**
+   * @brief Generate the next 64 random bits.
+   *
+   * This function will advance the SplitMix64 counter by one step
+   * and return its mixed value.
+   *
+   * @return Next 64 random bits
+   */
+  std::uint64_t next()
+  {
+    m_state += kGoldenGamma;
+    return mix(m_state);
+  }
+
+  /**
+   * @brief Generate a uniformly distributed integer.
+   *
+   * This function will map the next random bits onto [min, max]
+   * without modulo bias (Lemire's multiply and reject method).
+   *
+   * @param min Smallest possible value
+   * @param max Largest possible value
+   * @return Random integer between min and max, both included
+   */
+  int nextInRange(const int min, const int max)
+  {
+    const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+    const std::uint64_t threshold = (0 - range) % range; // 2^64 mod range
+    while (true)
+    {
+      const unsigned __int128 product = static_cast<unsigned __int128>(next()) * range;
+      if (static_cast<std::uint64_t>(product) >= threshold)
+      {
+        return static_cast<int>(min + static_cast<std::int64_t>(product >> 64));
+      }
+    }
+  }
+
+private:
+  static constexpr std::uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ULL; // SplitMix64 increment
+
+  /**
+   * @brief SplitMix64 finalizer.
+   *
+   * @param value Value to mix
+   * @return Mixed value
+   */
+  static std::uint64_t mix(std::uint64_t value)
+  {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+  }
+
+  std::uint64_t m_state; // SplitMix64 counter
+};
+
+#endif
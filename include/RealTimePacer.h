@@ -0,0 +1,120 @@
+#ifndef REAL_TIME_PACER_H
+#define REAL_TIME_PACER_H
+
+#include <atomic>
+#include <chrono>
+
+class RealTimePacer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::milliseconds kDefaultWallTimePerMinute{1}; // 1 millisecond of wall time = 1 simulated minute
+  static constexpr std::chrono::milliseconds kMaxWakeUpCompensation{2};    // Longest a sleeper wakes early to make up for OS wake-up latency
+
+  struct DriftReport
+  {
+    long long numWakeUps;                   // Deadlines slept until
+    std::chrono::nanoseconds meanDrift;     // Mean time a sleeper woke after its deadline
+    std::chrono::nanoseconds maxDrift;      // Longest time a sleeper woke after its deadline
+    std::chrono::nanoseconds wakeUpLatency; // Learned OS wake-up latency that sleepers wake early by
+  };
+
+  /**
+   * @brief Initialize pacer with a time compression factor.
+   *
+   * This function will set how much wall time one simulated minute
+   * takes, e.g. 10 microseconds for fast demos or 1 second for operator
+   * training displays.
+   *
+   * @param wallTimePerMinute Wall time of one simulated minute
+   */
+  explicit RealTimePacer(const std::chrono::nanoseconds wallTimePerMinute = kDefaultWallTimePerMinute)
+      : m_wallTimePerMinute(wallTimePerMinute), m_startTime(Clock::now()), m_numWakeUps(0), m_totalDriftNs(0),
+        m_maxDriftNs(0), m_wakeUpLatencyNs(0) {}
+
+  /**
+   * @brief Set time compression factor.
+   *
+   * This function will change how much wall time one simulated minute
+   * takes. It must not be called while a simulation is running.
+   *
+   * @param wallTimePerMinute Wall time of one simulated minute
+   */
+  void setWallTimePerMinute(const std::chrono::nanoseconds wallTimePerMinute) { m_wallTimePerMinute = wallTimePerMinute; }
+
+  /**
+   * @brief Get time compression factor.
+   *
+   * @return Wall time of one simulated minute
+   */
+  std::chrono::nanoseconds getWallTimePerMinute() const { return m_wallTimePerMinute; }
+
+  /**
+   * @brief Start simulated minute 0 now.
+   *
+   * This function will take the current time of the monotonic clock as
+   * the start of the simulation and clear the drift measurements.
+   */
+  void start();
+
+  /**
+   * @brief Get wall time at which a simulated minute starts.
+   *
+   * @param minute Simulated minute
+   * @return Deadline on the monotonic clock
+   */
+  Clock::time_point toWallTime(const int minute) const { return m_startTime + m_wallTimePerMinute * minute; }
+
+  /**
+   * @brief Convert a wall time duration to whole simulated minutes.
+   *
+   * @param duration Wall time duration
+   * @return Number of complete simulated minutes in the duration
+   */
+  int toMinutes(const Clock::duration duration) const { return static_cast<int>(duration / m_wallTimePerMinute); }
+
+  /**
+   * @brief Get current simulated minute.
+   *
+   * @return Number of complete simulated minutes since start()
+   */
+  int getCurrentMinute() const { return toMinutes(Clock::now() - m_startTime); }
+
+  /**
+   * @brief Sleep until an absolute deadline.
+   *
+   * This function will sleep with sleep_until on the monotonic clock, so
+   * oversleeping one deadline does not push back the next one. It wakes
+   * early by the learned OS wake-up latency and yields for the rest of
+   * the way, then records how late it woke. Safe to call from many
+   * threads at once.
+   *
+   * @param deadline Time to wake up at
+   */
+  void sleepUntil(const Clock::time_point deadline);
+
+  /**
+   * @brief Sleep until a simulated minute starts.
+   *
+   * @param minute Simulated minute to wake up at
+   */
+  void sleepUntilMinute(const int minute) { sleepUntil(toWallTime(minute)); }
+
+  /**
+   * @brief Get drift measured since start().
+   *
+   * @return Number of wake-ups, mean and maximum drift and the learned wake-up latency
+   */
+  DriftReport getDriftReport() const;
+
+private:
+  std::chrono::nanoseconds m_wallTimePerMinute; // Wall time of one simulated minute
+  Clock::time_point m_startTime;                // Wall time of simulated minute 0
+  std::atomic<long long> m_numWakeUps;          // Deadlines slept until since start()
+  std::atomic<long long> m_totalDriftNs;        // Sum of the wake-up drifts in nanoseconds
+  std::atomic<long long> m_maxDriftNs;          // Largest wake-up drift in nanoseconds
+  std::atomic<long long> m_wakeUpLatencyNs;     // Moving average of how late sleep_until returns
+};
+
+#endif
\ No newline at end of file
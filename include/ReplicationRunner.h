@@ -0,0 +1,184 @@
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Simulator.h"
+
+class ReplicationRunner
+{
+public:
+  enum Metric
+  {
+    TRUCK_HELIUM_MINED,       // Total Helium Mined, averaged over the Trucks of a replication
+    TRUCK_MINING_DURATION,    // Total Mining Duration in minutes, averaged over the Trucks
+    TRUCK_UNLOADED_TRIPS,     // Total Successful Unloaded Trips, averaged over the Trucks
+    TRUCK_QUEUE_WAIT,         // Total Time Spent Waiting in Queue in minutes, averaged over the Trucks
+    TRUCK_AVERAGE_QUEUE_TIME, // Average Time Spent Waiting in Queue in percent, averaged over the Trucks
+    TRUCK_EFFICIENCY,         // Truck Efficiency in percent, averaged over the Trucks
+    STATION_HELIUM_RECEIVED,  // Total Helium Received, averaged over the Stations
+    STATION_TRUCKS_UNLOADED,  // Total Trucks Unloaded, averaged over the Stations
+    kNumMetrics
+  };
+
+  struct Statistic
+  {
+    double mean;                // Sample mean over the replications
+    double stddev;              // Sample standard deviation over the replications
+    double confidenceHalfWidth; // Half width of the 95% confidence interval of the mean
+  };
+
+  /**
+   * @brief Initialize runner for a fleet and a number of replications.
+   *
+   * This function will set up numReplications independent runs of the
+   * same 72 hour simulation. Every replication gets its own seed derived
+   * from the master seed, so the whole study can be replayed.
+   *
+   * @param numTrucks Number of Trucks in every replication
+   * @param numStations Number of Stations in every replication
+   * @param numReplications Number of independent replications
+   * @param engineMode Engine used by every replication. THREADED is run
+   * as EVENT_DRIVEN because it paces each replication in real time.
+   */
+  ReplicationRunner(const int numTrucks, const int numStations, const int numReplications,
+                    const Simulator::EngineMode engineMode = Simulator::EngineMode::EVENT_DRIVEN);
+
+  /**
+   * @brief Set the master seed the replication seeds are derived from.
+   *
+   * @param masterSeed Master seed, random by default
+   */
+  void setMasterSeed(const std::uint64_t masterSeed) { m_masterSeed = masterSeed; }
+
+  /**
+   * @brief Get the master seed the replication seeds are derived from.
+   *
+   * @return Master seed
+   */
+  std::uint64_t getMasterSeed() const { return m_masterSeed; }
+
+  /**
+   * @brief Set number of threads the replications are spread over.
+   *
+   * @param numWorkerThreads Number of threads, defaults to the number of hardware threads
+   */
+  void setNumWorkerThreads(const int numWorkerThreads) { m_numWorkerThreads = numWorkerThreads; }
+
+  /**
+   * @brief Set the constants every replication simulates with.
+   *
+   * @param config Simulation constants, defaults to SimulationConfig()
+   */
+  void setConfig(const SimulationConfig &config) { m_config = config; }
+
+  /**
+   * @brief Set how arriving Trucks choose a Station in every replication.
+   *
+   * This function will pass the policy to Simulator::setDispatchPolicy().
+   * Replications with the same master seed draw the same mining
+   * durations whatever the policy, so policies can be compared on equal
+   * terms. The policy is only set if the replications' engine models it.
+   *
+   * @param dispatchKind Dispatch policy, SHARED_QUEUE by default
+   * @param error Receives the reason when the policy is rejected
+   * @return True if the policy was set
+   */
+  bool setDispatchPolicy(const Dispatcher::Kind dispatchKind, std::string &error);
+
+  /**
+   * @brief Get the seed of one replication.
+   *
+   * This function will return the seed handed to Simulator::setSeed()
+   * for the replication, so a single replication can be rerun on its own.
+   *
+   * @param replication Index of the replication
+   * @return Seed of the replication
+   */
+  std::uint64_t getReplicationSeed(const int replication) const;
+
+  /**
+   * @brief Run every replication.
+   *
+   * This function will run the replications as tasks on a WorkerPool,
+   * one Simulator per replication, and collect one sample of every
+   * Metric from each of them. The results do not depend on the number
+   * of threads. If a replication cannot start, for example because the
+   * configuration is invalid, the study stops and no samples are kept.
+   *
+   * @param error Receives the reason when a replication cannot start
+   * @return True if every replication ran
+   */
+  bool run(std::string &error);
+
+  /**
+   * @brief Get the samples of a Metric.
+   *
+   * @param metric Metric to return
+   * @return One sample per replication, in replication order
+   */
+  std::vector<double> getSamples(const Metric metric) const;
+
+  /**
+   * @brief Get mean, standard deviation and 95% confidence interval of a Metric.
+   *
+   * @param metric Metric to summarize
+   * @return Statistic over all replications
+   */
+  Statistic getStatistic(const Metric metric) const { return summarize(getSamples(metric)); }
+
+  /**
+   * @brief Print every Metric's Statistic.
+   *
+   * This function will write one line per Metric, using the same names
+   * as the summary file.
+   *
+   * @param out Stream to write to
+   */
+  void printResults(std::ostream &out) const;
+
+  /**
+   * @brief Get the summary file name of a Metric.
+   *
+   * @param metric Metric
+   * @return Name of the Metric
+   */
+  static const char *getMetricName(const Metric metric);
+
+  /**
+   * @brief Summarize a set of independent samples.
+   *
+   * This function will calculate the sample mean, the sample standard
+   * deviation and the half width of the 95% Student t confidence
+   * interval of the mean.
+   *
+   * @param samples Independent samples
+   * @return Statistic of the samples, all zero if there are none
+   */
+  static Statistic summarize(const std::vector<double> &samples);
+
+private:
+  /**
+   * @brief Two-sided 95% critical value of Student's t distribution.
+   *
+   * @param degreesOfFreedom Degrees of freedom
+   * @return Critical value
+   */
+  static double calcStudentTCritical(const int degreesOfFreedom);
+
+  int m_numTrucks;                                        // Number of Trucks in every replication
+  int m_numStations;                                      // Number of Stations in every replication
+  int m_numReplications;                                  // Number of independent replications
+  Simulator::EngineMode m_engineMode;                     // Engine used by every replication
+  int m_numWorkerThreads;                                 // Threads the replications are spread over
+  SimulationConfig m_config;                              // Constants of every replication
+  Dispatcher::Kind m_dispatchKind;                        // How arriving Trucks choose a Station in every replication
+  std::uint64_t m_masterSeed;                             // Replication seeds are derived from it
+  std::vector<std::array<double, kNumMetrics>> m_samples; // One sample of every Metric per replication
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef RUN_OPTIONS_H
+#define RUN_OPTIONS_H
+
+#include <cstdint>
+#include <string>
+
+#include "Simulator.h"
+
+class RunOptions
+{
+public:
+  enum class OutputFormat
+  {
+    TEXT, // Human readable summary as printed by Simulator
+    CSV,  // One row per Truck and Station, see SimulationResults::writeCsv()
+    JSON  // One object per Truck and Station, see SimulationResults::writeJson()
+  };
+
+  int numTrucks = 0;                                                  // Trucks to simulate, 0 if the user is asked
+  int numStations = 0;                                                // Stations to simulate, 0 if the user is asked
+  bool hasSeed = false;                                               // True if a seed was given, otherwise the Simulator default is kept
+  std::uint64_t seed = 0;                                             // Seed of the random streams
+  Simulator::EngineMode engineMode = Simulator::EngineMode::THREADED; // Engine the simulation runs on
+  EventQueue::Kind eventQueueKind = EventQueue::Kind::BINARY_HEAP;    // Future event list of EVENT_DRIVEN mode
+  Dispatcher::Kind dispatchKind = Dispatcher::Kind::SHARED_QUEUE;     // How arriving Trucks choose a Station
+  OutputFormat outputFormat = OutputFormat::TEXT;                     // Format of the results
+  std::string outputPath;                                             // File the results are written to, empty for standard output
+  std::string tracePath;                                              // Binary trace of every Truck state transition, empty if not traced
+  bool isHelpRequested = false;                                       // True if --help was given
+  SimulationConfig config;                                            // Durations and rates of the simulation
+
+  /**
+   * @brief Set one option by name.
+   *
+   * This function will parse the value for the option named key, the same
+   * names being used on the command line and in config files, e.g.
+   * "travel_time_mins" and "30".
+   *
+   * @param key Option name
+   * @param value Option value
+   * @param error Receives the reason when the option is rejected
+   * @return True if the option was set
+   */
+  bool setOption(const std::string &key, const std::string &value, std::string &error);
+
+  /**
+   * @brief Load options from an INI style config file.
+   *
+   * This function will read one "key = value" pair per line. Blank lines,
+   * lines starting with '#' or ';' and "[section]" headers are ignored, so
+   * the options may be grouped freely.
+   *
+   * @param path Path of the config file
+   * @param error Receives the file, line and reason when loading fails
+   * @return True if every option in the file was set
+   */
+  bool loadConfigFile(const std::string &path, std::string &error);
+
+  /**
+   * @brief Parse the command line.
+   *
+   * This function will load the file given by --config first and then
+   * apply every "--key value" flag on top of it, so flags override the
+   * file whatever order they are given in. Dashes in flag names are read
+   * as underscores, e.g. --travel-time-mins equals travel_time_mins.
+   * A dispatch policy the engine does not model is rejected.
+   *
+   * @param argc Argument count from main()
+   * @param argv Arguments from main()
+   * @param error Receives the reason when parsing fails
+   * @return True if every argument was understood
+   */
+  bool parseArguments(int argc, const char *const argv[], std::string &error);
+
+  /**
+   * @brief Parse a positive integer argument.
+   *
+   * This function will read the whole text as an integer, the same way the
+   * integer options are read, so "abc" or "5x" are rejected rather than
+   * read as a number.
+   *
+   * @param text Argument to parse
+   * @param value Receives the integer when it is valid
+   * @return True if the text is an integer above zero
+   */
+  static bool parsePositiveInteger(const std::string &text, int &value);
+
+  /**
+   * @brief Get help text listing every option.
+   *
+   * @param programName Name the program was started with
+   * @return Usage text
+   */
+  static std::string getUsage(const std::string &programName);
+};
+
+#endif
\ No newline at end of file
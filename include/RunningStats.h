@@ -0,0 +1,118 @@
+#ifndef RUNNING_STATS_H
+#define RUNNING_STATS_H
+
+#include <array>
+#include <cmath>
+
+class RunningStats
+{
+public:
+  static constexpr int kNumBuckets = 8; // Fixed number of histogram buckets, keeps the accumulator O(1) in size
+
+  /**
+   * @brief Initialize an empty accumulator for values in [lowest, highest].
+   *
+   * This function will split the range into kNumBuckets equally wide
+   * histogram buckets. Values outside the range are counted in the first
+   * or last bucket, but still update the mean, variance, min and max.
+   *
+   * @param lowest Lowest expected value
+   * @param highest Highest expected value
+   */
+  RunningStats(const int lowest, const int highest);
+
+  /**
+   * @brief Add one value.
+   *
+   * This function will update the count, sum, min, max and histogram and
+   * the running mean and sum of squared deviations with Welford's method,
+   * so no value has to be kept.
+   *
+   * @param value Value to add
+   */
+  void add(const int value);
+
+  /**
+   * @brief Get number of values added.
+   *
+   * @return Number of values added
+   */
+  int getCount() const { return m_count; }
+
+  /**
+   * @brief Get sum of the values added.
+   *
+   * @return Sum of the values added
+   */
+  long long getSum() const { return m_sum; }
+
+  /**
+   * @brief Get mean of the values added.
+   *
+   * @return Mean, 0 if no value was added
+   */
+  double getMean() const { return m_mean; }
+
+  /**
+   * @brief Get sample variance of the values added.
+   *
+   * @return Sample variance, 0 if fewer than 2 values were added
+   */
+  double getVariance() const { return (m_count > 1) ? m_sumSquaredDeviations / (m_count - 1) : 0.0; }
+
+  /**
+   * @brief Get sample standard deviation of the values added.
+   *
+   * @return Sample standard deviation, 0 if fewer than 2 values were added
+   */
+  double getStdDev() const { return std::sqrt(getVariance()); }
+
+  /**
+   * @brief Get smallest value added.
+   *
+   * @return Smallest value, 0 if no value was added
+   */
+  int getMin() const { return m_min; }
+
+  /**
+   * @brief Get largest value added.
+   *
+   * @return Largest value, 0 if no value was added
+   */
+  int getMax() const { return m_max; }
+
+  /**
+   * @brief Get histogram of the values added.
+   *
+   * @return Count of values in each bucket
+   */
+  const std::array<int, kNumBuckets> &getHistogram() const { return m_histogram; }
+
+  /**
+   * @brief Get lowest value that falls into a bucket.
+   *
+   * @param bucket Index of the bucket
+   * @return Lowest value of the bucket, the next bucket starts getBucketWidth() higher
+   */
+  int getBucketLowest(const int bucket) const { return m_lowest + bucket * m_bucketWidth; }
+
+  /**
+   * @brief Get width of every histogram bucket.
+   *
+   * @return Number of values covered by one bucket
+   */
+  int getBucketWidth() const { return m_bucketWidth; }
+
+private:
+  int m_lowest;                             // Lowest value of the first bucket
+  int m_bucketWidth;                        // Number of values covered by one bucket
+  int m_count;                              // Number of values added
+  int m_min;                                // Smallest value added
+  int m_max;                                // Largest value added
+  long long m_sum;                          // Sum of the values added
+  double m_mean;                            // Running mean
+  double m_sumSquaredDeviations;            // Running sum of squared deviations from the mean (Welford's M2)
+  std::array<int, kNumBuckets> m_histogram; // Count of values in each bucket
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef SIMULATION_CONFIG_H
+#define SIMULATION_CONFIG_H
+
+#include <string>
+
+#include "Site.h"
+
+struct SimulationConfig
+{
+  static constexpr int kDefaultHorizonMins = 72 * 60; // 72 hours in minutes
+  static constexpr int kDefaultTravelTimeMins = 30;   // One way between the site and the stations
+  static constexpr int kDefaultUnloadTimeMins = 5;    // Time a Station takes to unload a Truck
+  static constexpr int kDefaultHeliumPerMin = 1;      // Helium mined per minute
+
+  int horizonMins = kDefaultHorizonMins;       // Simulated time every Truck mines for
+  int travelTimeMins = kDefaultTravelTimeMins; // One way travel time between the site and the stations
+  int unloadTimeMins = kDefaultUnloadTimeMins; // Time a Station takes to unload a Truck
+  int heliumPerMin = kDefaultHeliumPerMin;     // Helium mined per minute
+  int minMiningMins = Site::kMinMiningMinutes; // Shortest random mining duration
+  int maxMiningMins = Site::kMaxMiningMinutes; // Longest random mining duration
+
+  /**
+   * @brief Get the longest cycle of a Truck without queueing.
+   *
+   * @return Longest mining duration plus both trips and the unload, in minutes
+   */
+  int getMaxCycleMins() const { return maxMiningMins + (travelTimeMins * 2) + unloadTimeMins; }
+
+  /**
+   * @brief Get the shortest cycle of a Truck without queueing.
+   *
+   * @return Shortest mining duration plus both trips and the unload, in minutes
+   */
+  int getMinCycleMins() const { return minMiningMins + (travelTimeMins * 2) + unloadTimeMins; }
+
+  /**
+   * @brief Check that the values describe a runnable simulation.
+   *
+   * This function will check that every duration and the mining rate are
+   * positive and that the mining durations form a valid range.
+   *
+   * @param error Receives the reason when the check fails
+   * @return True if the configuration is valid
+   */
+  bool validate(std::string &error) const;
+};
+
+#endif
\ No newline at end of file
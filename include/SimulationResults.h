@@ -0,0 +1,96 @@
+#ifndef SIMULATION_RESULTS_H
+#define SIMULATION_RESULTS_H
+
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "Truck.h"
+#include "Station.h"
+
+class SimulationResults
+{
+public:
+  /**
+   * @brief Initialize empty results.
+   *
+   * This function will create results without Trucks or Stations, e.g.
+   * for a variable that is assigned the results of a run later.
+   */
+  SimulationResults() = default;
+
+  /**
+   * @brief Initialize results from the Trucks and Stations of a run.
+   *
+   * This function will take ownership of both vectors without copying
+   * them and sort them by id, so getTruck() and getStation() are plain
+   * index lookups whatever order the engine finished them in.
+   *
+   * @param trucks Trucks of the run
+   * @param stations Stations of the run
+   */
+  SimulationResults(std::vector<Truck> &&trucks, std::vector<Station> &&stations);
+
+  // Results are moved, never copied, so a harness cannot deep-copy them by accident
+  SimulationResults(const SimulationResults &) = delete;
+  SimulationResults &operator=(const SimulationResults &) = delete;
+  SimulationResults(SimulationResults &&) noexcept = default;
+  SimulationResults &operator=(SimulationResults &&) noexcept = default;
+
+  /**
+   * @brief Get read-only view of all Trucks.
+   *
+   * @return Trucks ordered by id
+   */
+  std::span<const Truck> getTrucks() const { return m_trucks; }
+
+  /**
+   * @brief Get read-only view of all Stations.
+   *
+   * @return Stations ordered by id
+   */
+  std::span<const Station> getStations() const { return m_stations; }
+
+  /**
+   * @brief Get one Truck.
+   *
+   * @param id Truck id
+   * @return Truck with that id
+   */
+  const Truck &getTruck(const int id) const { return m_trucks[id]; }
+
+  /**
+   * @brief Get one Station.
+   *
+   * @param id Station id
+   * @return Station with that id
+   */
+  const Station &getStation(const int id) const { return m_stations[id]; }
+
+  /**
+   * @brief Write the results as CSV.
+   *
+   * This function will write one row per Truck and then one per Station
+   * under a shared header. The record column tells them apart and columns
+   * that do not apply to Stations are left empty.
+   *
+   * @param out Stream to write to
+   */
+  void writeCsv(std::ostream &out) const;
+
+  /**
+   * @brief Write the results as JSON.
+   *
+   * This function will write an object with a "trucks" and a "stations"
+   * array holding the same fields as writeCsv().
+   *
+   * @param out Stream to write to
+   */
+  void writeJson(std::ostream &out) const;
+
+private:
+  std::vector<Truck> m_trucks;     // Trucks of the run, ordered by id
+  std::vector<Station> m_stations; // Stations of the run, ordered by id
+};
+
+#endif
\ No newline at end of file
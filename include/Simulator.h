@@ -2,23 +2,71 @@
 #define SIMULATOR_H
 
 #include <vector>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <ostream>
 #include <thread>
+#include <memory>
+#include <semaphore>
+#include <format>
+#include <utility>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <span>
 
 #include "Truck.h"
 #include "Station.h"
 #include "Site.h"
+#include "MpmcQueue.h"
+#include "AsyncLogger.h"
+#include "TraceFile.h"
+#include "UnloadTicket.h"
+#include "SimulationResults.h"
+#include "RealTimePacer.h"
+#include "SimulationConfig.h"
+#include "VirtualScheduler.h"
+#include "StationQueue.h"
+#include "Fleet.h"
+#include "EventQueue.h"
+#include "Dispatcher.h"
+#include "ProfiledMutex.h"
+#include "HdrHistogram.h"
 
 class Simulator
 {
 public:
-    // Static constants
-    static constexpr int kMaxMiningDurationMins = 72 * 60;                                                                                    // in minutes (72 hours * 60 minutes), during simulation 1 milliseconds = 1 minute
-    static constexpr int kTruckTravelTimeMins = 30;                                                                                           // in mins
-    static constexpr int kUnloadTimeMins = 5;                                                                                                 // in mins
-    static constexpr int kHeliumMiningRatePerMin = 1;                                                                                         // 1 helium/min
+    // Static constants, the defaults of SimulationConfig
+    static constexpr int kMaxMiningDurationMins = SimulationConfig::kDefaultHorizonMins;                                                      // in minutes (72 hours * 60 minutes), during simulation 1 milliseconds = 1 minute
+    static constexpr int kTruckTravelTimeMins = SimulationConfig::kDefaultTravelTimeMins;                                                     // in mins
+    static constexpr int kUnloadTimeMins = SimulationConfig::kDefaultUnloadTimeMins;                                                          // in mins
+    static constexpr int kHeliumMiningRatePerMin = SimulationConfig::kDefaultHeliumPerMin;                                                    // 1 helium/min
     static constexpr int kMaxOneCycleTimeMins = Site::kMaxMiningMinutes + (Simulator::kTruckTravelTimeMins * 2) + Simulator::kUnloadTimeMins; // Max one cycle time duration
     static constexpr int kMinOneCycleTimeMins = Site::kMinMiningMinutes + (Simulator::kTruckTravelTimeMins * 2) + Simulator::kUnloadTimeMins; // Min one cycle time duration
 
+    enum class EngineMode
+    {
+        THREADED,      // One thread per Truck and Station, paced in real time (1 millisecond = 1 minute by default)
+        EVENT_DRIVEN,  // Single thread advancing a virtual clock through a calendar of timestamped events
+        WORKER_POOL,   // Virtual clock whose Truck state transitions run as tasks on a fixed-size work-stealing pool
+        COROUTINE,     // Every Truck and Station is a C++20 coroutine driven by a single-threaded virtual clock
+        FIXED_STEP,    // Single thread stepping every Truck one minute at a time with a SIMD kernel
+        ARRIVAL_STREAM, // Per-Truck arrival streams merged into a multi-server queue recursion, same results as FIXED_STEP
+        CONSERVATIVE,   // Trucks partitioned over worker threads synchronized in lookahead windows, same results as FIXED_STEP
+        OPTIMISTIC      // Time Warp: Trucks and Stations run ahead speculatively and roll back on stragglers, same results as FIXED_STEP
+    };
+
+    struct TimeWarpStats
+    {
+        long long numRollbacks;    // Rollbacks of a Truck or of the Station process
+        long long numUndoneServes; // Station serves undone by rollbacks and served again
+        long long numAntiMessages; // Messages cancelled after they were sent
+        long long numGvtRounds;    // GVT computations, each followed by fossil collection
+        long long peakSavedStates; // Most saved Truck and Station states held at once, bounded by fossil collection
+    };
+
     /**
      * @brief Initialize simulator with number of trucks and stations.
      *
@@ -27,27 +75,242 @@ public:
      *
      * @param numTrucks Number of Trucks for 72 hour simulation
      * @param numStations Number of Stations for 72 hour simulation
+     * @param engineMode Engine used to advance simulation time
      */
-    Simulator(const int numTrucks, const int numStations) : m_numTrucks(numTrucks), m_numStations(numStations) {}
+    Simulator(const int numTrucks, const int numStations, const EngineMode engineMode = EngineMode::THREADED)
+        : m_numTrucks(numTrucks), m_numStations(numStations), m_engineMode(engineMode),
+          m_numWorkerThreads(static_cast<int>(std::thread::hardware_concurrency())),
+          m_seed((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}()),
+          m_isSummaryWritten(true), m_isMiningHistoryKept(false),
+          m_eventQueueKind(EventQueue::Kind::BINARY_HEAP), m_dispatchKind(Dispatcher::Kind::SHARED_QUEUE), m_summarySink(nullptr), m_debugSink(nullptr), m_summaryOut(nullptr),
+          m_isFinished(false) {}
 
     /**
      * @brief Creates the Truck and Station objects and starts simulation.
      *
-     * This function will create numTrucks Truck threads and numStations
-     * Station threads. It will then execute the threads and start the 72
-     * hour simulation.
+     * In THREADED mode this function will create numTrucks Truck threads
+     * and numStations Station threads. It will then execute the threads and
+     * start the 72 hour simulation. In EVENT_DRIVEN mode the same simulation
+     * is run on the calling thread in virtual time. In WORKER_POOL mode it is
+     * run in virtual time on a fixed number of worker threads. In COROUTINE
+     * mode every Truck and Station is a coroutine on a virtual clock. In
+     * FIXED_STEP mode a SIMD kernel steps the whole Fleet minute by minute.
+     * In ARRIVAL_STREAM mode only the Trucks' arrivals at the Stations are
+     * simulated, through a queueing recursion. In CONSERVATIVE mode the
+     * Trucks are split over worker threads that exchange timestamped
+     * messages with the Stations. OPTIMISTIC mode exchanges the same
+     * messages without waiting and rolls back when one comes too late.
+     * If the DEBUG flag was included during compiling, the summary ends
+     * with how often each lock was taken, contended, waited for and held.
+     *
+     * @param error Receives the reason when the simulation cannot start
+     * @return True if the simulation ran, false if the fleet has no
+     * Stations or a negative number of Trucks, the configuration fails
+     * SimulationConfig::validate(), the engine does not model the
+     * dispatch policy (see validateDispatchPolicy()) or the trace file
+     * set by setTraceFile() cannot be opened
+     */
+    bool startSimulator(std::string &error);
+
+    /**
+     * @brief Creates the Truck and Station objects and starts simulation.
+     *
+     * This function will run startSimulator(std::string &) for callers
+     * that only need to know whether the simulation ran.
+     *
+     * @return True if the simulation ran
+     */
+    bool startSimulator()
+    {
+        std::string error;
+        return startSimulator(error);
+    }
+
+    /**
+     * @brief Set number of worker threads for WORKER_POOL, CONSERVATIVE and OPTIMISTIC mode.
+     *
+     * This function will set how many threads the WORKER_POOL engine
+     * multiplexes all Trucks onto, or how many Truck partitions the
+     * CONSERVATIVE and OPTIMISTIC engines run in parallel. Defaults to
+     * the number of hardware threads.
+     *
+     * @param numWorkerThreads Number of worker threads
+     */
+    void setNumWorkerThreads(const int numWorkerThreads) { m_numWorkerThreads = numWorkerThreads; }
+
+    /**
+     * @brief Set the master seed of the simulation.
+     *
+     * This function will set the seed every Truck's random stream is
+     * derived from. Running again with the same seed replays the same
+     * mining durations for every Truck. Defaults to a random seed, which
+     * is written to the summary so any run can be replayed.
+     *
+     * @param seed Master seed
+     */
+    void setSeed(const std::uint64_t seed) { m_seed = seed; }
+
+    /**
+     * @brief Get the master seed of the simulation.
+     *
+     * @return Master seed
      */
-    void startSimulator();
+    std::uint64_t getSeed() const { return m_seed; }
+
+    /**
+     * @brief Enable or disable the summary file.
+     *
+     * This function will control whether startSimulator() writes the
+     * final Truck and Station results and the debugging log. Replications
+     * disable it so that many simulators can run side by side and be read
+     * through getTrucks() and getStations() instead.
+     *
+     * @param isSummaryWritten True to write the summary file (default)
+     */
+    void setWriteSummary(const bool isSummaryWritten) { m_isSummaryWritten = isSummaryWritten; }
+
+    /**
+     * @brief Set the constants of the simulation.
+     *
+     * This function will replace the horizon, travel time, unload time,
+     * mining rate and mining duration range that default to the static
+     * constants above, so batches of configurations can run without
+     * recompiling. startSimulator() rejects a configuration that fails
+     * SimulationConfig::validate().
+     *
+     * @param config Simulation constants
+     */
+    void setConfig(const SimulationConfig &config) { m_config = config; }
+
+    /**
+     * @brief Get the constants of the simulation.
+     *
+     * @return Simulation constants
+     */
+    const SimulationConfig &getConfig() const { return m_config; }
+
+    /**
+     * @brief Set the future event list of EVENT_DRIVEN mode.
+     *
+     * This function will choose the priority structure the event loop
+     * keeps its calendar in. Every structure fires Events in the same
+     * order, so the choice changes the speed but not the results.
+     *
+     * @param eventQueueKind Priority structure, BINARY_HEAP by default
+     */
+    void setEventQueue(const EventQueue::Kind eventQueueKind) { m_eventQueueKind = eventQueueKind; }
+
+    /**
+     * @brief Set how arriving Trucks choose a Station.
+     *
+     * This function will give every Station its own queue and let a
+     * Dispatcher commit each arriving Truck to one of them, as in a yard
+     * where drivers pick a lane. By default all Stations pull from one
+     * shared FIFO. The per-station queues are modeled by THREADED and
+     * EVENT_DRIVEN mode only; startSimulator() fails for any other engine
+     * with a policy other than SHARED_QUEUE.
+     *
+     * @param dispatchKind Dispatch policy, SHARED_QUEUE by default
+     */
+    void setDispatchPolicy(const Dispatcher::Kind dispatchKind) { m_dispatchKind = dispatchKind; }
+
+    /**
+     * @brief Set the time compression of THREADED mode.
+     *
+     * This function will set how much wall time one simulated minute
+     * takes in THREADED mode, e.g. 10 microseconds for fast demos or 1
+     * second for operator training displays. The default is 1 millisecond.
+     *
+     * @param wallTimePerMinute Wall time of one simulated minute
+     */
+    void setTimeScale(const std::chrono::nanoseconds wallTimePerMinute) { m_pacer.setWallTimePerMinute(wallTimePerMinute); }
+
+    /**
+     * @brief Get how closely the last THREADED run kept its deadlines.
+     *
+     * This function will return the number of deadlines the Truck and
+     * Station threads slept until and how late they woke, mean and max.
+     *
+     * @return Drift of the last run, empty for the virtual-time engines
+     */
+    RealTimePacer::DriftReport getDriftReport() const { return m_pacer.getDriftReport(); }
+
+    /**
+     * @brief Get how much speculation the last OPTIMISTIC run undid.
+     *
+     * This function will return the rollbacks, anti-messages and GVT
+     * rounds of the last OPTIMISTIC run, and the most states it saved.
+     *
+     * @return Counters of the last run, zero for the other engines
+     */
+    TimeWarpStats getTimeWarpStats() const { return m_timeWarpStats; }
+
+    /**
+     * @brief Keep every mining duration of every Truck.
+     *
+     * This function will switch on the full mining history for debugging,
+     * see Truck::getMiningDurations(). By default a Truck only keeps
+     * running statistics, so its memory does not grow with the horizon.
+     *
+     * @param isMiningHistoryKept True to keep every mining duration
+     */
+    void setKeepMiningHistory(const bool isMiningHistoryKept) { m_isMiningHistoryKept = isMiningHistoryKept; }
+
+    /**
+     * @brief Write the summary to a stream instead of the summary file.
+     *
+     * This function will make startSimulator() write the final Truck and
+     * Station results to the given stream. The stream is not owned and
+     * must outlive the run.
+     *
+     * @param summaryOut Stream receiving the summary
+     */
+    void setSummaryOutput(std::ostream &summaryOut) { m_summarySink = &summaryOut; }
+
+    /**
+     * @brief Write the debugging log to a stream instead of the log file.
+     *
+     * This function will make startSimulator() send debug messages to the
+     * given stream if the DEBUG flag was included during compiling. The
+     * stream is not owned and must outlive the run.
+     *
+     * @param debugOut Stream receiving the debug messages
+     */
+    void setDebugOutput(std::ostream &debugOut) { m_debugSink = &debugOut; }
+
+    /**
+     * @brief Record every Truck state transition to a binary trace file.
+     *
+     * This function will make the next startSimulator() write one
+     * fixed-size TraceRecord per Truck state transition to the file.
+     * Use the TraceDecoder tool to turn it into text or CSV.
+     *
+     * @param path Path of the trace file, empty to disable tracing
+     */
+    void setTraceFile(const std::string &path) { m_traceFilePath = path; }
 
     /**
      * @brief Return vector of all Truck objects.
      *
-     * This function will return all of the Trucks within the Simulator class.
+     * This function will return a copy of all of the Trucks within the
+     * Simulator class. Prefer getTruckView() or takeResults() when the
+     * results are read often.
      *
      * @return The vector of all the Trucks per Simulator
      */
     std::vector<Truck> getTrucks() const { return m_trucks; }
 
+    /**
+     * @brief Return read-only view of all Truck objects.
+     *
+     * This function will return the Trucks without copying them. The view
+     * is valid until the next startSimulator() or takeResults() call and
+     * must not be read while startSimulator() is running.
+     *
+     * @return View of all the Trucks, in the order they finished
+     */
+    std::span<const Truck> getTruckView() const { return m_trucks; }
+
     /**
      * @brief Append Truck object to vector.
      *
@@ -66,6 +329,34 @@ public:
      */
     std::vector<Station> getStations() const { return m_stations; }
 
+    /**
+     * @brief Return read-only view of all Station objects.
+     *
+     * This function will return the Stations without copying them, with
+     * the same lifetime as getTruckView().
+     *
+     * @return View of all the Stations, in the order they finished
+     */
+    std::span<const Station> getStationView() const { return m_stations; }
+
+    /**
+     * @brief Move the results of the last run out of the Simulator.
+     *
+     * This function will hand the Trucks and Stations of the last
+     * startSimulator() call to a SimulationResults snapshot without
+     * copying them, sorted by id. The Simulator is left without results
+     * until it is started again.
+     *
+     * @return Results of the last run
+     */
+    SimulationResults takeResults()
+    {
+        SimulationResults results(std::move(m_trucks), std::move(m_stations));
+        m_trucks.clear();
+        m_stations.clear();
+        return results;
+    }
+
     /**
      * @brief Append Station object to vector.
      *
@@ -83,8 +374,10 @@ public:
      *
      * @return The minimum number of unloads a single Truck can do during
      * entire simulation time.
+     *
+     * @param config Simulation constants, the defaults if omitted
      */
-    static int calcMinTripsPossible(); // Per truck
+    static int calcMinTripsPossible(const SimulationConfig &config = SimulationConfig()); // Per truck
 
     /**
      * @brief Calculate maximum number of unloads Truck can do.
@@ -94,8 +387,10 @@ public:
      *
      * @return The maximum number of unloads a single Truck can do during
      * entire simulation time.
+     *
+     * @param config Simulation constants, the defaults if omitted
      */
-    static int calcMaxTripsPossible(); // Per truck
+    static int calcMaxTripsPossible(const SimulationConfig &config = SimulationConfig()); // Per truck
 
     /**
      * @brief Calculate minimum possible helium mined.
@@ -105,8 +400,10 @@ public:
      *
      * @return The minimum amount of helium a single Truck can do during
      * entire simulation time.
+     *
+     * @param config Simulation constants, the defaults if omitted
      */
-    static int calcMinHeliumPossible(); // Per truck
+    static int calcMinHeliumPossible(const SimulationConfig &config = SimulationConfig()); // Per truck
 
     /**
      * @brief Calculate maximum possible helium mined.
@@ -116,16 +413,76 @@ public:
      *
      * @return The maximum amount of helium a single Truck can do during
      * entire simulation time.
+     *
+     * @param config Simulation constants, the defaults if omitted
      */
-    static int calcMaxHeliumPossible(); // Per truck
+    static int calcMaxHeliumPossible(const SimulationConfig &config = SimulationConfig()); // Per truck
+
+    /**
+     * @brief Check an engine models a dispatch policy.
+     *
+     * This function will accept SHARED_QUEUE for every engine and the
+     * per-station policies for THREADED and EVENT_DRIVEN mode only, as
+     * the other engines are built on the shared FIFO.
+     *
+     * @param engineMode Engine that would run the simulation
+     * @param dispatchKind Dispatch policy it would run
+     * @param error Receives the reason when the combination is rejected
+     * @return True if the engine runs the policy
+     */
+    static bool validateDispatchPolicy(const EngineMode engineMode, const Dispatcher::Kind dispatchKind, std::string &error);
 
 private:
-    int m_numTrucks;                                 // Value defined by user input for total number of trucks
-    int m_numStations;                               // Value defined by user input for total number of stations
-    std::vector<std::thread> m_miningTruckThreads;   // To store all mining trucks and simulate each truck
-    std::vector<std::thread> m_unloadStationThreads; // To store all unloading stations and simulate each station
-    std::vector<Truck> m_trucks;                     // To store all trucks for unit testing purposes
-    std::vector<Station> m_stations;                 // To store all stations for unit testing purposes
+    struct UnloadLane
+    {
+        explicit UnloadLane(const int capacity) : queue(capacity) {}
+
+        MpmcQueue<UnloadTicket *> queue;     // Lock-free queue of trucks waiting to be unloaded by the lane's stations
+        std::counting_semaphore<> signal{0}; // Counts queued trucks (plus one per station at the end) so idle stations can sleep
+    };
+
+    int m_numTrucks;                                        // Value defined by user input for total number of trucks
+    int m_numStations;                                      // Value defined by user input for total number of stations
+    EngineMode m_engineMode;                                // Engine used to advance simulation time
+    int m_numWorkerThreads;                                 // Worker threads used by WORKER_POOL, CONSERVATIVE and OPTIMISTIC mode
+    std::uint64_t m_seed;                                   // Master seed every truck's random stream is derived from
+    bool m_isSummaryWritten;                                // Write final results to the summary file
+    bool m_isMiningHistoryKept;                             // Trucks keep every mining duration, for debugging
+    SimulationConfig m_config;                              // Horizon, durations and rates of the simulation
+    EventQueue::Kind m_eventQueueKind;                      // Future event list of EVENT_DRIVEN mode
+    Dispatcher::Kind m_dispatchKind;                        // How arriving Trucks choose a Station
+    std::ostream *m_summarySink;                            // Injected summary stream, nullptr for the summary file
+    std::ostream *m_debugSink;                              // Injected debug stream, nullptr for the debugging log file
+    std::ostream *m_summaryOut;                             // Summary stream of the current run, nullptr if disabled
+    std::ofstream m_summaryFile;                            // Summary file owned by this instance
+    std::ofstream m_debugFile;                              // Debugging log file owned by this instance
+    std::unique_ptr<AsyncLogger> m_debugLogger;             // Debug logger of the current run, only created in DEBUG builds
+    mutable ProfiledMutex m_summaryMutex{"summaryMutex"};   // Protects the summary stream while Trucks and Stations print
+    ProfiledMutex m_resultsMutex{"resultsMutex"};           // Protects m_trucks and m_stations while threads push results
+    std::atomic<bool> m_isFinished;                         // Set once every Truck thread has finished mining
+    std::vector<std::thread> m_miningTruckThreads;          // To store all mining trucks and simulate each truck
+    std::vector<std::thread> m_unloadStationThreads;        // To store all unloading stations and simulate each station
+    std::vector<Truck> m_trucks;                            // To store all trucks for unit testing purposes
+    std::vector<Station> m_stations;                        // To store all stations for unit testing purposes
+    std::vector<std::unique_ptr<UnloadLane>> m_unloadLanes; // One lane shared by every station, or one per station with a Dispatcher
+    std::unique_ptr<Dispatcher> m_dispatcher;               // Commits trucks to a station's lane, nullptr for the shared lane
+    std::unique_ptr<UnloadTicket[]> m_unloadTickets;        // One reusable completion slot per truck, indexed by truck id
+    std::string m_traceFilePath;                            // Binary trace file requested by setTraceFile(), empty if disabled
+    std::unique_ptr<TraceFile> m_traceFile;                 // Open trace file while a traced simulation runs
+    RealTimePacer m_pacer;                                  // Wall clock of THREADED mode, converts between wall time and minutes
+    TimeWarpStats m_timeWarpStats{};                        // Speculation counters of the last OPTIMISTIC run
+#ifdef DEBUG
+    HdrHistogram m_truckUnloadWaits;                        // Nanoseconds THREADED Trucks blocked until unloaded, merged under m_resultsMutex
+    HdrHistogram m_stationIdleWaits;                        // Nanoseconds THREADED Stations blocked until a Truck arrived, merged under m_resultsMutex
+#endif
+
+    /**
+     * @brief Run the whole simulation with one thread per Truck and Station.
+     *
+     * This function will create numTrucks Truck threads and numStations
+     * Station threads paced in real time and wait for all of them.
+     */
+    void simulateThreaded();
 
     /**
      * @brief Truck simulating 72 hour mining.
@@ -148,19 +505,187 @@ private:
     void simulateStation(int id);
 
     /**
-     * @brief Checks if Station processed Truck or if Truck is waiting
-     * to be processed.
+     * @brief Run the whole simulation on a virtual clock.
      *
-     * This function will check if a Station has processed the Truck
-     * or if it waiting by checking if the Truck is still at the same
-     * index in the shared data vector when it was first pushed by the Truck.
+     * This function will simulate every Truck and Station on the calling
+     * thread. Trucks and Stations schedule the completion of their current
+     * action as timestamped Events and the clock jumps straight to the
+     * next Event instead of sleeping.
+     */
+    void simulateEventDriven();
+
+    /**
+     * @brief Run the whole simulation on a pool of worker threads.
      *
-     * @param truck Truck object to check if it is still in the
-     * same position in the shared data vector
-     * @param position Index at which the Truck object was pushed in at
-     * @return Flag to check if Truck has been unloaded by a Station
+     * This function will advance a virtual clock one minute at a time.
+     * Every Truck whose action completes in that minute is advanced as a
+     * task on the work-stealing WorkerPool, then the Stations hand out
+     * the unload queue in arrival order. The number of Trucks is bounded
+     * by memory rather than by OS threads.
+     */
+    void simulateWorkerPool();
+
+    /**
+     * @brief Run the whole simulation as coroutine actors.
+     *
+     * This function will spawn one truckActor() per Truck and one
+     * stationActor() per Station on a VirtualScheduler and run them
+     * on the calling thread until every actor has finished.
+     */
+    void simulateCoroutines();
+
+    /**
+     * @brief Run the whole simulation in fixed one minute steps.
+     *
+     * This function will keep every Truck in a Fleet and scan its next
+     * event time column once per minute with FixedStepKernel. Travel
+     * transitions are applied in SIMD batches; only MINING (random draw)
+     * and UNLOADING (Station contention) go through advanceTruckState().
+     * If a trace file is requested or DEBUG is defined, every transition
+     * takes the scalar path so it is traced and logged.
      */
-    bool didStationProcessTruck(const Truck truck, const int position);
+    void simulateFixedStep();
+
+    /**
+     * @brief Run the whole simulation as a stream of Station arrivals.
+     *
+     * This function will use that a Truck's mining durations come from
+     * its own random stream and do not depend on the Stations: they are
+     * drawn up front, so a Truck's next arrival follows directly from its
+     * last pickup. Arrivals are bucketed by minute and served in (minute,
+     * id) order by a WorkloadRecursion, whose pickup times are fed back
+     * into each Truck's next arrival. Travel, mining and unload
+     * transitions are never simulated one by one. The results are the
+     * same as FIXED_STEP, which this function falls back to when a trace
+     * file is requested or DEBUG is defined, so every transition is
+     * traced and logged.
+     */
+    void simulateArrivalStream();
+
+    /**
+     * @brief Run the whole simulation as conservative parallel logical processes.
+     *
+     * This function will split the Trucks into contiguous id ranges, one
+     * logical process per worker thread, and keep all Stations in a single
+     * logical process because their shared FIFO queue is one sequential
+     * dependency. A Truck sends its arrival when it leaves the mining site,
+     * travel time ahead, and the Stations send a pickup, unload time ahead.
+     * The smaller of the two is the lookahead: simulated time advances in
+     * windows of that length, each ending at a barrier, and messages sent in
+     * one window are received at the start of the next. The results are the
+     * same as FIXED_STEP.
+     */
+    void simulateConservative();
+
+    /**
+     * @brief Run the whole simulation as an optimistic Time Warp.
+     *
+     * This function will use the same logical processes and messages as
+     * simulateConservative(), but no process waits: every Truck and the
+     * Station process run ahead speculatively. An arrival that comes in
+     * behind an arrival the Stations already served rolls them back
+     * through WorkloadRecursion::undoLastServe(); cancelled pickups are
+     * re-sent only if serving again changes them (lazy cancellation). A
+     * Truck saves a copy of itself before every pickup and restores it
+     * when the pickup is cancelled, sending anti-messages for the arrivals
+     * it sent since. Every round of events ends at a barrier where the GVT,
+     * the earliest time any process can still be rolled back to, is taken
+     * and older saved states are fossil collected; no process runs more
+     * than a fixed window past the GVT. The results are the same as
+     * FIXED_STEP. Tracing and debug logging cannot be undone, so with a
+     * trace file or DEBUG this function runs simulateConservative().
+     */
+    void simulateOptimistic();
+
+    /**
+     * @brief Truck simulating 72 hour mining as a coroutine.
+     *
+     * This function is the coroutine form of simulateTruck(). Every sleep
+     * becomes a co_await on the virtual clock and the unload wait becomes
+     * a co_await on the StationQueue.
+     *
+     * @param scheduler Scheduler owning the virtual clock
+     * @param stationQueue Queue shared with the Station actors
+     * @param miningTruck Truck to simulate
+     * @param activeTrucks Number of Trucks still running, the last one closes the queue
+     * @return Coroutine task to spawn on the scheduler
+     */
+    SimTask truckActor(VirtualScheduler &scheduler, StationQueue &stationQueue, Truck &miningTruck, int &activeTrucks);
+
+    /**
+     * @brief Station simulating unloading Trucks as a coroutine.
+     *
+     * This function is the coroutine form of simulateStation(). It
+     * unloads Trucks from the StationQueue until the queue is closed.
+     *
+     * @param scheduler Scheduler owning the virtual clock
+     * @param stationQueue Queue shared with the Truck actors
+     * @param unloadStation Station to simulate
+     * @return Coroutine task to spawn on the scheduler
+     */
+    SimTask stationActor(VirtualScheduler &scheduler, StationQueue &stationQueue, Station &unloadStation);
+
+    /**
+     * @brief Perform the action of the Truck's current state.
+     *
+     * This function will update the Truck for its current state, move it
+     * to its next state and return how long the action takes. It is shared
+     * by every engine so they all follow the same Truck state machine.
+     * TruckType is Truck or a Fleet::TruckRef view.
+     *
+     * @param truck Truck to advance
+     * @param elapsedTime The Truck's elapsed time in minutes
+     * @return Duration of the action in minutes
+     */
+    template <typename TruckType>
+    int advanceTruckState(TruckType &truck, const int elapsedTime);
+
+    /**
+     * @brief Record that a Station picked a Truck up from the unload queue.
+     *
+     * This function will count the Truck and its helium at the Station
+     * and then record the unload on the Truck, see the overload below.
+     * Every engine that owns its Stations unloads through it.
+     *
+     * @param time Simulation time of the pickup in minutes
+     * @param truck Truck that was picked up
+     * @param unloadStation Station unloading the Truck
+     * @param queueWaitMins Minutes the Truck waited in the unload queue on this trip
+     */
+    template <typename TruckType>
+    void recordUnload(const int time, TruckType &truck, Station &unloadStation, const int queueWaitMins);
+
+    /**
+     * @brief Record an unload on the Truck only.
+     *
+     * This function will add the queue wait and the unload to the Truck's
+     * totals, log and trace the pickup and clear the Truck's trip wait and
+     * queue flag. The CONSERVATIVE and OPTIMISTIC engines call it directly,
+     * as their Stations are counted by a separate logical process.
+     *
+     * @param time Simulation time of the pickup in minutes
+     * @param truck Truck that was picked up
+     * @param stationId Station unloading the Truck
+     * @param queueWaitMins Minutes the Truck waited in the unload queue on this trip
+     */
+    template <typename TruckType>
+    void recordUnload(const int time, TruckType &truck, const int stationId, const int queueWaitMins);
+
+    /**
+     * @brief Record a Truck state transition in the binary trace.
+     *
+     * This function will append one TraceRecord for the Truck's move from
+     * oldState to its current state if a trace file was requested.
+     *
+     * @param time Simulation time of the transition in minutes
+     * @param truck Truck that changed state
+     * @param stationId Station that unloaded the Truck, -1 if none
+     * @param oldState Truck's state before the transition
+     * @param queueWait Minutes the Truck waited in the unload queue on this trip
+     */
+    template <typename TruckType>
+    void traceTransition(const int time, const TruckType &truck, const int stationId,
+                         const Truck::State oldState, const int queueWait);
 
     /**
      * @brief Print results of all the Trucks.
@@ -183,25 +708,74 @@ private:
      */
     void printStationResults(const Station &station) const;
 
-    // Private static member functions
     /**
-     * @brief Print message to designated text file.
+     * @brief Create a Truck for a run.
+     *
+     * This function will create the Truck with its seeded random stream,
+     * the mining history setting and statistics over the configured
+     * mining durations.
+     *
+     * @param id Truck ID
+     * @return New Truck, MINING at time 0
+     */
+    Truck makeTruck(const int id) const;
+
+    /**
+     * @brief Create the Fleet of a run.
      *
-     * This function will print the message to the designated text file
-     * if the DEBUG flag was included during compiling.
+     * This function will create a Fleet of every Truck, set up like the
+     * Trucks from makeTruck().
      *
-     * @param message Message to output
+     * @return New Fleet, every Truck MINING at time 0
      */
-    static void printMessage(const std::string &message);
+    Fleet makeFleet() const;
 
     /**
-     * @brief Build string message.
+     * @brief Print how closely the THREADED run kept real time.
      *
-     * This function will create a string that can be used to print out.
+     * This function will print the time compression and the measured
+     * wake-up drift of the Truck and Station threads to the summary.
+     */
+    void printPacingResults() const;
+
+#ifdef DEBUG
+    /**
+     * @brief Print how the locks of the run were used.
+     *
+     * This function will print, for the results and summary locks and
+     * the trace file and debug logger locks if they exist, how often they
+     * were taken and contended, and the total, median, 99th percentile
+     * and longest wait and hold times, to the summary. After a THREADED
+     * run it also prints how long the Trucks blocked waiting to be
+     * unloaded and the Stations blocked waiting for a Truck, the waits
+     * that hold up a run far more than its locks.
+     */
+    void printLockResults();
+#endif
+
+    /**
+     * @brief Print message to designated text file.
      *
-     * @param message Message to create a string of
+     * This function will format the message into the calling thread's
+     * buffer of the asynchronous debug logger if the DEBUG flag was
+     * included during compiling. Otherwise nothing is formatted.
+     *
+     * @param format Format string as for std::format
+     * @param args Format arguments
      */
-    static std::string composeDebugMsg(const std::string message);
+    template <typename... Args>
+    void debugLog(std::format_string<Args...> format, Args &&...args)
+    {
+#ifdef DEBUG
+        if (m_debugLogger)
+        {
+            m_debugLogger->log(format, std::forward<Args>(args)...);
+        }
+#else
+        ((void)format, ..., (void)args);
+#endif
+    }
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,308 @@
+#ifndef SIMULATOR_T_H
+#define SIMULATOR_T_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "SimulationConfig.h"
+#include "SimulationResults.h"
+#include "Station.h"
+#include "Truck.h"
+
+// Scenario of today's Simulator constants, see SimulationConfig for the meaning of each value
+struct DefaultScenario
+{
+  static constexpr int kHorizonMins = SimulationConfig::kDefaultHorizonMins;
+  static constexpr int kTravelTimeMins = SimulationConfig::kDefaultTravelTimeMins;
+  static constexpr int kUnloadTimeMins = SimulationConfig::kDefaultUnloadTimeMins;
+  static constexpr int kHeliumPerMin = SimulationConfig::kDefaultHeliumPerMin;
+  static constexpr int kMinMiningMins = Site::kMinMiningMinutes;
+  static constexpr int kMaxMiningMins = Site::kMaxMiningMinutes;
+};
+
+template <typename Params = DefaultScenario>
+class SimulatorT
+{
+public:
+  static_assert(Params::kHorizonMins > 0 && Params::kTravelTimeMins > 0 && Params::kUnloadTimeMins > 0 &&
+                    Params::kHeliumPerMin > 0 && Params::kMinMiningMins > 0,
+                "Scenario durations and helium rate must be positive");
+  static_assert(Params::kMaxMiningMins >= Params::kMinMiningMins, "Scenario mining durations must form a valid range");
+
+  static constexpr int kMaxCycleMins = Params::kMaxMiningMins + (Params::kTravelTimeMins * 2) + Params::kUnloadTimeMins;          // Longest cycle without queueing
+  static constexpr int kMinCycleMins = Params::kMinMiningMins + (Params::kTravelTimeMins * 2) + Params::kUnloadTimeMins;          // Shortest cycle without queueing
+  static constexpr int kMaxEventDelayMins = std::max({Params::kMaxMiningMins, Params::kTravelTimeMins, Params::kUnloadTimeMins}); // Furthest ahead an event is scheduled
+
+  /**
+   * @brief Initialize simulator for a compile-time scenario.
+   *
+   * This function will set the fleet size. Every timing constant comes
+   * from Params, so the compiler folds the cycle arithmetic and the
+   * mining duration range into the engine.
+   *
+   * @param numTrucks Number of Trucks
+   * @param numStations Number of Stations
+   */
+  SimulatorT(const int numTrucks, const int numStations)
+      : m_numTrucks(numTrucks), m_numStations(numStations),
+        m_seed((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}()) {}
+
+  /**
+   * @brief Run the simulation.
+   *
+   * This function will run the EVENT_DRIVEN algorithm of Simulator on the
+   * calling thread and gives the same results for the same seed. Because
+   * no event is scheduled more than kMaxEventDelayMins ahead, the future
+   * event list is a ring of one bucket per minute whose size is fixed at
+   * compile time, instead of a binary heap. No summary is written; read
+   * the results through the views or takeResults().
+   */
+  void startSimulator();
+
+  /**
+   * @brief Set master seed of the random streams.
+   *
+   * @param seed Master seed, same meaning as in Simulator::setSeed()
+   */
+  void setSeed(const std::uint64_t seed) { m_seed = seed; }
+
+  /**
+   * @brief Get master seed of the random streams.
+   *
+   * @return Master seed
+   */
+  std::uint64_t getSeed() const { return m_seed; }
+
+  /**
+   * @brief Get the scenario as a runtime configuration.
+   *
+   * This function will return the values of Params, e.g. to run the
+   * runtime-configurable Simulator on the same scenario.
+   *
+   * @return Configuration equal to Params
+   */
+  static constexpr SimulationConfig getConfig()
+  {
+    SimulationConfig config;
+    config.horizonMins = Params::kHorizonMins;
+    config.travelTimeMins = Params::kTravelTimeMins;
+    config.unloadTimeMins = Params::kUnloadTimeMins;
+    config.heliumPerMin = Params::kHeliumPerMin;
+    config.minMiningMins = Params::kMinMiningMins;
+    config.maxMiningMins = Params::kMaxMiningMins;
+    return config;
+  }
+
+  /**
+   * @brief Get read-only view of the Trucks of the last run.
+   *
+   * @return Trucks ordered by id
+   */
+  std::span<const Truck> getTruckView() const { return m_trucks; }
+
+  /**
+   * @brief Get read-only view of the Stations of the last run.
+   *
+   * @return Stations ordered by id
+   */
+  std::span<const Station> getStationView() const { return m_stations; }
+
+  /**
+   * @brief Move the results of the last run out of the simulator.
+   *
+   * @return Snapshot of the Trucks and Stations
+   */
+  SimulationResults takeResults()
+  {
+    SimulationResults results(std::move(m_trucks), std::move(m_stations));
+    m_trucks.clear();
+    m_stations.clear();
+    return results;
+  }
+
+  /**
+   * @brief Calculate minimum trips per Truck.
+   *
+   * @return Trips in the horizon if every cycle takes kMaxCycleMins
+   */
+  static constexpr int calcMinTripsPossible() { return Params::kHorizonMins / kMaxCycleMins; }
+
+  /**
+   * @brief Calculate maximum trips per Truck.
+   *
+   * @return Trips in the horizon if every cycle takes kMinCycleMins
+   */
+  static constexpr int calcMaxTripsPossible() { return Params::kHorizonMins / kMinCycleMins; }
+
+  /**
+   * @brief Calculate minimum helium per Truck without queueing.
+   *
+   * @return Helium of calcMinTripsPossible() shortest mining durations
+   */
+  static constexpr int calcMinHeliumPossible() { return calcMinTripsPossible() * Params::kMinMiningMins * Params::kHeliumPerMin; }
+
+  /**
+   * @brief Calculate maximum helium per Truck.
+   *
+   * This function will count every complete longest cycle plus whatever
+   * mining still fits before the horizon on the last one, the same bound
+   * as Simulator::calcMaxHeliumPossible().
+   *
+   * @return Maximum helium a Truck can unload
+   */
+  static constexpr int calcMaxHeliumPossible()
+  {
+    constexpr int numberCompleteCycles = Params::kHorizonMins / kMaxCycleMins;
+    constexpr int leftoverTime = Params::kHorizonMins - (kMaxCycleMins * numberCompleteCycles);
+    constexpr int lastIterMaxMiningDur = leftoverTime - Params::kTravelTimeMins - Params::kUnloadTimeMins;
+    return (numberCompleteCycles * Params::kMaxMiningMins + std::max(lastIterMaxMiningDur, 0)) * Params::kHeliumPerMin;
+  }
+
+private:
+  static constexpr int kCalendarSize = std::bit_ceil(static_cast<unsigned>(kMaxEventDelayMins) + 1); // Buckets in the calendar ring
+  static constexpr int kCalendarMask = kCalendarSize - 1;                                           // Maps a time to its bucket
+  static constexpr int kStationEvent = 1;                                                           // Low bit of a calendar entry, set for Stations
+
+  int m_numTrucks;                 // Number of Trucks
+  int m_numStations;               // Number of Stations
+  std::uint64_t m_seed;            // Master seed every truck's random stream is derived from
+  std::vector<Truck> m_trucks;     // Trucks of the last run, ordered by id
+  std::vector<Station> m_stations; // Stations of the last run, ordered by id
+
+  /**
+   * @brief Advance a Truck to its next state.
+   *
+   * This function will apply the same transitions as
+   * Simulator::advanceTruckState() with the scenario constants folded in.
+   *
+   * @param truck Truck to advance
+   * @return Minutes until the new state completes
+   */
+  static int advanceTruckState(Truck &truck);
+};
+
+template <typename Params>
+void SimulatorT<Params>::startSimulator()
+{
+  std::vector<Truck> trucks;                                                  // Trucks indexed by id, owned by the event loop
+  std::vector<Station> stations;                                              // Stations indexed by id, owned by the event loop
+  std::vector<int> queueArrivalTime(m_numTrucks, 0);                          // Time each waiting truck joined the unload queue
+  std::queue<int> unloadQueue;                                                // FIFO of truck ids waiting for a station
+  std::priority_queue<int, std::vector<int>, std::greater<int>> idleStations; // Idle station ids, lowest id first
+  std::vector<std::vector<int>> calendar(kCalendarSize);                      // Entries (id << 1 | kStationEvent) due at each minute, in scheduling order
+  long long numPendingEvents = 0;                                             // Entries still in the calendar
+
+  const auto schedule = [&](const int time, const int entry)
+  {
+    calendar[time & kCalendarMask].push_back(entry);
+    ++numPendingEvents;
+  };
+
+  trucks.reserve(m_numTrucks);
+  for (int i = 0; i < m_numTrucks; ++i)
+  {
+    trucks.emplace_back(i, m_seed);
+    trucks.back().setMiningStats(RunningStats(Params::kMinMiningMins, Params::kMaxMiningMins));
+    schedule(0, i << 1); // All trucks start mining simultaneously
+  }
+  stations.reserve(m_numStations);
+  for (int i = 0; i < m_numStations; ++i)
+  {
+    stations.emplace_back(i);
+    idleStations.push(i);
+  }
+
+  // Entries of one bucket are in scheduling order, which is the (time, sequence) order of Simulator's calendar
+  for (int now = 0; numPendingEvents > 0; ++now)
+  {
+    std::vector<int> &bucket = calendar[now & kCalendarMask];
+    for (std::size_t i = 0; i < bucket.size(); ++i) // Entries scheduled for now are appended while the bucket is processed
+    {
+      const int entry = bucket[i];
+      --numPendingEvents;
+
+      if ((entry & kStationEvent) != 0)
+      {
+        idleStations.push(entry >> 1);
+      }
+      else if (now < Params::kHorizonMins)
+      {
+        Truck &truck = trucks[entry >> 1];
+        const Truck::State currentState = truck.getCurrentState();
+        const int sleepTime = advanceTruckState(truck);
+
+        if (currentState == Truck::State::UNLOADING)
+        {
+          // Truck resumes once a station picks it up, see the dispatch loop below
+          truck.setIsInDataQueue(true);
+          queueArrivalTime[truck.getId()] = now;
+          unloadQueue.push(truck.getId());
+        }
+        else
+        {
+          schedule(std::min(now + sleepTime, Params::kHorizonMins), entry);
+        }
+      }
+
+      // Hand waiting trucks to idle stations
+      while (!unloadQueue.empty() && !idleStations.empty())
+      {
+        Station &unloadStation = stations[idleStations.top()];
+        idleStations.pop();
+        Truck &truck = trucks[unloadQueue.front()];
+        unloadQueue.pop();
+
+        unloadStation.incrementTotalTrucksUnloaded();
+        unloadStation.setTotalHeliumReceived(unloadStation.getTotalHeliumReceived() + truck.getCurrentMinedHelium());
+        truck.incrementTotalNumberUnloads();
+        truck.setTotalQueueWait(truck.getTotalQueueWait() + now - queueArrivalTime[truck.getId()]);
+        truck.setIsInDataQueue(false);
+
+        schedule(now + Params::kUnloadTimeMins, (unloadStation.getId() << 1) | kStationEvent);
+        schedule(std::max(now, std::min(now + Params::kUnloadTimeMins, Params::kHorizonMins)), truck.getId() << 1);
+      }
+    }
+    bucket.clear();
+  }
+
+  m_trucks = std::move(trucks);
+  m_stations = std::move(stations);
+}
+
+template <typename Params>
+int SimulatorT<Params>::advanceTruckState(Truck &truck)
+{
+  switch (truck.getCurrentState())
+  {
+  case Truck::State::MINING:
+  {
+    const int miningTime = truck.getRandomStream().nextInRange(Params::kMinMiningMins, Params::kMaxMiningMins); // Constant range, no division per draw
+    truck.setCurrentMiningTime(miningTime);
+    truck.setCurrentMinedHelium(miningTime * Params::kHeliumPerMin);
+    truck.setTotalMiningTime(truck.getTotalMiningTime() + miningTime);
+    truck.saveMiningDuration(miningTime);
+    truck.setCurrentState(Truck::State::TRAVEL_TO_UNLOAD_STATION);
+    return miningTime;
+  }
+  case Truck::State::TRAVEL_TO_MINING_SITE:
+    truck.setCurrentState(Truck::State::MINING);
+    return Params::kTravelTimeMins;
+  case Truck::State::TRAVEL_TO_UNLOAD_STATION:
+    truck.setCurrentState(Truck::State::UNLOADING);
+    return Params::kTravelTimeMins;
+  case Truck::State::UNLOADING:
+    truck.setTotalMinedHelium(truck.getTotalMinedHelium() + truck.getCurrentMinedHelium());
+    truck.setCurrentState(Truck::State::TRAVEL_TO_MINING_SITE);
+    return Params::kUnloadTimeMins;
+  default:
+    return 0;
+  }
+}
+
+#endif
\ No newline at end of file
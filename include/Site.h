@@ -1,6 +1,8 @@
 #ifndef SITE_H
 #define SITE_H
 
+#include "RandomStream.h"
+
 class Site
 {
 public:
@@ -16,6 +18,32 @@ public:
    * @return Randomly generated number between 60 and 300.
    */
   static int getRandomMinedDuration();
+
+  /**
+   * @brief Generate a random number from a given random stream.
+   *
+   * This function will draw a number between the values 60 and 300
+   * from the caller's random stream, so the result is reproducible
+   * and no state is shared between callers.
+   *
+   * @param randomStream Random stream to draw from
+   * @return Randomly generated number between 60 and 300.
+   */
+  static int getRandomMinedDuration(RandomStream &randomStream);
+
+  /**
+   * @brief Generate a random number in a configured range.
+   *
+   * This function will draw a number between minMinutes and maxMinutes
+   * from the caller's random stream, for simulations that do not use
+   * the default mining durations.
+   *
+   * @param randomStream Random stream to draw from
+   * @param minMinutes Shortest mining duration
+   * @param maxMinutes Longest mining duration
+   * @return Randomly generated number between minMinutes and maxMinutes.
+   */
+  static int getRandomMinedDuration(RandomStream &randomStream, const int minMinutes, const int maxMinutes);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef STATION_QUEUE_H
+#define STATION_QUEUE_H
+
+#include <coroutine>
+#include <deque>
+
+#include "Truck.h"
+#include "VirtualScheduler.h"
+
+class StationQueue
+{
+public:
+  struct Pickup
+  {
+    Truck *truck;      // Truck to unload, nullptr once the queue is closed and empty
+    int queueWaitMins; // Time the Truck waited in the queue in minutes
+  };
+
+  class PushAwaiter
+  {
+  public:
+    PushAwaiter(StationQueue &queue, Truck &truck) : m_queue(queue), m_truck(truck), m_queueWaitMins(0) {}
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { m_queue.pushTruck(m_truck, handle, &m_queueWaitMins); }
+    int await_resume() const noexcept { return m_queueWaitMins; }
+
+  private:
+    StationQueue &m_queue; // Queue the Truck waits in
+    Truck &m_truck;        // Truck waiting to be unloaded
+    int m_queueWaitMins;   // Filled in by the Station that picks the Truck up
+  };
+
+  class PopAwaiter
+  {
+  public:
+    explicit PopAwaiter(StationQueue &queue) : m_queue(queue), m_pickup{nullptr, 0} {}
+    bool await_ready() { return m_queue.tryPopTruck(m_pickup); }
+    void await_suspend(std::coroutine_handle<> handle) { m_queue.waitForTruck(handle, &m_pickup); }
+    Pickup await_resume() const noexcept { return m_pickup; }
+
+  private:
+    StationQueue &m_queue; // Queue the Station pulls from
+    Pickup m_pickup;       // Truck handed to the Station
+  };
+
+  /**
+   * @brief Initialize an empty, open queue.
+   *
+   * @param scheduler Scheduler that resumes the waiting Truck and Station coroutines
+   */
+  explicit StationQueue(VirtualScheduler &scheduler) : m_scheduler(scheduler), m_isClosed(false) {}
+
+  /**
+   * @brief Wait in the queue until a Station picks the Truck up.
+   *
+   * This function will return an awaiter that suspends the Truck
+   * coroutine until a Station pops it. The co_await evaluates to the
+   * time the Truck waited in minutes.
+   *
+   * @param truck Truck waiting to be unloaded
+   * @return Awaiter to co_await
+   */
+  PushAwaiter push(Truck &truck) { return PushAwaiter(*this, truck); }
+
+  /**
+   * @brief Wait until a Truck is available to unload.
+   *
+   * This function will return an awaiter that suspends the Station
+   * coroutine until a Truck is pushed. The co_await evaluates to the
+   * Truck and its queue wait, or to a nullptr Truck once the queue is
+   * closed and empty.
+   *
+   * @return Awaiter to co_await
+   */
+  PopAwaiter pop() { return PopAwaiter(*this); }
+
+  /**
+   * @brief Close the queue once no Truck can push any more.
+   *
+   * This function will wake every Station waiting for a Truck with a
+   * nullptr Truck so it can finish.
+   */
+  void close();
+
+private:
+  struct WaitingTruck
+  {
+    Truck *truck;                   // Truck waiting to be unloaded
+    int arrivalTime;                // Virtual time the Truck joined the queue
+    std::coroutine_handle<> handle; // Suspended Truck coroutine
+    int *queueWaitMins;             // Where to write the Truck's queue wait
+  };
+
+  struct WaitingStation
+  {
+    std::coroutine_handle<> handle; // Suspended Station coroutine
+    Pickup *pickup;                 // Where to write the Truck handed to the Station
+  };
+
+  /**
+   * @brief Append a suspended Truck to the queue.
+   *
+   * This function will queue the Truck and hand it straight to an
+   * idle Station if one is waiting.
+   *
+   * @param truck Truck waiting to be unloaded
+   * @param handle Suspended Truck coroutine
+   * @param queueWaitMins Where to write the Truck's queue wait
+   */
+  void pushTruck(Truck &truck, std::coroutine_handle<> handle, int *queueWaitMins);
+
+  /**
+   * @brief Take the oldest Truck off the queue without waiting.
+   *
+   * This function will fill in the pickup and schedule the Truck
+   * coroutine to resume at the current time.
+   *
+   * @param pickup Receives the Truck and its queue wait
+   * @return False if the Station has to wait for a Truck, otherwise true
+   */
+  bool tryPopTruck(Pickup &pickup);
+
+  /**
+   * @brief Park an idle Station until a Truck is pushed.
+   *
+   * @param handle Suspended Station coroutine
+   * @param pickup Where to write the Truck handed to the Station
+   */
+  void waitForTruck(std::coroutine_handle<> handle, Pickup *pickup);
+
+  VirtualScheduler &m_scheduler;         // Scheduler owning the virtual clock
+  std::deque<WaitingTruck> m_trucks;     // Trucks waiting for a Station, first in first out
+  std::deque<WaitingStation> m_stations; // Idle Stations waiting for a Truck, first in first out
+  bool m_isClosed;                       // Set once no Truck can push any more
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef TIMING_WHEEL_EVENT_QUEUE_H
+#define TIMING_WHEEL_EVENT_QUEUE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "EventQueue.h"
+
+class TimingWheelEventQueue : public EventQueue
+{
+public:
+  static constexpr int kSlotBits = 6;              // Slots per level = 2^kSlotBits
+  static constexpr int kNumSlots = 1 << kSlotBits; // Slots per level, one bit each in a 64 bit occupancy mask
+  static constexpr int kNumLevels = 6;             // kNumLevels * kSlotBits covers every non-negative int time
+
+  /**
+   * @brief Add an Event to the wheel.
+   *
+   * This function will put an Event due at the current minute straight
+   * into the ready list, and any other Event into the slot of the lowest
+   * level whose slots are finer than its distance from the current minute.
+   *
+   * @param event Event to add
+   */
+  void push(const Event &event) override;
+
+  /**
+   * @brief Remove the earliest Event.
+   *
+   * This function will return the next Event of the ready list. Once it
+   * is empty the wheel turns to the next occupied slot, found with the
+   * occupancy masks. A slot of a higher level is cascaded to the lower
+   * levels when the wheel reaches it.
+   *
+   * @return Next Event
+   */
+  Event pop() override;
+
+  /**
+   * @brief Get number of Events in the wheel.
+   *
+   * @return Number of Events
+   */
+  std::size_t size() const override { return m_size; }
+
+private:
+  std::array<std::array<std::vector<Event>, kNumSlots>, kNumLevels> m_slots{}; // Events per level and slot, unordered
+  std::array<std::uint64_t, kNumLevels> m_occupied{};                         // Bit per non-empty slot, per level
+  std::vector<Event> m_ready;                                                 // Events of the current minute in firing order
+  std::vector<Event> m_cascade;                                               // Events of a higher level slot being cascaded, kept to avoid allocating
+  std::size_t m_readyHead = 0;                                                // First Event of m_ready not yet popped
+  int m_now = 0;                                                              // Current minute of the wheel
+  std::size_t m_size = 0;                                                     // Number of Events in the wheel
+
+  /**
+   * @brief Place an Event in the ready list or a slot.
+   *
+   * @param event Event to place
+   */
+  void place(const Event &event);
+
+  /**
+   * @brief Turn the wheel to the next minute with Events.
+   *
+   * This function will fill the ready list from the next occupied slot,
+   * cascading higher levels as needed. The wheel must not be empty.
+   */
+  void advance();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Truck.h"
+#include "ProfiledMutex.h"
+
+struct TraceRecord
+{
+  std::int32_t timestamp;  // Simulation time of the transition in minutes
+  std::int32_t truckId;    // Truck that changed state
+  std::int32_t stationId;  // Station that unloaded the Truck, -1 if no Station was involved
+  std::int32_t helium;     // Helium carried by the Truck on this trip
+  std::int32_t queueWait;  // Minutes the Truck waited in the unload queue on this trip
+  std::uint8_t oldState;   // Truck::State before the transition
+  std::uint8_t newState;   // Truck::State after the transition
+  std::uint16_t reserved;  // Padding, always 0
+};
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord must keep its on-disk size");
+
+struct TraceFileHeader
+{
+  char magic[4];            // Always "MTRC"
+  std::uint32_t version;    // TraceFile::kVersion
+  std::uint32_t recordSize; // sizeof(TraceRecord)
+  std::uint32_t reserved;   // Padding, always 0
+};
+static_assert(sizeof(TraceFileHeader) == 16, "TraceFileHeader must keep its on-disk size");
+
+class TraceFile
+{
+public:
+  static constexpr std::uint32_t kVersion = 1;          // Bumped whenever TraceRecord changes
+  static constexpr std::size_t kBufferedRecords = 4096; // Records collected before each write to disk
+
+  /**
+   * @brief Open a binary trace file for writing.
+   *
+   * This function will create the file and write its header.
+   * Records are stored in the machine's native byte order.
+   *
+   * @param path Path of the trace file
+   */
+  explicit TraceFile(const std::string &path);
+
+  /**
+   * @brief Write any buffered records and close the file.
+   */
+  ~TraceFile();
+
+  TraceFile(const TraceFile &) = delete;
+  TraceFile &operator=(const TraceFile &) = delete;
+
+  /**
+   * @brief Check the file was opened.
+   *
+   * @return True if records can be written
+   */
+  bool isOpen() const { return m_file.is_open(); }
+
+  /**
+   * @brief Append one state transition.
+   *
+   * This function will buffer the record and write the buffer to disk
+   * once it is full. Safe to call from several threads.
+   *
+   * @param record Transition to append
+   */
+  void write(const TraceRecord &record);
+
+  /**
+   * @brief Write buffered records to disk.
+   */
+  void flush();
+
+  /**
+   * @brief Read every record of a trace file.
+   *
+   * This function will check the header and load all records.
+   *
+   * @param path Path of the trace file
+   * @param records Receives the records in the order they were written
+   * @return False if the file is missing or not a trace of this version
+   */
+  static bool read(const std::string &path, std::vector<TraceRecord> &records);
+
+  /**
+   * @brief Get the name of a Truck state.
+   *
+   * @param state Truck::State stored in a record
+   * @return Name as used in the debugging log
+   */
+  static const char *getStateName(const std::uint8_t state);
+
+#ifdef DEBUG
+  /**
+   * @brief Get the lock profile of the record buffer.
+   *
+   * @return Profile of the lock taken by every write() and flush()
+   */
+  ProfiledMutex::Profile getLockProfile() { return m_mutex.getProfile(); }
+#endif
+
+private:
+  /**
+   * @brief Write buffered records to disk, m_mutex must be held.
+   */
+  void flushLocked();
+
+  std::ofstream m_file;              // Binary trace file
+  ProfiledMutex m_mutex;             // Protects m_buffer and m_file between threads
+  std::vector<TraceRecord> m_buffer; // Records not yet written
+};
+
+#endif
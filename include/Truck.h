@@ -3,6 +3,11 @@
 #define TRUCK_H
 
 #include <vector>
+#include <cstdint>
+
+#include "RandomStream.h"
+#include "RunningStats.h"
+#include "Site.h"
 
 class Truck
 {
@@ -22,9 +27,23 @@ public:
    *
    * @param id Truck ID
    */
-  explicit Truck(const int id) : m_id(id), m_currentState(MINING), m_currentMiningTime(0), m_currentMinedHelium(0),
-                                 m_currentTripQueueWait(0), m_totalMinedHelium(0), m_totalMiningTime(0),
-                                 m_totalUnloadedTrips(0), m_isInDataQueue(false), m_totalQueueWait(0) {}
+  explicit Truck(const int id) : Truck(id, 0) {}
+
+  /**
+   * @brief Initialize Truck with its own random stream.
+   *
+   * This function will initialize the Truck ID, give the Truck a
+   * random stream derived from the simulation seed and its ID, and
+   * initialize class variables to default values.
+   *
+   * @param id Truck ID
+   * @param seed Master seed of the simulation
+   */
+  Truck(const int id, const std::uint64_t seed) : m_id(id), m_currentState(MINING), m_currentMiningTime(0), m_currentMinedHelium(0),
+                                                  m_currentTripQueueWait(0), m_totalMinedHelium(0), m_totalMiningTime(0),
+                                                  m_totalUnloadedTrips(0), m_isInDataQueue(false), m_totalQueueWait(0),
+                                                  m_miningStats(Site::kMinMiningMinutes, Site::kMaxMiningMinutes),
+                                                  m_isMiningHistoryKept(false), m_randomStream(seed, static_cast<std::uint64_t>(id)) {}
 
   /**
    * @brief Get Truck's ID
@@ -78,7 +97,7 @@ public:
    *
    * @return Truck's current mined helium
    */
-  int getCurrentMinedHelium() { return m_currentMinedHelium; }
+  int getCurrentMinedHelium() const { return m_currentMinedHelium; }
 
   /**
    * @brief Set Truck's current mined helium.
@@ -97,7 +116,7 @@ public:
    *
    * @return Truck's current wait time at a Station
    */
-  int getCurrentTripQueueWait() { return m_currentTripQueueWait; }
+  int getCurrentTripQueueWait() const { return m_currentTripQueueWait; }
 
   /**
    * @brief Set Truck's current wait time.
@@ -168,6 +187,16 @@ public:
    */
   void incrementTotalNumberUnloads() { m_totalUnloadedTrips++; }
 
+  /**
+   * @brief Set Truck's total successful unloads.
+   *
+   * This function will overwrite the total number of times a Truck
+   * has successfully unloaded at a Station.
+   *
+   * @param value Truck's total successful unloads
+   */
+  void setTotalNumberUnloads(const int value) { m_totalUnloadedTrips = value; }
+
   /**
    * @brief Get Truck's total waiting time.
    *
@@ -210,15 +239,75 @@ public:
    */
   void setIsInDataQueue(const bool flag) { m_isInDataQueue = flag; }
 
+  /**
+   * @brief Get Truck's random stream.
+   *
+   * This function will return the Truck's own random stream. No other
+   * Truck shares it, so Trucks can draw numbers concurrently and a run
+   * with the same seed replays the same numbers.
+   *
+   * @return Truck's random stream
+   */
+  RandomStream &getRandomStream() { return m_randomStream; }
+
   /**
    * @brief Save current mining duration.
    *
-   * This function will save the randomly generated mining duration
-   * to a vector to keep track of all the values produced.
+   * This function will add the randomly generated mining duration to
+   * the Truck's running statistics, which take the same memory however
+   * long the simulation runs. The duration itself is only kept when the
+   * full mining history is switched on.
    *
    * @param value Single mining duration of the Truck
    */
-  void saveMiningDuration(const int value) { m_miningDurations.push_back(value); }
+  void saveMiningDuration(const int value)
+  {
+    m_miningStats.add(value);
+    if (m_isMiningHistoryKept)
+    {
+      m_miningDurations.push_back(value);
+    }
+  }
+
+  /**
+   * @brief Get Truck's mining duration statistics.
+   *
+   * This function will return the count, mean, variance, min, max and
+   * histogram of every duration passed to saveMiningDuration().
+   *
+   * @return Truck's mining duration statistics
+   */
+  const RunningStats &getMiningStats() const { return m_miningStats; }
+
+  /**
+   * @brief Set Truck's mining duration statistics.
+   *
+   * This function will overwrite the Truck's statistics, e.g. when the
+   * Truck is copied out of a Fleet.
+   *
+   * @param stats Truck's mining duration statistics
+   */
+  void setMiningStats(const RunningStats &stats) { m_miningStats = stats; }
+
+  /**
+   * @brief Set if Truck keeps every mining duration.
+   *
+   * This function will switch on the full mining history for debugging.
+   * It is off by default, as the history grows with the simulated time.
+   *
+   * @param flag If every mining duration is kept
+   */
+  void setKeepMiningHistory(const bool flag) { m_isMiningHistoryKept = flag; }
+
+  /**
+   * @brief Get every mining duration of the Truck.
+   *
+   * This function will return the durations saved while the full mining
+   * history was switched on, in the order they were drawn.
+   *
+   * @return Truck's mining durations, empty unless the history is kept
+   */
+  const std::vector<int> &getMiningDurations() const { return m_miningDurations; }
 
   /**
    * @brief Calculate average waiting time.
@@ -265,7 +354,10 @@ private:
   int m_totalUnloadedTrips;           // Total number of unload trips
   int m_totalQueueWait;               // Total number of time truck spent waiting in the queue (eg., 1 count = 1 min)
   bool m_isInDataQueue;               // Let us know if this truck is in the shared data queue waiting to be processed by station
-  std::vector<int> m_miningDurations; // for statistic purposes
+  RunningStats m_miningStats;         // Running statistics of every mining duration
+  bool m_isMiningHistoryKept;         // Whether m_miningDurations is filled, for debugging
+  std::vector<int> m_miningDurations; // Every mining duration, only kept when m_isMiningHistoryKept is set
+  RandomStream m_randomStream;        // Truck's own reproducible random stream
 };
 
 #endif
\ No newline at end of file
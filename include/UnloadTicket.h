@@ -0,0 +1,101 @@
+#ifndef UNLOAD_TICKET_H
+#define UNLOAD_TICKET_H
+
+#include <atomic>
+#include <chrono>
+
+#include "Truck.h"
+
+class UnloadTicket
+{
+public:
+  /**
+   * @brief Initialize an unissued UnloadTicket.
+   *
+   * This function will initialize a ticket that is not yet attached
+   * to any Truck. Each Truck owns one ticket for the whole simulation
+   * and reissues it on every trip to a Station.
+   */
+  UnloadTicket() : m_truck(nullptr), m_queueWaitMins(0), m_isCompleted(false) {}
+
+  UnloadTicket(const UnloadTicket &) = delete;
+  UnloadTicket &operator=(const UnloadTicket &) = delete;
+
+  /**
+   * @brief Issue the ticket for a Truck joining the unload queue.
+   *
+   * This function will attach the Truck, timestamp its arrival at
+   * the queue and clear the completion flag. Must be called by the
+   * Truck thread before the ticket is pushed to the queue.
+   *
+   * @param truck Truck waiting to be unloaded
+   */
+  void issue(Truck &truck)
+  {
+    m_truck = &truck;
+    m_arrivalTime = std::chrono::steady_clock::now();
+    m_queueWaitMins = 0;
+    m_isCompleted.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the Truck the ticket was issued for.
+   *
+   * This function will return the Truck waiting to be unloaded.
+   *
+   * @return Truck waiting to be unloaded
+   */
+  Truck &getTruck() const { return *m_truck; }
+
+  /**
+   * @brief Get the time the Truck joined the unload queue.
+   *
+   * This function will return the timestamp taken when the ticket
+   * was issued.
+   *
+   * @return Arrival time at the unload queue
+   */
+  std::chrono::steady_clock::time_point getArrivalTime() const { return m_arrivalTime; }
+
+  /**
+   * @brief Get how long the Truck waited in the unload queue.
+   *
+   * This function will return the queue wait recorded by the Station
+   * when it completed the ticket.
+   *
+   * @return Queue wait in minutes
+   */
+  int getQueueWaitMins() const { return m_queueWaitMins; }
+
+  /**
+   * @brief Release the waiting Truck.
+   *
+   * This function will record the Truck's queue wait and wake the
+   * Truck thread blocked in waitForCompletion(). The Station must not
+   * touch the Truck after calling it.
+   *
+   * @param queueWaitMins Time the Truck waited in the queue in minutes
+   */
+  void complete(const int queueWaitMins)
+  {
+    m_queueWaitMins = queueWaitMins;
+    m_isCompleted.store(true, std::memory_order_release);
+    m_isCompleted.notify_one();
+  }
+
+  /**
+   * @brief Block until a Station completes the ticket.
+   *
+   * This function will put the Truck thread to sleep without using
+   * any CPU until complete() is called.
+   */
+  void waitForCompletion() const { m_isCompleted.wait(false, std::memory_order_acquire); }
+
+private:
+  Truck *m_truck;                                      // Truck waiting to be unloaded
+  std::chrono::steady_clock::time_point m_arrivalTime; // Time the Truck joined the unload queue
+  int m_queueWaitMins;                                 // Queue wait recorded by the Station
+  std::atomic<bool> m_isCompleted;                     // Set by the Station once the Truck has been unloaded
+};
+
+#endif
\ No newline at end of file
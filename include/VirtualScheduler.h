@@ -0,0 +1,145 @@
+#ifndef VIRTUAL_SCHEDULER_H
+#define VIRTUAL_SCHEDULER_H
+
+#include <coroutine>
+#include <exception>
+#include <queue>
+#include <vector>
+
+class SimTask
+{
+public:
+  struct promise_type
+  {
+    SimTask get_return_object() { return SimTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    std::suspend_always initial_suspend() noexcept { return {}; } // Actor only starts once it is spawned on a scheduler
+    std::suspend_never final_suspend() noexcept { return {}; }    // Frame frees itself when the actor returns
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  SimTask(SimTask &&other) noexcept : m_handle(other.m_handle) { other.m_handle = nullptr; }
+  SimTask(const SimTask &) = delete;
+  SimTask &operator=(const SimTask &) = delete;
+
+  /**
+   * @brief Destroy a task that was never spawned.
+   */
+  ~SimTask()
+  {
+    if (m_handle)
+    {
+      m_handle.destroy();
+    }
+  }
+
+  /**
+   * @brief Hand the coroutine frame over to the caller.
+   *
+   * This function will give up ownership of the not yet started
+   * coroutine. Once resumed, the frame frees itself when it returns.
+   *
+   * @return Handle of the suspended coroutine
+   */
+  std::coroutine_handle<> release()
+  {
+    std::coroutine_handle<> handle = m_handle;
+    m_handle = nullptr;
+    return handle;
+  }
+
+private:
+  explicit SimTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+  std::coroutine_handle<promise_type> m_handle; // Owned until spawned
+};
+
+class VirtualScheduler
+{
+public:
+  class DelayAwaiter
+  {
+  public:
+    DelayAwaiter(VirtualScheduler &scheduler, const int minutes) : m_scheduler(scheduler), m_minutes(minutes) {}
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { m_scheduler.schedule(handle, m_scheduler.now() + m_minutes); }
+    void await_resume() const noexcept {}
+
+  private:
+    VirtualScheduler &m_scheduler; // Scheduler owning the virtual clock
+    int m_minutes;                 // Delay in minutes
+  };
+
+  /**
+   * @brief Initialize scheduler with its virtual clock at 0.
+   */
+  VirtualScheduler() : m_now(0), m_sequence(0) {}
+
+  /**
+   * @brief Suspend the calling coroutine for a number of virtual minutes.
+   *
+   * This function will return an awaiter that resumes the coroutine
+   * once the virtual clock reaches now + minutes. Negative delays
+   * resume at the current time.
+   *
+   * @param minutes Delay in minutes
+   * @return Awaiter to co_await
+   */
+  DelayAwaiter delay(const int minutes) { return DelayAwaiter(*this, minutes > 0 ? minutes : 0); }
+
+  /**
+   * @brief Start a coroutine actor at the current virtual time.
+   *
+   * This function will take ownership of the task and resume it the
+   * next time the scheduler runs.
+   *
+   * @param task Not yet started actor
+   */
+  void spawn(SimTask task) { schedule(task.release(), m_now); }
+
+  /**
+   * @brief Resume a coroutine at a given virtual time.
+   *
+   * This function will queue the coroutine so it is resumed when the
+   * virtual clock reaches time. Coroutines due at the same time resume
+   * in the order they were scheduled.
+   *
+   * @param handle Suspended coroutine
+   * @param time Virtual time in minutes
+   */
+  void schedule(std::coroutine_handle<> handle, const int time);
+
+  /**
+   * @brief Run every actor until none is scheduled any more.
+   *
+   * This function will repeatedly advance the virtual clock to the
+   * earliest scheduled coroutine and resume it.
+   */
+  void run();
+
+  /**
+   * @brief Get current virtual time.
+   *
+   * @return Current virtual time in minutes
+   */
+  int now() const { return m_now; }
+
+private:
+  struct ScheduledCoroutine
+  {
+    int time;                       // Virtual time to resume at
+    long long sequence;             // Scheduling order for tie breaking
+    std::coroutine_handle<> handle; // Coroutine to resume
+
+    bool operator>(const ScheduledCoroutine &other) const
+    {
+      return (time != other.time) ? (time > other.time) : (sequence > other.sequence);
+    }
+  };
+
+  int m_now;                                                                                                          // Current virtual time in minutes
+  long long m_sequence;                                                                                               // Scheduling counter for tie breaking
+  std::priority_queue<ScheduledCoroutine, std::vector<ScheduledCoroutine>, std::greater<ScheduledCoroutine>> m_ready; // Coroutines ordered by resume time
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+public:
+  /**
+   * @brief Initialize pool and start its worker threads.
+   *
+   * This function will start numWorkers - 1 background threads. The
+   * thread calling parallelFor() is used as the remaining worker.
+   *
+   * @param numWorkers Number of threads sharing the work, defaults to
+   * the number of hardware threads
+   */
+  explicit WorkerPool(const int numWorkers = static_cast<int>(std::thread::hardware_concurrency()));
+
+  /**
+   * @brief Stop and join every worker thread.
+   */
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /**
+   * @brief Run body over [0, count) on all workers.
+   *
+   * This function will split the range into chunks, deal them out to
+   * the workers' deques and block until every chunk has run. A worker
+   * that runs out of chunks steals the oldest chunk of another worker.
+   *
+   * @param count Number of items to process
+   * @param body Called as body(first, last) for each chunk of items
+   * @param minParallelCount Below this many items the caller runs the
+   * body alone, lower it when every item is expensive
+   */
+  void parallelFor(const int count, const std::function<void(int, int)> &body, const int minParallelCount = kMinParallelCount);
+
+  /**
+   * @brief Get number of workers.
+   *
+   * This function will return the number of threads sharing the work,
+   * including the calling thread.
+   *
+   * @return Number of workers
+   */
+  int getNumWorkers() const { return m_numWorkers; }
+
+private:
+  static constexpr int kChunksPerWorker = 4;   // Chunks dealt to each worker so idle workers have something to steal
+  static constexpr int kMinParallelCount = 64; // Below this many items the caller runs the body alone
+
+  struct Chunk
+  {
+    int first; // First item of the chunk
+    int last;  // One past the last item of the chunk
+  };
+
+  struct WorkerDeque
+  {
+    std::mutex mutex;         // Protects chunks between the owner and thieves
+    std::deque<Chunk> chunks; // Owner pops from the back, thieves steal from the front
+  };
+
+  /**
+   * @brief Background worker loop.
+   *
+   * This function will sleep until parallelFor() publishes new chunks
+   * and then run chunks until none are left.
+   *
+   * @param index Worker index, also the index of its own deque
+   */
+  void workerLoop(const int index);
+
+  /**
+   * @brief Run one chunk, own chunks first, otherwise a stolen one.
+   *
+   * @param index Worker index
+   * @return False if no chunk was left anywhere
+   */
+  bool runOneChunk(const int index);
+
+  int m_numWorkers;                                    // Number of workers including the calling thread
+  std::vector<std::unique_ptr<WorkerDeque>> m_deques;  // One chunk deque per worker
+  std::vector<std::thread> m_threads;                  // Background workers 1..m_numWorkers - 1
+  const std::function<void(int, int)> *m_body;        // Body of the current parallelFor()
+  std::atomic<int> m_pendingChunks;                    // Chunks of the current parallelFor() not finished yet
+  std::atomic<unsigned> m_generation;                  // Bumped by every parallelFor() to wake the workers
+  std::atomic<bool> m_isStopping;                      // Set by the destructor
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef WORKLOAD_RECURSION_H
+#define WORKLOAD_RECURSION_H
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <cstdint>
+#include <vector>
+
+class WorkloadRecursion
+{
+public:
+  /**
+   * @brief Initialize the recursion with every Station idle.
+   *
+   * @param numStations Number of Stations serving the FIFO queue
+   * @param unloadTimeMins Unload time of every Truck
+   */
+  WorkloadRecursion(const int numStations, const int unloadTimeMins);
+
+  /**
+   * @brief Serve the next Truck of the FIFO queue.
+   *
+   * This function will apply one step of the Kiefer-Wolfowitz recursion:
+   * the Truck is picked up once it has arrived and the Station that frees
+   * up first is idle. Arrivals must come in non-decreasing time order.
+   * Pickups then never decrease either, so the busy part of the sorted
+   * workload vector is a ring that is released from the front and
+   * appended at the back, and each step is O(1) amortized. The Station
+   * is the lowest id idle at the pickup minute, the same choice as the
+   * FIXED_STEP dispatch loop, found in a two-level bitmask whose top
+   * level is scanned 256 (AVX2) or 128 (SSE2) bits at a time.
+   *
+   * @param arrivalTime Minute the Truck joined the queue
+   * @param stationId Receives the Station that unloads the Truck
+   * @return Minute the Truck is picked up
+   */
+  int serve(const int arrivalTime, int &stationId);
+
+  /**
+   * @brief Serve the next Truck and remember how to undo it.
+   *
+   * This function will serve like serve() and also log the previous
+   * pickup minute and every Station the step released, so the step can
+   * be taken back with undoLastServe(). The log grows by O(1) amortized
+   * per step until commitServes() forgets the oldest steps.
+   *
+   * @param arrivalTime Minute the Truck joined the queue
+   * @param stationId Receives the Station that unloads the Truck
+   * @return Minute the Truck is picked up
+   */
+  int serveReversibly(const int arrivalTime, int &stationId);
+
+  /**
+   * @brief Undo the newest logged serve.
+   *
+   * This function will free the Station the serve assigned and put the
+   * Stations it released back at the front of the busy ring, restoring
+   * the recursion exactly as it was before the serve. There must be a
+   * logged serve.
+   */
+  void undoLastServe();
+
+  /**
+   * @brief Forget the oldest logged serves.
+   *
+   * This function will drop the log of serves that can no longer be
+   * undone, so the log only holds serves that may still be rolled back.
+   *
+   * @param numServes Number of oldest logged serves to forget
+   */
+  void commitServes(const std::size_t numServes);
+
+  /**
+   * @brief Get number of serves that can still be undone.
+   *
+   * @return Number of logged serves
+   */
+  std::size_t getNumLoggedServes() const { return m_undoLog.size(); }
+
+  /**
+   * @brief Get the instruction set the Station search was compiled for.
+   *
+   * @return "AVX2", "SSE2" or "scalar"
+   */
+  static const char *getInstructionSet();
+
+private:
+  struct UndoRecord
+  {
+    int lastPickupTime; // m_lastPickupTime before the serve
+    int numReleased;    // Stations the serve moved from busy to idle, newest entries of m_releasedStations
+  };
+
+  /**
+   * @brief Serve the next Truck, logging the step if asked.
+   *
+   * @param arrivalTime Minute the Truck joined the queue
+   * @param stationId Receives the Station that unloads the Truck
+   * @param isLogged True to log the step for undoLastServe()
+   * @return Minute the Truck is picked up
+   */
+  int serve(const int arrivalTime, int &stationId, const bool isLogged);
+
+  /**
+   * @brief Mark a Station idle or busy in both bitmask levels.
+   *
+   * @param id Station id
+   * @param isIdle True to mark the Station idle
+   */
+  void setIdle(const int id, const bool isIdle);
+
+  /**
+   * @brief Find the lowest id idle Station.
+   *
+   * @return Station id, there must be an idle Station
+   */
+  int findIdleStation() const;
+
+  int m_unloadTimeMins;                              // Unload time of every Truck
+  std::vector<int> m_busyFreeTimes;                  // Free times of the busy Stations in ascending order, as a ring
+  std::vector<int> m_busyIds;                        // Station of each m_busyFreeTimes entry
+  std::size_t m_busyHead;                            // Ring position of the earliest free time
+  std::size_t m_numBusy;                             // Number of busy Stations
+  int m_lastPickupTime;                              // Pickup minute of the previous Truck
+  std::vector<std::uint64_t> m_idleWords;            // Bit per idle Station
+  std::vector<std::uint64_t> m_idleSummary;          // Bit per non-zero m_idleWords entry, padded to whole vectors
+  std::deque<UndoRecord> m_undoLog;                  // Logged serves, oldest first
+  std::deque<std::array<int, 2>> m_releasedStations; // Free time and id of every Station released by a logged serve, oldest first
+};
+
+#endif
\ No newline at end of file
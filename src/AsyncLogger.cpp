@@ -0,0 +1,200 @@
+#include <chrono>
+
+#include "../include/AsyncLogger.h"
+
+namespace
+{
+    constexpr std::chrono::milliseconds kDrainInterval(1); // Drain thread sleep when every ring is empty
+
+    std::atomic<unsigned long long> nextLoggerId(1); // Ids handed to loggers, 0 marks an empty cache
+
+    // Ring cache of the calling thread, valid only while loggerId matches the logger in use
+    struct ThreadRingCache
+    {
+        unsigned long long loggerId = 0;
+        void *ring = nullptr;
+    };
+    thread_local ThreadRingCache threadRingCache;
+
+    std::size_t roundUpToPowerOfTwo(const std::size_t value)
+    {
+        std::size_t result = 2;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+AsyncLogger::AsyncLogger(std::ostream &output, const std::size_t ringCapacity, const std::size_t maxRingCapacity)
+    : m_output(output), m_ringCapacity(roundUpToPowerOfTwo(ringCapacity)),
+      m_maxRingCapacity(std::max(m_ringCapacity, roundUpToPowerOfTwo(maxRingCapacity))), m_loggerId(nextLoggerId++),
+      m_ringsMutex("loggerRingsMutex"), m_numRings(0), m_droppedMessages(0), m_flushRequests(0), m_completedFlushes(0), m_isStopping(false)
+{
+    m_drainThread = std::thread([this]()
+                                { this->drainLoop(); });
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    m_isStopping = true;
+    m_drainThread.join();
+}
+
+void AsyncLogger::flush()
+{
+    const unsigned request = ++m_flushRequests;
+    unsigned completed = m_completedFlushes.load();
+    while (completed < request)
+    {
+        m_completedFlushes.wait(completed);
+        completed = m_completedFlushes.load();
+    }
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+AsyncLogger::LogRing &AsyncLogger::threadRing()
+{
+    if (threadRingCache.loggerId == m_loggerId)
+    {
+        return *static_cast<LogRing *>(threadRingCache.ring);
+    }
+    return registerThread();
+}
+
+AsyncLogger::LogRing &AsyncLogger::registerThread()
+{
+    std::lock_guard<ProfiledMutex> lock(m_ringsMutex);
+
+    // Reuse this thread's ring if it logged here before switching to another logger
+    LogRing *ring = nullptr;
+    for (auto &existingRing : m_rings)
+    {
+        if (existingRing->owner == std::this_thread::get_id())
+        {
+            ring = existingRing.get();
+        }
+    }
+    if (ring == nullptr)
+    {
+        m_rings.push_back(std::make_unique<LogRing>(m_ringCapacity, std::this_thread::get_id()));
+        ring = m_rings.back().get();
+        m_numRings.store(m_rings.size(), std::memory_order_release);
+    }
+    while (ring->grown != nullptr)
+    {
+        ring = ring->grown.get(); // Continue in the largest ring this thread grew to
+    }
+
+    threadRingCache.loggerId = m_loggerId;
+    threadRingCache.ring = ring;
+    return *ring;
+}
+
+AsyncLogger::LogRing &AsyncLogger::growRing(LogRing &fullRing)
+{
+    fullRing.grown = std::make_unique<LogRing>((fullRing.mask + 1) * 2, fullRing.owner);
+    LogRing *ring = fullRing.grown.get();
+    fullRing.next.store(ring, std::memory_order_release); // Every write to the full ring is published before this
+
+    threadRingCache.ring = ring;
+    return *ring;
+}
+
+void AsyncLogger::drainLoop()
+{
+    std::vector<LogRing *> rings;
+    std::string batch;
+    batch.reserve(kBatchBytes + kMaxMessageLength + 1);
+
+    while (true)
+    {
+        // Read the requests first so a flush is only completed after a pass that saw its messages
+        const bool isStopping = m_isStopping;
+        const unsigned flushRequest = m_flushRequests.load();
+
+        if (drainRings(rings, batch) > 0)
+        {
+            continue; // Keep draining while threads are busy logging
+        }
+
+        if (m_completedFlushes.load() < flushRequest || isStopping)
+        {
+            const std::size_t droppedMessages = m_droppedMessages.exchange(0, std::memory_order_relaxed);
+            if (droppedMessages > 0)
+            {
+                m_output << "AsyncLogger dropped " << droppedMessages << " debug messages because a thread's buffer was full." << '\n';
+            }
+            m_output.flush();
+            m_completedFlushes = flushRequest;
+            m_completedFlushes.notify_all();
+        }
+
+        if (isStopping)
+        {
+            return;
+        }
+        std::this_thread::sleep_for(kDrainInterval);
+    }
+}
+
+std::size_t AsyncLogger::drainRings(std::vector<LogRing *> &rings, std::string &batch)
+{
+    // Rings are only ever added, so the snapshot is stale exactly when the count changed
+    if (m_numRings.load(std::memory_order_acquire) != rings.size())
+    {
+        std::lock_guard<ProfiledMutex> lock(m_ringsMutex);
+        for (std::size_t i = rings.size(); i < m_rings.size(); ++i)
+        {
+            rings.push_back(m_rings[i].get());
+        }
+    }
+
+    std::size_t drainedMessages = 0;
+    for (LogRing *&ring : rings)
+    {
+        // Read the grown ring before draining, the owner stopped writing this one before publishing it
+        LogRing *grownRing = ring->next.load(std::memory_order_acquire);
+        drainedMessages += drainRing(*ring, batch);
+        while (grownRing != nullptr)
+        {
+            ring->records.reset(); // Drained for good, the owner never writes a full ring again
+            ring = grownRing;
+            grownRing = ring->next.load(std::memory_order_acquire);
+            drainedMessages += drainRing(*ring, batch);
+        }
+    }
+
+    if (!batch.empty())
+    {
+        m_output.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        batch.clear();
+    }
+    return drainedMessages;
+}
+
+std::size_t AsyncLogger::drainRing(LogRing &ring, std::string &batch)
+{
+    std::size_t head = ring.head.load(std::memory_order_relaxed);
+    const std::size_t tail = ring.tail.load(std::memory_order_acquire);
+    const std::size_t drainedMessages = tail - head;
+    for (; head != tail; ++head)
+    {
+        const LogRecord &record = ring.records[head & ring.mask];
+        batch.append(record.text, record.length);
+        batch.push_back('\n');
+        if (batch.size() >= kBatchBytes)
+        {
+            m_output.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            batch.clear();
+        }
+    }
+    ring.head.store(head, std::memory_order_release); // Hand the slots back to the owner
+    return drainedMessages;
+}
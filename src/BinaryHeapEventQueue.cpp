@@ -0,0 +1,21 @@
+#include <algorithm>
+#include <functional>
+
+#include "../include/BinaryHeapEventQueue.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+void BinaryHeapEventQueue::push(const Event &event)
+{
+    m_heap.push_back(event);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Event>());
+}
+
+Event BinaryHeapEventQueue::pop()
+{
+    std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Event>());
+    const Event event = m_heap.back();
+    m_heap.pop_back();
+    return event;
+}
\ No newline at end of file
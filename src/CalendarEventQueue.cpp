@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+
+#include "../include/CalendarEventQueue.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+CalendarEventQueue::CalendarEventQueue()
+    : m_buckets(kMinBuckets), m_bucketMask(kMinBuckets - 1), m_bucketWidth(1), m_currentBucket(0),
+      m_bucketTop(1), m_lastTime(0), m_size(0) {}
+
+void CalendarEventQueue::push(const Event &event)
+{
+    Bucket &bucket = m_buckets[(event.getTime() / m_bucketWidth) & m_bucketMask];
+    if (bucket.isEmpty() || !(event < bucket.events.back()))
+    {
+        bucket.events.push_back(event); // Usual case, new Events fire after the ones already in their bucket
+    }
+    else
+    {
+        bucket.events.insert(std::upper_bound(bucket.events.begin() + bucket.head, bucket.events.end(), event), event);
+    }
+
+    if (++m_size > 2 * m_buckets.size())
+    {
+        resize(m_buckets.size() * 2);
+    }
+}
+
+Event CalendarEventQueue::pop()
+{
+    // Walk one year of days from the current one
+    for (std::size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        Bucket &bucket = m_buckets[m_currentBucket];
+        if (!bucket.isEmpty() && bucket.events[bucket.head].getTime() < m_bucketTop)
+        {
+            return takeFirst(bucket);
+        }
+        m_currentBucket = (m_currentBucket + 1) & m_bucketMask;
+        m_bucketTop += m_bucketWidth;
+    }
+
+    // Nothing this year, jump straight to the earliest Event
+    Bucket *earliest = nullptr;
+    for (Bucket &bucket : m_buckets)
+    {
+        if (!bucket.isEmpty() && (earliest == nullptr || bucket.events[bucket.head] < earliest->events[earliest->head]))
+        {
+            earliest = &bucket;
+        }
+    }
+    const long long day = earliest->events[earliest->head].getTime() / m_bucketWidth;
+    m_currentBucket = static_cast<std::size_t>(earliest - m_buckets.data());
+    m_bucketTop = (day + 1) * m_bucketWidth;
+    return takeFirst(*earliest);
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+Event CalendarEventQueue::takeFirst(Bucket &bucket)
+{
+    const Event event = bucket.events[bucket.head++];
+    if (bucket.isEmpty())
+    {
+        bucket.events.clear();
+        bucket.head = 0;
+    }
+    else if (bucket.head > kWidthSampleSize && bucket.head * 2 > bucket.events.size())
+    {
+        // Drop popped Events once they are the larger part of the bucket
+        bucket.events.erase(bucket.events.begin(), bucket.events.begin() + bucket.head);
+        bucket.head = 0;
+    }
+    m_lastTime = event.getTime();
+
+    if (--m_size < m_buckets.size() / 2 && m_buckets.size() > kMinBuckets)
+    {
+        resize(m_buckets.size() / 2);
+    }
+    return event;
+}
+
+void CalendarEventQueue::resize(const std::size_t numBuckets)
+{
+    std::vector<Event> events;
+    events.reserve(m_size);
+    for (const Bucket &bucket : m_buckets)
+    {
+        events.insert(events.end(), bucket.events.begin() + bucket.head, bucket.events.end());
+    }
+    std::sort(events.begin(), events.end());
+
+    // Three times the mean gap of the earliest Events keeps a few Events per day
+    if (events.size() >= 2)
+    {
+        const std::size_t numSamples = std::min(kWidthSampleSize, events.size());
+        const double meanGap = static_cast<double>(events[numSamples - 1].getTime() - events[0].getTime()) / (numSamples - 1);
+        m_bucketWidth = std::max(1, static_cast<int>(std::lround(3.0 * meanGap)));
+    }
+
+    m_buckets.assign(numBuckets, Bucket());
+    m_bucketMask = numBuckets - 1;
+    for (const Event &event : events)
+    {
+        m_buckets[(event.getTime() / m_bucketWidth) & m_bucketMask].events.push_back(event);
+    }
+    m_currentBucket = (m_lastTime / m_bucketWidth) & m_bucketMask;
+    m_bucketTop = (static_cast<long long>(m_lastTime / m_bucketWidth) + 1) * m_bucketWidth;
+}
\ No newline at end of file
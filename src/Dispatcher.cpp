@@ -0,0 +1,148 @@
+#include <algorithm>
+
+#include "../include/Dispatcher.h"
+
+namespace
+{
+    class JoinShortestQueueDispatcher : public Dispatcher
+    {
+    public:
+        using Dispatcher::Dispatcher;
+
+    protected:
+        int selectStation(const int, RandomStream &) override
+        {
+            int bestStation = 0;
+            for (int station = 1; station < getNumStations(); ++station)
+            {
+                if (getNumTrucks(station) < getNumTrucks(bestStation))
+                {
+                    bestStation = station;
+                }
+            }
+            return bestStation;
+        }
+    };
+
+    class PowerOfTwoDispatcher : public Dispatcher
+    {
+    public:
+        using Dispatcher::Dispatcher;
+
+    protected:
+        int selectStation(const int, RandomStream &randomStream) override
+        {
+            if (getNumStations() == 1)
+            {
+                return 0;
+            }
+
+            // Second draw skips the first Station so the two choices are always distinct
+            const int first = randomStream.nextInRange(0, getNumStations() - 1);
+            int second = randomStream.nextInRange(0, getNumStations() - 2);
+            second += (second >= first) ? 1 : 0;
+            return (getNumTrucks(second) < getNumTrucks(first)) ? second : first;
+        }
+    };
+
+    class RoundRobinDispatcher : public Dispatcher
+    {
+    public:
+        using Dispatcher::Dispatcher;
+
+    protected:
+        int selectStation(const int, RandomStream &) override
+        {
+            return static_cast<int>(m_nextStation.fetch_add(1, std::memory_order_relaxed) % getNumStations());
+        }
+
+    private:
+        std::atomic<unsigned int> m_nextStation{0}; // Dispatches so far, the next Station in turn
+    };
+
+    class LeastExpectedWorkDispatcher : public Dispatcher
+    {
+    public:
+        using Dispatcher::Dispatcher;
+
+    protected:
+        int selectStation(const int now, RandomStream &) override
+        {
+            int bestStation = 0;
+            int bestWorkMins = getExpectedWorkMins(0, now);
+            for (int station = 1; station < getNumStations() && bestWorkMins > 0; ++station)
+            {
+                const int workMins = getExpectedWorkMins(station, now);
+                if (workMins < bestWorkMins)
+                {
+                    bestStation = station;
+                    bestWorkMins = workMins;
+                }
+            }
+            return bestStation;
+        }
+    };
+}
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+Dispatcher::Dispatcher(const int numStations, const int unloadTimeMins)
+    : m_loads(std::make_unique<StationLoad[]>(numStations)), m_numStations(numStations), m_unloadTimeMins(unloadTimeMins)
+{
+}
+
+std::unique_ptr<Dispatcher> Dispatcher::create(const Kind kind, const int numStations, const int unloadTimeMins)
+{
+    switch (kind)
+    {
+    case Kind::JOIN_SHORTEST_QUEUE:
+        return std::make_unique<JoinShortestQueueDispatcher>(numStations, unloadTimeMins);
+    case Kind::POWER_OF_TWO:
+        return std::make_unique<PowerOfTwoDispatcher>(numStations, unloadTimeMins);
+    case Kind::ROUND_ROBIN:
+        return std::make_unique<RoundRobinDispatcher>(numStations, unloadTimeMins);
+    case Kind::LEAST_EXPECTED_WORK:
+        return std::make_unique<LeastExpectedWorkDispatcher>(numStations, unloadTimeMins);
+    case Kind::SHARED_QUEUE:
+    default:
+        return nullptr;
+    }
+}
+
+const char *Dispatcher::getName(const Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::JOIN_SHORTEST_QUEUE:
+        return "join_shortest_queue";
+    case Kind::POWER_OF_TWO:
+        return "power_of_two";
+    case Kind::ROUND_ROBIN:
+        return "round_robin";
+    case Kind::LEAST_EXPECTED_WORK:
+        return "least_expected_work";
+    case Kind::SHARED_QUEUE:
+    default:
+        return "shared_queue";
+    }
+}
+
+int Dispatcher::dispatch(const int now, RandomStream &randomStream)
+{
+    const int stationId = selectStation(now, randomStream);
+    StationLoad &load = m_loads[stationId];
+    load.numTrucks.fetch_add(1, std::memory_order_relaxed);
+
+    // The Truck is unloaded once the Station has finished everything before it
+    int freeTime = load.freeTime.load(std::memory_order_relaxed);
+    while (!load.freeTime.compare_exchange_weak(freeTime, std::max(freeTime, now) + m_unloadTimeMins, std::memory_order_relaxed))
+    {
+    }
+    return stationId;
+}
+
+int Dispatcher::getExpectedWorkMins(const int stationId, const int now) const
+{
+    return std::max(m_loads[stationId].freeTime.load(std::memory_order_relaxed) - now, 0);
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "../include/EventQueue.h"
+#include "../include/BinaryHeapEventQueue.h"
+#include "../include/PairingHeapEventQueue.h"
+#include "../include/CalendarEventQueue.h"
+#include "../include/TimingWheelEventQueue.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+std::unique_ptr<EventQueue> EventQueue::create(const Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::PAIRING_HEAP:
+        return std::make_unique<PairingHeapEventQueue>();
+    case Kind::CALENDAR_QUEUE:
+        return std::make_unique<CalendarEventQueue>();
+    case Kind::TIMING_WHEEL:
+        return std::make_unique<TimingWheelEventQueue>();
+    case Kind::BINARY_HEAP:
+    default:
+        return std::make_unique<BinaryHeapEventQueue>();
+    }
+}
+
+const char *EventQueue::getName(const Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::PAIRING_HEAP:
+        return "pairing_heap";
+    case Kind::CALENDAR_QUEUE:
+        return "calendar_queue";
+    case Kind::TIMING_WHEEL:
+        return "timing_wheel";
+    case Kind::BINARY_HEAP:
+    default:
+        return "binary_heap";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../include/FixedStepKernel.h"
+
+namespace
+{
+    constexpr int kTravelStateBit = 1; // TRAVEL_TO_UNLOAD_STATION and TRAVEL_TO_MINING_SITE are the odd Truck::State values
+    constexpr int kStateMask = 3;      // Truck::State + 1 wraps from TRAVEL_TO_MINING_SITE back to MINING
+
+    constexpr int kPrefetchDistance = 8; // Due batches fetched ahead of the one being advanced
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Appends the index of every batch set in dueMask, lowest first
+    void appendDueBatches(unsigned dueMask, const int firstBatch, std::vector<int> &dueBatches)
+    {
+        while (dueMask != 0)
+        {
+            dueBatches.push_back(firstBatch + std::countr_zero(dueMask));
+            dueMask &= dueMask - 1;
+        }
+    }
+
+    // Appends the id of every lane set in rareMask, lowest lane first
+    void appendRareLanes(unsigned rareMask, const int firstId, std::vector<int> &rareTruckIds)
+    {
+        while (rareMask != 0)
+        {
+            rareTruckIds.push_back(firstId + std::countr_zero(rareMask));
+            rareMask &= rareMask - 1;
+        }
+    }
+#endif
+
+#if defined(__SSE2__) && !defined(__AVX2__)
+    // Advances 4 Trucks, SSE2 has no blend so lanes are selected with and/andnot/or
+    void advanceFourTrucks(int *states, int *nextEventTimes, const int id, const int now, const int travelTimeMins,
+                           std::vector<int> &rareTruckIds)
+    {
+        const __m128i travelBitVector = _mm_set1_epi32(kTravelStateBit);
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(nextEventTimes + id));
+        const __m128i due = _mm_cmpeq_epi32(next, _mm_set1_epi32(now));
+        const unsigned dueMask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(due)));
+        if (dueMask == 0)
+        {
+            return;
+        }
+
+        __m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i *>(states + id));
+        const __m128i isTravelling = _mm_cmpeq_epi32(_mm_and_si128(state, travelBitVector), travelBitVector);
+        const __m128i travelDone = _mm_and_si128(due, isTravelling);
+        const __m128i nextState = _mm_and_si128(_mm_add_epi32(state, travelBitVector), _mm_set1_epi32(kStateMask));
+        state = _mm_or_si128(_mm_and_si128(travelDone, nextState), _mm_andnot_si128(travelDone, state));
+        next = _mm_or_si128(_mm_and_si128(travelDone, _mm_set1_epi32(now + travelTimeMins)), _mm_andnot_si128(travelDone, next));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(states + id), state);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(nextEventTimes + id), next);
+
+        const unsigned travelMask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(travelDone)));
+        appendRareLanes(dueMask & ~travelMask, id, rareTruckIds);
+    }
+#endif
+}
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+FixedStepKernel::FixedStepKernel(int *states, int *nextEventTimes, const int numTrucks, const int travelTimeMins)
+    : m_states(states), m_nextEventTimes(nextEventTimes), m_numTrucks(numTrucks), m_travelTimeMins(travelTimeMins),
+      m_batchNextEventTimes((numTrucks + kBatchSize - 1) / kBatchSize)
+{
+    for (int batch = 0; batch < static_cast<int>(m_batchNextEventTimes.size()); ++batch)
+    {
+        m_batchNextEventTimes[batch] = calcBatchNextEventTime(batch, std::numeric_limits<int>::min());
+    }
+}
+
+void FixedStepKernel::advanceTravellingTrucks(const int now, std::vector<int> &rareTruckIds)
+{
+    const int numBatches = static_cast<int>(m_batchNextEventTimes.size());
+    int batch = 0;
+
+    // Most batches have no Truck due, so only their earliest next event time is read
+    m_dueBatches.clear();
+#if defined(__AVX2__)
+    const __m256i nextMinuteVector = _mm256_set1_epi32(now + 1);
+    for (; batch + 8 <= numBatches; batch += 8)
+    {
+        const __m256i batchTimes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_batchNextEventTimes.data() + batch));
+        const __m256i isDue = _mm256_cmpgt_epi32(nextMinuteVector, batchTimes);
+        appendDueBatches(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(isDue))), batch, m_dueBatches);
+    }
+#elif defined(__SSE2__)
+    const __m128i nextMinuteVector = _mm_set1_epi32(now + 1);
+    for (; batch + 4 <= numBatches; batch += 4)
+    {
+        const __m128i batchTimes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_batchNextEventTimes.data() + batch));
+        const __m128i isDue = _mm_cmplt_epi32(batchTimes, nextMinuteVector);
+        appendDueBatches(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(isDue))), batch, m_dueBatches);
+    }
+#endif
+    for (; batch < numBatches; ++batch)
+    {
+        if (m_batchNextEventTimes[batch] <= now)
+        {
+            m_dueBatches.push_back(batch);
+        }
+    }
+
+    // Due batches are scattered across the columns, so fetch a few ahead of the one being advanced
+    const int numDueBatches = static_cast<int>(m_dueBatches.size());
+    for (int i = 0; i < numDueBatches; ++i)
+    {
+        if (i + kPrefetchDistance < numDueBatches)
+        {
+            const int aheadId = m_dueBatches[i + kPrefetchDistance] * kBatchSize;
+            __builtin_prefetch(m_states + aheadId, 1);
+            __builtin_prefetch(m_nextEventTimes + aheadId, 1);
+        }
+        advanceBatch(m_dueBatches[i], now, rareTruckIds);
+    }
+}
+
+void FixedStepKernel::advanceTravellingTrucksScalar(int *states, int *nextEventTimes, const int first, const int last,
+                                                    const int now, const int travelTimeMins, std::vector<int> &rareTruckIds)
+{
+    for (int id = first; id < last; ++id)
+    {
+        if (nextEventTimes[id] != now)
+        {
+            continue;
+        }
+        if ((states[id] & kTravelStateBit) != 0)
+        {
+            states[id] = (states[id] + 1) & kStateMask;
+            nextEventTimes[id] = now + travelTimeMins;
+        }
+        else
+        {
+            rareTruckIds.push_back(id);
+        }
+    }
+}
+
+const char *FixedStepKernel::getInstructionSet()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+void FixedStepKernel::advanceBatch(const int batch, const int now, std::vector<int> &rareTruckIds)
+{
+    const int first = batch * kBatchSize;
+    const int last = std::min(first + kBatchSize, m_numTrucks);
+
+    if (last - first < kBatchSize)
+    {
+        advanceTravellingTrucksScalar(m_states, m_nextEventTimes, first, last, now, m_travelTimeMins, rareTruckIds); // Partial last batch
+    }
+    else
+    {
+#if defined(__AVX2__)
+        const __m256i travelBitVector = _mm256_set1_epi32(kTravelStateBit);
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_nextEventTimes + first));
+        __m256i state = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_states + first));
+        const __m256i due = _mm256_cmpeq_epi32(next, _mm256_set1_epi32(now));
+        const __m256i isTravelling = _mm256_cmpeq_epi32(_mm256_and_si256(state, travelBitVector), travelBitVector);
+        const __m256i travelDone = _mm256_and_si256(due, isTravelling);
+        const __m256i nextState = _mm256_and_si256(_mm256_add_epi32(state, travelBitVector), _mm256_set1_epi32(kStateMask));
+        state = _mm256_blendv_epi8(state, nextState, travelDone);
+        next = _mm256_blendv_epi8(next, _mm256_set1_epi32(now + m_travelTimeMins), travelDone);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(m_states + first), state);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(m_nextEventTimes + first), next);
+
+        const unsigned dueMask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(due)));
+        const unsigned travelMask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(travelDone)));
+        appendRareLanes(dueMask & ~travelMask, first, rareTruckIds);
+
+        // Horizontal minimum of the lanes that are no longer due
+        __m256i earliest = _mm256_blendv_epi8(next, _mm256_set1_epi32(std::numeric_limits<int>::max()), _mm256_cmpeq_epi32(next, _mm256_set1_epi32(now)));
+        earliest = _mm256_min_epi32(earliest, _mm256_permute2x128_si256(earliest, earliest, 1));
+        earliest = _mm256_min_epi32(earliest, _mm256_shuffle_epi32(earliest, 0x4E));
+        earliest = _mm256_min_epi32(earliest, _mm256_shuffle_epi32(earliest, 0xB1));
+        m_batchNextEventTimes[batch] = _mm256_cvtsi256_si32(earliest);
+        return;
+#elif defined(__SSE2__)
+        advanceFourTrucks(m_states, m_nextEventTimes, first, now, m_travelTimeMins, rareTruckIds);
+        advanceFourTrucks(m_states, m_nextEventTimes, first + 4, now, m_travelTimeMins, rareTruckIds);
+#else
+        advanceTravellingTrucksScalar(m_states, m_nextEventTimes, first, last, now, m_travelTimeMins, rareTruckIds);
+#endif
+    }
+
+    // Rare Trucks are left out until the caller reschedules them and calls refreshTruck()
+    m_batchNextEventTimes[batch] = calcBatchNextEventTime(batch, now);
+}
+
+int FixedStepKernel::calcBatchNextEventTime(const int batch, const int now) const
+{
+    const int first = batch * kBatchSize;
+    const int last = std::min(first + kBatchSize, m_numTrucks);
+    int earliest = std::numeric_limits<int>::max();
+    for (int id = first; id < last; ++id)
+    {
+        if (m_nextEventTimes[id] > now)
+        {
+            earliest = std::min(earliest, m_nextEventTimes[id]);
+        }
+    }
+    return earliest;
+}
\ No newline at end of file
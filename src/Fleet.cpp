@@ -0,0 +1,64 @@
+#include "../include/Fleet.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+Fleet::Fleet(const int numTrucks, const std::uint64_t seed)
+    : m_seed(seed), m_states(numTrucks, Truck::State::MINING), m_nextEventTimes(numTrucks, 0),
+      m_currentMiningTimes(numTrucks, 0), m_currentHelium(numTrucks, 0), m_currentTripQueueWaits(numTrucks, 0),
+      m_totalHelium(numTrucks, 0), m_totalMiningTimes(numTrucks, 0), m_totalQueueWaits(numTrucks, 0),
+      m_unloadCounts(numTrucks, 0),
+      m_miningStats(numTrucks, RunningStats(Site::kMinMiningMinutes, Site::kMaxMiningMinutes)), m_isInDataQueue(numTrucks, 0)
+{
+    m_randomStreams.reserve(numTrucks);
+    for (int i = 0; i < numTrucks; ++i)
+    {
+        m_randomStreams.emplace_back(seed, static_cast<std::uint64_t>(i)); // Same stream as Truck(i, seed)
+    }
+}
+
+Truck Fleet::toTruck(const int id) const
+{
+    Truck truck(id, m_seed);
+    truck.setCurrentState(static_cast<Truck::State>(m_states[id]));
+    truck.setCurrentMiningTime(m_currentMiningTimes[id]);
+    truck.setCurrentMinedHelium(m_currentHelium[id]);
+    truck.setCurrentTripQueueWait(m_currentTripQueueWaits[id]);
+    truck.setTotalMinedHelium(m_totalHelium[id]);
+    truck.setTotalMiningTime(m_totalMiningTimes[id]);
+    truck.setTotalQueueWait(m_totalQueueWaits[id]);
+    truck.setTotalNumberUnloads(m_unloadCounts[id]);
+    truck.setIsInDataQueue(m_isInDataQueue[id] != 0);
+    if (!m_miningHistories.empty())
+    {
+        truck.setKeepMiningHistory(true);
+        for (const int miningDuration : m_miningHistories[id])
+        {
+            truck.saveMiningDuration(miningDuration);
+        }
+    }
+    truck.setMiningStats(m_miningStats[id]); // Keeps the Fleet's histogram range
+    return truck;
+}
+
+void Fleet::setKeepMiningHistory(const bool flag)
+{
+    m_miningHistories.assign(flag ? m_states.size() : 0, std::vector<int>());
+}
+
+void Fleet::setMiningStatsRange(const int lowest, const int highest)
+{
+    m_miningStats.assign(m_states.size(), RunningStats(lowest, highest));
+}
+
+void Fleet::prefetch(const int id) const
+{
+    __builtin_prefetch(&m_currentMiningTimes[id], 1);
+    __builtin_prefetch(&m_currentHelium[id], 1);
+    __builtin_prefetch(&m_currentTripQueueWaits[id], 1);
+    __builtin_prefetch(&m_totalHelium[id], 1);
+    __builtin_prefetch(&m_totalMiningTimes[id], 1);
+    __builtin_prefetch(&m_miningStats[id], 1);
+    __builtin_prefetch(&m_isInDataQueue[id], 1);
+    __builtin_prefetch(&m_randomStreams[id], 1);
+}
\ No newline at end of file
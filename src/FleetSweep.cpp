@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "../include/FleetSweep.h"
+#include "../include/ReplicationRunner.h"
+#include "../include/WorkerPool.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+FleetSweep::FleetSweep(const Range &truckRange, const Range &stationRange)
+    : m_truckCounts(expandRange(truckRange)), m_stationCounts(expandRange(stationRange)),
+      m_numReplications(1),
+      m_masterSeed((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}()),
+      m_numWorkerThreads(static_cast<int>(std::thread::hardware_concurrency())),
+      m_kneeFraction(kDefaultKneeFraction)
+{
+}
+
+bool FleetSweep::run(std::string &error)
+{
+    const int numCells = static_cast<int>(m_truckCounts.size() * m_stationCounts.size());
+    m_cells.assign(numCells, {});
+
+    // Every cell shares one configuration, so the first that cannot run stops the sweep
+    std::atomic<bool> isFailed{false};
+    std::mutex errorMutex;
+
+    // Every cell runs its replications on its own worker, so the grid is the unit of parallelism
+    WorkerPool pool(m_numWorkerThreads);
+    pool.parallelFor(numCells, [this, &isFailed, &errorMutex, &error](const int first, const int last)
+                     {
+        for (int index = first; index < last && !isFailed.load(std::memory_order_relaxed); ++index)
+        {
+            Cell &cell = m_cells[index];
+            cell.numTrucks = m_truckCounts[index / m_stationCounts.size()];
+            cell.numStations = m_stationCounts[index % m_stationCounts.size()];
+
+            ReplicationRunner replications(cell.numTrucks, cell.numStations, m_numReplications);
+            replications.setMasterSeed(m_masterSeed);
+            replications.setConfig(m_config);
+            replications.setNumWorkerThreads(1);
+            std::string runError;
+            if (!replications.run(runError))
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!isFailed.exchange(true, std::memory_order_relaxed))
+                {
+                    error = runError;
+                }
+                return;
+            }
+
+            const double heliumPerStation = replications.getStatistic(ReplicationRunner::STATION_HELIUM_RECEIVED).mean;
+            const double unloadsPerStation = replications.getStatistic(ReplicationRunner::STATION_TRUCKS_UNLOADED).mean;
+            cell.totalHelium = heliumPerStation * cell.numStations;
+            cell.heliumPerStation = heliumPerStation;
+            cell.heliumPerTruck = cell.totalHelium / cell.numTrucks;
+            cell.queueWaitMins = replications.getStatistic(ReplicationRunner::TRUCK_QUEUE_WAIT).mean;
+            cell.truckEfficiency = 100.0 * cell.heliumPerTruck / Simulator::calcMaxHeliumPossible(m_config);
+            cell.stationBusy = 100.0 * unloadsPerStation * m_config.unloadTimeMins / m_config.horizonMins;
+        } }, 1);
+
+    if (isFailed.load(std::memory_order_relaxed))
+    {
+        m_cells.clear();
+        return false;
+    }
+    return true;
+}
+
+int FleetSweep::findKneeStations(const int numTrucks) const
+{
+    const auto truckIt = std::find(m_truckCounts.begin(), m_truckCounts.end(), numTrucks);
+    if (truckIt == m_truckCounts.end() || m_cells.empty())
+    {
+        return -1;
+    }
+
+    const std::size_t rowStart = (truckIt - m_truckCounts.begin()) * m_stationCounts.size();
+    for (std::size_t i = 0; i + 1 < m_stationCounts.size(); ++i)
+    {
+        const Cell &current = m_cells[rowStart + i];
+        const Cell &next = m_cells[rowStart + i + 1];
+
+        // Helium the next Station count adds for every Station added
+        const double marginalHelium = (next.totalHelium - current.totalHelium) / (next.numStations - current.numStations);
+        if (marginalHelium < m_kneeFraction * current.heliumPerStation)
+        {
+            return current.numStations;
+        }
+    }
+    return m_stationCounts.back(); // Still improving at the end of the grid
+}
+
+void FleetSweep::writeCsv(std::ostream &out) const
+{
+    out << "trucks,stations,total_helium,helium_per_station,helium_per_truck,"
+        << "queue_wait_mins,truck_efficiency_pct,station_busy_pct,max_helium_per_truck" << std::endl;
+    out << std::fixed << std::setprecision(2);
+    for (const Cell &cell : m_cells)
+    {
+        out << cell.numTrucks << ','
+            << cell.numStations << ','
+            << cell.totalHelium << ','
+            << cell.heliumPerStation << ','
+            << cell.heliumPerTruck << ','
+            << cell.queueWaitMins << ','
+            << cell.truckEfficiency << ','
+            << cell.stationBusy << ','
+            << Simulator::calcMaxHeliumPossible(m_config) << std::endl;
+    }
+}
+
+void FleetSweep::printKnees(std::ostream &out) const
+{
+    for (const int numTrucks : m_truckCounts)
+    {
+        out << "Trucks = " << numTrucks << ". Adding stations stops improving helium after "
+            << findKneeStations(numTrucks) << " stations" << std::endl;
+    }
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+std::vector<int> FleetSweep::expandRange(const Range &range)
+{
+    std::vector<int> values;
+    const int step = std::max(range.step, 1);
+    for (int value = std::max(range.first, 1); value <= range.last; value += step) // A fleet needs at least one Truck and Station
+    {
+        values.push_back(value);
+    }
+    return values;
+}
\ No newline at end of file
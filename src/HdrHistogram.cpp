@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "../include/HdrHistogram.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+void HdrHistogram::record(const std::uint64_t value)
+{
+    const int index = getIndex(value);
+    if (index >= static_cast<int>(m_counts.size()))
+    {
+        m_counts.resize(index + 1, 0);
+    }
+    ++m_counts[index];
+    ++m_count;
+    m_total += value;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+}
+
+void HdrHistogram::add(const HdrHistogram &other)
+{
+    if (other.m_counts.size() > m_counts.size())
+    {
+        m_counts.resize(other.m_counts.size(), 0);
+    }
+    for (std::size_t index = 0; index < other.m_counts.size(); ++index)
+    {
+        m_counts[index] += other.m_counts[index];
+    }
+    m_count += other.m_count;
+    m_total += other.m_total;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+void HdrHistogram::reset()
+{
+    m_counts.clear();
+    m_count = 0;
+    m_total = 0;
+    m_min = UINT64_MAX;
+    m_max = 0;
+}
+
+std::uint64_t HdrHistogram::getValueAtPercentile(const double percentile) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the value, at least the first one
+    const double share = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    const std::uint64_t rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(share * static_cast<double>(m_count))), 1);
+    std::uint64_t numBelow = 0;
+    for (std::size_t index = 0; index < m_counts.size(); ++index)
+    {
+        numBelow += m_counts[index];
+        if (numBelow >= rank)
+        {
+            return std::min(getHighestValue(static_cast<int>(index)), m_max);
+        }
+    }
+    return m_max;
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+int HdrHistogram::getIndex(const std::uint64_t value)
+{
+    // Below two powers of the sub-bucket count every value has its own bucket, above it
+    // each power of two is split into kSubBucketCount buckets by the bits after the leading one
+    if (value < 2 * kSubBucketCount)
+    {
+        return static_cast<int>(value);
+    }
+    const int shift = std::bit_width(value) - 1 - kSubBucketBits;
+    return shift * kSubBucketCount + static_cast<int>(value >> shift);
+}
+
+std::uint64_t HdrHistogram::getHighestValue(const int index)
+{
+    if (index < 2 * kSubBucketCount)
+    {
+        return static_cast<std::uint64_t>(index);
+    }
+    const int shift = index / kSubBucketCount - 1;
+    const std::uint64_t subBucket = static_cast<std::uint64_t>(index - shift * kSubBucketCount);
+    return ((subBucket + 1) << shift) - 1;
+}
\ No newline at end of file
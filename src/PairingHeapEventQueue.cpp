@@ -0,0 +1,77 @@
+#include "../include/PairingHeapEventQueue.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+void PairingHeapEventQueue::push(const Event &event)
+{
+    int node;
+    if (m_freeNodes.empty())
+    {
+        node = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(Node{event, kNoNode, kNoNode});
+    }
+    else
+    {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+        m_nodes[node] = Node{event, kNoNode, kNoNode};
+    }
+    m_root = meld(m_root, node);
+    ++m_size;
+}
+
+Event PairingHeapEventQueue::pop()
+{
+    const int root = m_root;
+    const Event event = m_nodes[root].event;
+
+    m_meldBuffer.clear();
+    for (int child = m_nodes[root].child; child != kNoNode;)
+    {
+        const int sibling = m_nodes[child].sibling;
+        m_nodes[child].sibling = kNoNode;
+        m_meldBuffer.push_back(child);
+        child = sibling;
+    }
+
+    // First pass pairs neighbours left to right, second pass melds the pairs right to left
+    std::size_t numPairs = 0;
+    for (std::size_t i = 0; i < m_meldBuffer.size(); i += 2)
+    {
+        const int second = (i + 1 < m_meldBuffer.size()) ? m_meldBuffer[i + 1] : kNoNode;
+        m_meldBuffer[numPairs++] = meld(m_meldBuffer[i], second);
+    }
+    int newRoot = kNoNode;
+    while (numPairs > 0)
+    {
+        newRoot = meld(m_meldBuffer[--numPairs], newRoot);
+    }
+
+    m_root = newRoot;
+    m_freeNodes.push_back(root);
+    --m_size;
+    return event;
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+int PairingHeapEventQueue::meld(const int first, const int second)
+{
+    if (first == kNoNode)
+    {
+        return second;
+    }
+    if (second == kNoNode)
+    {
+        return first;
+    }
+
+    // The later root becomes the first child of the earlier one
+    const int parent = (m_nodes[second].event > m_nodes[first].event) ? first : second;
+    const int child = (parent == first) ? second : first;
+    m_nodes[child].sibling = m_nodes[parent].child;
+    m_nodes[parent].child = child;
+    return parent;
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
+#include "../include/QueueingEstimator.h"
+#include "../include/Simulator.h"
+
+namespace
+{
+    constexpr int kBisectionSteps = 60;  // Halvings of the arrival rate interval, far below double precision
+    constexpr int kTimingRepeats = 1000; // Predictions timed together, one alone is below the clock resolution
+}
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+QueueingEstimator::Estimate QueueingEstimator::estimate(const int numTrucks, const int numStations) const
+{
+    const double serviceTime = m_config.unloadTimeMins;
+    const double meanMiningTime = (m_config.minMiningMins + m_config.maxMiningMins) / 2.0;
+    const double baseCycleTime = meanMiningTime + (m_config.travelTimeMins * 2) + serviceTime; // Cycle without waiting
+
+    // Finite source: the arrival rate is N / (cycle + wait) and the wait grows with the rate,
+    // so the fixed point lies between no arrivals and the lower of the no-wait and saturation rates
+    double lowRate = 0.0;
+    double highRate = std::min(numTrucks / baseCycleTime, numStations / serviceTime);
+    for (int i = 0; i < kBisectionSteps; ++i)
+    {
+        const double rate = (lowRate + highRate) / 2.0;
+        if (rate < numTrucks / (baseCycleTime + calcQueueWait(rate, numTrucks, numStations)))
+        {
+            lowRate = rate;
+        }
+        else
+        {
+            highRate = rate;
+        }
+    }
+
+    Estimate result;
+    result.arrivalRate = lowRate;
+    result.utilization = (result.arrivalRate * serviceTime) / numStations;
+    result.meanQueueWait = std::max(calcQueueWait(result.arrivalRate, numTrucks, numStations),
+                                    numTrucks / result.arrivalRate - baseCycleTime); // Saturated Stations hold the rest of the fleet
+    result.meanQueueLength = result.arrivalRate * result.meanQueueWait;           // Little's law
+    result.cycleTime = baseCycleTime + result.meanQueueWait;
+
+    // Trucks first arrive after mining and one trip, then once per cycle; on average half a cycle is left over
+    const double firstArrival = meanMiningTime + m_config.travelTimeMins;
+    result.unloadsPerTruck = std::max((m_config.horizonMins - firstArrival) / result.cycleTime + 0.5, 0.0);
+    return result;
+}
+
+QueueingEstimator::Validation QueueingEstimator::validate(const int numTrucks, const int numStations, const std::uint64_t seed,
+                                                          const int numReplications) const
+{
+    using Clock = std::chrono::steady_clock;
+    Validation validation{};
+
+    const auto estimateStart = Clock::now();
+    for (int i = 0; i < kTimingRepeats; ++i)
+    {
+        validation.estimate = estimate(numTrucks, numStations);
+    }
+    const std::chrono::duration<double, std::micro> estimateTime = Clock::now() - estimateStart;
+    validation.estimateMicros = estimateTime.count() / kTimingRepeats;
+
+    const auto simulationStart = Clock::now();
+    for (int replication = 0; replication < numReplications; ++replication)
+    {
+        Simulator miningSim(numTrucks, numStations, Simulator::EngineMode::EVENT_DRIVEN);
+        miningSim.setConfig(m_config);
+        miningSim.setSeed(seed + static_cast<std::uint64_t>(replication));
+        miningSim.setWriteSummary(false);
+        miningSim.startSimulator();
+
+        long long totalUnloads = 0;
+        long long totalQueueWait = 0;
+        for (const Truck &truck : miningSim.getTruckView())
+        {
+            totalUnloads += truck.getTotalNumberUnloads();
+            totalQueueWait += truck.getTotalQueueWait();
+        }
+        validation.simulatedUtilization += static_cast<double>(totalUnloads) * m_config.unloadTimeMins / (static_cast<double>(numStations) * m_config.horizonMins);
+        validation.simulatedQueueWait += (totalUnloads > 0) ? static_cast<double>(totalQueueWait) / totalUnloads : 0.0;
+        validation.simulatedUnloadsPerTruck += static_cast<double>(totalUnloads) / numTrucks;
+    }
+    const std::chrono::duration<double, std::milli> simulationTime = Clock::now() - simulationStart;
+    validation.simulationMillis = simulationTime.count();
+
+    validation.simulatedUtilization /= numReplications;
+    validation.simulatedQueueWait /= numReplications;
+    validation.simulatedUnloadsPerTruck /= numReplications;
+    validation.utilizationError = validation.estimate.utilization - validation.simulatedUtilization;
+    validation.queueWaitError = validation.estimate.meanQueueWait - validation.simulatedQueueWait;
+    validation.unloadsError = validation.estimate.unloadsPerTruck - validation.simulatedUnloadsPerTruck;
+    return validation;
+}
+
+void QueueingEstimator::writeCsvHeader(std::ostream &out, const bool isValidated)
+{
+    if (isValidated)
+    {
+        out << "trucks,stations,utilization,simulated_utilization,utilization_error,"
+            << "queue_wait_mins,simulated_queue_wait_mins,queue_wait_error_mins,"
+            << "unloads_per_truck,simulated_unloads_per_truck,unloads_error,estimate_us,simulation_ms" << std::endl;
+    }
+    else
+    {
+        out << "trucks,stations,arrival_rate_per_min,utilization,queue_wait_mins,queue_length,cycle_mins,unloads_per_truck" << std::endl;
+    }
+}
+
+void QueueingEstimator::writeCsvRow(std::ostream &out, const int numTrucks, const int numStations, const Estimate &estimate)
+{
+    out << numTrucks << ',' << numStations << ',' << std::fixed << std::setprecision(4)
+        << estimate.arrivalRate << ','
+        << estimate.utilization << ','
+        << estimate.meanQueueWait << ','
+        << estimate.meanQueueLength << ','
+        << estimate.cycleTime << ','
+        << estimate.unloadsPerTruck << std::endl;
+}
+
+void QueueingEstimator::writeCsvRow(std::ostream &out, const int numTrucks, const int numStations, const Validation &validation)
+{
+    out << numTrucks << ',' << numStations << ',' << std::fixed << std::setprecision(4)
+        << validation.estimate.utilization << ','
+        << validation.simulatedUtilization << ','
+        << validation.utilizationError << ','
+        << validation.estimate.meanQueueWait << ','
+        << validation.simulatedQueueWait << ','
+        << validation.queueWaitError << ','
+        << validation.estimate.unloadsPerTruck << ','
+        << validation.simulatedUnloadsPerTruck << ','
+        << validation.unloadsError << ','
+        << validation.estimateMicros << ','
+        << validation.simulationMillis << std::endl;
+}
+
+double QueueingEstimator::calcErlangC(const double offeredLoad, const int numServers)
+{
+    const double utilization = offeredLoad / numServers;
+    if (utilization >= 1.0)
+    {
+        return 1.0;
+    }
+
+    // Erlang B by its stable recursion, then converted to Erlang C
+    double erlangB = 1.0;
+    for (int k = 1; k <= numServers; ++k)
+    {
+        erlangB = (offeredLoad * erlangB) / (k + offeredLoad * erlangB);
+    }
+    return erlangB / (1.0 - utilization * (1.0 - erlangB));
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+double QueueingEstimator::calcQueueWait(const double arrivalRate, const int numTrucks, const int numStations) const
+{
+    const double serviceTime = m_config.unloadTimeMins;
+    const double utilization = (arrivalRate * serviceTime) / numStations;
+    if (utilization >= 1.0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (arrivalRate <= 0.0)
+    {
+        return 0.0;
+    }
+
+    // M/M/c wait from Erlang C
+    const double erlangC = calcErlangC(arrivalRate * serviceTime, numStations);
+    const double markovianWait = (erlangC * serviceTime) / (numStations * (1.0 - utilization));
+
+    // Each Truck arrives once per cycle, which only varies with the uniform mining duration
+    const double miningRange = m_config.maxMiningMins - m_config.minMiningMins + 1.0;
+    const double miningVariance = (miningRange * miningRange - 1.0) / 12.0;
+    const double truckCycleTime = numTrucks / arrivalRate;
+    const double truckArrivalScv = miningVariance / (truckCycleTime * truckCycleTime);
+
+    // QNA superposition of the Trucks' arrivals, close to Poisson for large fleets or light load
+    const double weight = 1.0 / (1.0 + 4.0 * (1.0 - utilization) * (1.0 - utilization) * (numTrucks - 1));
+    const double arrivalScv = weight * truckArrivalScv + (1.0 - weight);
+    const double serviceScv = 0.0; // Unloading always takes unloadTimeMins
+
+    return markovianWait * (arrivalScv + serviceScv) / 2.0;
+}
\ No newline at end of file
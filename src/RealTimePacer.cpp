@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <thread>
+
+#include "../include/RealTimePacer.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+void RealTimePacer::start()
+{
+    m_numWakeUps = 0;
+    m_totalDriftNs = 0;
+    m_maxDriftNs = 0;
+    m_startTime = Clock::now();
+}
+
+void RealTimePacer::sleepUntil(const Clock::time_point deadline)
+{
+    // Wake early by the usual OS latency, so the deadline is met instead of overslept
+    const std::chrono::nanoseconds wakeUpLatency(m_wakeUpLatencyNs.load(std::memory_order_relaxed));
+    const Clock::time_point wakeUpTime = deadline - wakeUpLatency;
+    if (wakeUpTime > Clock::now())
+    {
+        std::this_thread::sleep_until(wakeUpTime);
+
+        // Threads race on the average, which only blurs it
+        const long long latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - wakeUpTime).count();
+        const long long maxLatencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(kMaxWakeUpCompensation).count();
+        const long long averageNs = m_wakeUpLatencyNs.load(std::memory_order_relaxed);
+        m_wakeUpLatencyNs.store(std::min(averageNs + (latencyNs - averageNs) / 8, maxLatencyNs), std::memory_order_relaxed);
+    }
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+
+    const long long driftNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - deadline).count();
+    m_numWakeUps.fetch_add(1, std::memory_order_relaxed);
+    m_totalDriftNs.fetch_add(driftNs, std::memory_order_relaxed);
+    long long maxDriftNs = m_maxDriftNs.load(std::memory_order_relaxed);
+    while (driftNs > maxDriftNs && !m_maxDriftNs.compare_exchange_weak(maxDriftNs, driftNs, std::memory_order_relaxed))
+    {
+        // maxDriftNs now holds the other thread's value, retry while ours is still larger
+    }
+}
+
+RealTimePacer::DriftReport RealTimePacer::getDriftReport() const
+{
+    const long long numWakeUps = m_numWakeUps.load();
+    DriftReport report;
+    report.numWakeUps = numWakeUps;
+    report.meanDrift = std::chrono::nanoseconds((numWakeUps > 0) ? m_totalDriftNs.load() / numWakeUps : 0);
+    report.maxDrift = std::chrono::nanoseconds(m_maxDriftNs.load());
+    report.wakeUpLatency = std::chrono::nanoseconds(m_wakeUpLatencyNs.load());
+    return report;
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <span>
+#include <thread>
+
+#include "../include/ReplicationRunner.h"
+#include "../include/RandomStream.h"
+#include "../include/WorkerPool.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+ReplicationRunner::ReplicationRunner(const int numTrucks, const int numStations, const int numReplications,
+                                     const Simulator::EngineMode engineMode)
+    : m_numTrucks(numTrucks), m_numStations(numStations), m_numReplications(numReplications),
+      m_engineMode(engineMode == Simulator::EngineMode::THREADED ? Simulator::EngineMode::EVENT_DRIVEN : engineMode),
+      m_numWorkerThreads(static_cast<int>(std::thread::hardware_concurrency())),
+      m_dispatchKind(Dispatcher::Kind::SHARED_QUEUE),
+      m_masterSeed((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}())
+{
+}
+
+bool ReplicationRunner::setDispatchPolicy(const Dispatcher::Kind dispatchKind, std::string &error)
+{
+    if (!Simulator::validateDispatchPolicy(m_engineMode, dispatchKind, error))
+    {
+        return false;
+    }
+    m_dispatchKind = dispatchKind;
+    return true;
+}
+
+std::uint64_t ReplicationRunner::getReplicationSeed(const int replication) const
+{
+    RandomStream seedStream(m_masterSeed, static_cast<std::uint64_t>(replication));
+    return seedStream.next();
+}
+
+bool ReplicationRunner::run(std::string &error)
+{
+    m_samples.assign(m_numReplications, {});
+
+    // Every replication shares one setup, so the first that cannot start stops the whole study
+    std::atomic<bool> isFailed{false};
+    std::mutex errorMutex;
+
+    // Every replication is an independent Simulator writing only its own slot of m_samples
+    WorkerPool pool(m_numWorkerThreads);
+    pool.parallelFor(m_numReplications, [this, &isFailed, &errorMutex, &error](const int first, const int last)
+                     {
+        for (int replication = first; replication < last && !isFailed.load(std::memory_order_relaxed); ++replication)
+        {
+            Simulator miningSim(m_numTrucks, m_numStations, m_engineMode);
+            miningSim.setSeed(getReplicationSeed(replication));
+            miningSim.setConfig(m_config);
+            miningSim.setDispatchPolicy(m_dispatchKind);
+            miningSim.setWriteSummary(false);
+            miningSim.setNumWorkerThreads(1); // Parallelism comes from running replications side by side
+            std::string startError;
+            if (!miningSim.startSimulator(startError))
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!isFailed.exchange(true, std::memory_order_relaxed))
+                {
+                    error = startError;
+                }
+                return;
+            }
+
+            std::array<double, kNumMetrics> &sample = m_samples[replication];
+            sample.fill(0.0);
+            const SimulationResults results = miningSim.takeResults();
+            const std::span<const Truck> trucks = results.getTrucks();
+            for (const Truck &truck : trucks)
+            {
+                const double averageQueueTime = truck.calculateAverageQueueTime(truck.getTotalQueueWait(), m_config.horizonMins);
+                const double truckEfficiency = static_cast<double>(truck.getTotalMinedHelium()) / static_cast<double>(Simulator::calcMaxHeliumPossible(m_config));
+                sample[TRUCK_HELIUM_MINED] += truck.getTotalMinedHelium();
+                sample[TRUCK_MINING_DURATION] += truck.getTotalMiningTime();
+                sample[TRUCK_UNLOADED_TRIPS] += truck.getTotalNumberUnloads();
+                sample[TRUCK_QUEUE_WAIT] += truck.getTotalQueueWait();
+                sample[TRUCK_AVERAGE_QUEUE_TIME] += truck.convertToPercent(averageQueueTime);
+                sample[TRUCK_EFFICIENCY] += truck.convertToPercent(truckEfficiency);
+            }
+            for (int metric = TRUCK_HELIUM_MINED; metric <= TRUCK_EFFICIENCY; ++metric)
+            {
+                sample[metric] /= std::max<std::size_t>(trucks.size(), 1);
+            }
+
+            const std::span<const Station> stations = results.getStations();
+            for (const Station &station : stations)
+            {
+                sample[STATION_HELIUM_RECEIVED] += station.getTotalHeliumReceived();
+                sample[STATION_TRUCKS_UNLOADED] += station.getTotalTrucksUnloaded();
+            }
+            for (int metric = STATION_HELIUM_RECEIVED; metric <= STATION_TRUCKS_UNLOADED; ++metric)
+            {
+                sample[metric] /= std::max<std::size_t>(stations.size(), 1);
+            }
+        } }, 1);
+
+    // A partial study would bias every Statistic, so none of its samples are kept
+    if (isFailed.load(std::memory_order_relaxed))
+    {
+        m_samples.clear();
+        return false;
+    }
+    return true;
+}
+
+std::vector<double> ReplicationRunner::getSamples(const Metric metric) const
+{
+    std::vector<double> samples;
+    samples.reserve(m_samples.size());
+    for (const std::array<double, kNumMetrics> &sample : m_samples)
+    {
+        samples.push_back(sample[metric]);
+    }
+    return samples;
+}
+
+void ReplicationRunner::printResults(std::ostream &out) const
+{
+    out << "Monte Carlo replications! Number of trucks = " << m_numTrucks
+        << ". Number of stations = " << m_numStations
+        << ". Replications = " << m_samples.size()
+        << ". Master seed = " << m_masterSeed << std::endl
+        << std::endl;
+
+    for (int metric = 0; metric < kNumMetrics; ++metric)
+    {
+        const Statistic statistic = getStatistic(static_cast<Metric>(metric));
+        out << std::left << std::setw(41) << getMetricName(static_cast<Metric>(metric)) << std::right << "= "
+            << std::fixed << std::setprecision(2) << statistic.mean
+            << " (std dev " << statistic.stddev
+            << ", 95% CI " << statistic.mean - statistic.confidenceHalfWidth
+            << " to " << statistic.mean + statistic.confidenceHalfWidth << ")" << std::endl;
+    }
+}
+
+const char *ReplicationRunner::getMetricName(const Metric metric)
+{
+    switch (metric)
+    {
+    case TRUCK_HELIUM_MINED:
+        return "Truck Total Helium Mined";
+    case TRUCK_MINING_DURATION:
+        return "Truck Total Mining Duration";
+    case TRUCK_UNLOADED_TRIPS:
+        return "Truck Total Successful Unloaded Trips";
+    case TRUCK_QUEUE_WAIT:
+        return "Truck Total Time Spent Waiting in Queue";
+    case TRUCK_AVERAGE_QUEUE_TIME:
+        return "Truck Average Time Spent Waiting (%)";
+    case TRUCK_EFFICIENCY:
+        return "Truck Efficiency (%)";
+    case STATION_HELIUM_RECEIVED:
+        return "Station Total Helium Received";
+    case STATION_TRUCKS_UNLOADED:
+        return "Station Total Trucks Unloaded";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+ReplicationRunner::Statistic ReplicationRunner::summarize(const std::vector<double> &samples)
+{
+    Statistic statistic{0.0, 0.0, 0.0};
+    if (samples.empty())
+    {
+        return statistic;
+    }
+
+    for (const double sample : samples)
+    {
+        statistic.mean += sample;
+    }
+    statistic.mean /= samples.size();
+
+    if (samples.size() > 1)
+    {
+        double sumSquares = 0.0;
+        for (const double sample : samples)
+        {
+            sumSquares += (sample - statistic.mean) * (sample - statistic.mean);
+        }
+        const int degreesOfFreedom = static_cast<int>(samples.size()) - 1;
+        statistic.stddev = std::sqrt(sumSquares / degreesOfFreedom);
+        statistic.confidenceHalfWidth = calcStudentTCritical(degreesOfFreedom) * statistic.stddev / std::sqrt(static_cast<double>(samples.size()));
+    }
+    return statistic;
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+double ReplicationRunner::calcStudentTCritical(const int degreesOfFreedom)
+{
+    // Exact two-sided 95% values up to 30 degrees of freedom
+    static constexpr double kCriticalValues[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                                 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                                 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (degreesOfFreedom <= 0)
+    {
+        return 0.0;
+    }
+    if (degreesOfFreedom <= 30)
+    {
+        return kCriticalValues[degreesOfFreedom - 1];
+    }
+    return 1.960 + 2.4 / degreesOfFreedom; // Within 0.003 of the exact value beyond 30
+}
\ No newline at end of file
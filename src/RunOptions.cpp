@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../include/RunOptions.h"
+
+namespace
+{
+    // Parse a whole string as an integer, rejecting trailing characters
+    template <typename IntType>
+    bool parseInteger(const std::string &text, IntType &value)
+    {
+        std::istringstream stream(text);
+        IntType parsed;
+        char extra = 0;
+        if (text.empty() || (std::is_unsigned_v<IntType> && text[0] == '-') || !(stream >> parsed) || stream >> extra)
+        {
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
+
+    std::string trim(const std::string &text)
+    {
+        const std::size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos)
+        {
+            return "";
+        }
+        const std::size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    std::string toLower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+}
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+bool RunOptions::setOption(const std::string &key, const std::string &value, std::string &error)
+{
+    // Integer options, checked for range by the caller or SimulationConfig::validate()
+    int *intOption = nullptr;
+    if (key == "trucks")
+    {
+        intOption = &numTrucks;
+    }
+    else if (key == "stations")
+    {
+        intOption = &numStations;
+    }
+    else if (key == "horizon_mins")
+    {
+        intOption = &config.horizonMins;
+    }
+    else if (key == "travel_time_mins")
+    {
+        intOption = &config.travelTimeMins;
+    }
+    else if (key == "unload_time_mins")
+    {
+        intOption = &config.unloadTimeMins;
+    }
+    else if (key == "helium_per_min")
+    {
+        intOption = &config.heliumPerMin;
+    }
+    else if (key == "min_mining_mins")
+    {
+        intOption = &config.minMiningMins;
+    }
+    else if (key == "max_mining_mins")
+    {
+        intOption = &config.maxMiningMins;
+    }
+
+    if (intOption != nullptr)
+    {
+        if (!parseInteger(value, *intOption))
+        {
+            error = "Option " + key + " needs an integer, got \"" + value + "\".";
+            return false;
+        }
+        if ((key == "trucks" || key == "stations") && *intOption <= 0)
+        {
+            error = "Option " + key + " must be positive.";
+            return false;
+        }
+        return true;
+    }
+
+    if (key == "seed")
+    {
+        if (!parseInteger(value, seed))
+        {
+            error = "Option seed needs an unsigned integer, got \"" + value + "\".";
+            return false;
+        }
+        hasSeed = true;
+    }
+    else if (key == "engine")
+    {
+        const std::string engine = toLower(value);
+        if (engine == "threaded")
+        {
+            engineMode = Simulator::EngineMode::THREADED;
+        }
+        else if (engine == "event_driven")
+        {
+            engineMode = Simulator::EngineMode::EVENT_DRIVEN;
+        }
+        else if (engine == "worker_pool")
+        {
+            engineMode = Simulator::EngineMode::WORKER_POOL;
+        }
+        else if (engine == "coroutine")
+        {
+            engineMode = Simulator::EngineMode::COROUTINE;
+        }
+        else if (engine == "fixed_step")
+        {
+            engineMode = Simulator::EngineMode::FIXED_STEP;
+        }
+        else if (engine == "arrival_stream")
+        {
+            engineMode = Simulator::EngineMode::ARRIVAL_STREAM;
+        }
+        else if (engine == "conservative")
+        {
+            engineMode = Simulator::EngineMode::CONSERVATIVE;
+        }
+        else if (engine == "optimistic")
+        {
+            engineMode = Simulator::EngineMode::OPTIMISTIC;
+        }
+        else
+        {
+            error = "Unknown engine \"" + value + "\".";
+            return false;
+        }
+    }
+    else if (key == "event_queue")
+    {
+        const std::string eventQueue = toLower(value);
+        if (eventQueue == "binary_heap")
+        {
+            eventQueueKind = EventQueue::Kind::BINARY_HEAP;
+        }
+        else if (eventQueue == "pairing_heap")
+        {
+            eventQueueKind = EventQueue::Kind::PAIRING_HEAP;
+        }
+        else if (eventQueue == "calendar_queue")
+        {
+            eventQueueKind = EventQueue::Kind::CALENDAR_QUEUE;
+        }
+        else if (eventQueue == "timing_wheel")
+        {
+            eventQueueKind = EventQueue::Kind::TIMING_WHEEL;
+        }
+        else
+        {
+            error = "Unknown event queue \"" + value + "\".";
+            return false;
+        }
+    }
+    else if (key == "dispatch")
+    {
+        const std::string dispatch = toLower(value);
+        if (dispatch == "shared_queue")
+        {
+            dispatchKind = Dispatcher::Kind::SHARED_QUEUE;
+        }
+        else if (dispatch == "join_shortest_queue")
+        {
+            dispatchKind = Dispatcher::Kind::JOIN_SHORTEST_QUEUE;
+        }
+        else if (dispatch == "power_of_two")
+        {
+            dispatchKind = Dispatcher::Kind::POWER_OF_TWO;
+        }
+        else if (dispatch == "round_robin")
+        {
+            dispatchKind = Dispatcher::Kind::ROUND_ROBIN;
+        }
+        else if (dispatch == "least_expected_work")
+        {
+            dispatchKind = Dispatcher::Kind::LEAST_EXPECTED_WORK;
+        }
+        else
+        {
+            error = "Unknown dispatch policy \"" + value + "\".";
+            return false;
+        }
+    }
+    else if (key == "format")
+    {
+        const std::string format = toLower(value);
+        if (format == "text")
+        {
+            outputFormat = OutputFormat::TEXT;
+        }
+        else if (format == "csv")
+        {
+            outputFormat = OutputFormat::CSV;
+        }
+        else if (format == "json")
+        {
+            outputFormat = OutputFormat::JSON;
+        }
+        else
+        {
+            error = "Unknown output format \"" + value + "\".";
+            return false;
+        }
+    }
+    else if (key == "output")
+    {
+        outputPath = value;
+    }
+    else if (key == "trace")
+    {
+        tracePath = value;
+    }
+    else
+    {
+        error = "Unknown option \"" + key + "\".";
+        return false;
+    }
+    return true;
+}
+
+bool RunOptions::loadConfigFile(const std::string &path, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        error = "Cannot open config file " + path + ".";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';' || line[0] == '[')
+        {
+            continue;
+        }
+
+        const std::size_t separator = line.find('=');
+        if (separator == std::string::npos)
+        {
+            error = path + ":" + std::to_string(lineNumber) + ": expected key = value.";
+            return false;
+        }
+        if (!setOption(toLower(trim(line.substr(0, separator))), trim(line.substr(separator + 1)), error))
+        {
+            error = path + ":" + std::to_string(lineNumber) + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RunOptions::parseArguments(int argc, const char *const argv[], std::string &error)
+{
+    // Split every "--key value" or "--key=value" flag, keeping the order given
+    std::vector<std::pair<std::string, std::string>> flags;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument.rfind("--", 0) != 0)
+        {
+            error = "Unexpected argument \"" + argument + "\".";
+            return false;
+        }
+
+        std::string key = argument.substr(2);
+        std::string value;
+        const std::size_t separator = key.find('=');
+        if (separator != std::string::npos)
+        {
+            value = key.substr(separator + 1);
+            key.erase(separator);
+        }
+        std::replace(key.begin(), key.end(), '-', '_');
+
+        if (key == "help")
+        {
+            isHelpRequested = true;
+            continue;
+        }
+        if (separator == std::string::npos)
+        {
+            if (i + 1 >= argc)
+            {
+                error = "Option --" + key + " needs a value.";
+                return false;
+            }
+            value = argv[++i];
+        }
+        flags.emplace_back(key, value);
+    }
+
+    // The config file goes first so flags always override it
+    for (const auto &[key, value] : flags)
+    {
+        if (key == "config" && !loadConfigFile(value, error))
+        {
+            return false;
+        }
+    }
+    for (const auto &[key, value] : flags)
+    {
+        if (key != "config" && !setOption(key, value, error))
+        {
+            return false;
+        }
+    }
+
+    // Checked once every option is set, as the engine and the policy may come from either source
+    return Simulator::validateDispatchPolicy(engineMode, dispatchKind, error);
+}
+
+bool RunOptions::parsePositiveInteger(const std::string &text, int &value)
+{
+    int parsed = 0;
+    if (!parseInteger(text, parsed) || parsed <= 0)
+    {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+std::string RunOptions::getUsage(const std::string &programName)
+{
+    std::ostringstream usage;
+    usage << "Usage: " << programName << " [--config FILE] [--OPTION VALUE]..." << std::endl
+          << "       " << programName << " --sweep <trucks first:last[:step]> <stations first:last[:step]> [replications] [--OPTION VALUE]..." << std::endl
+          << "       " << programName << " --estimate <trucks first:last[:step]> <stations first:last[:step]> [validate] [--OPTION VALUE]..." << std::endl
+          << std::endl
+          << "Options, also accepted as \"option = value\" lines in the config file. A sweep uses the durations, rates and seed, an estimate the durations and rates:" << std::endl
+          << "  --trucks N            Number of mining trucks, asked for if missing" << std::endl
+          << "  --stations N          Number of unloading stations, asked for if missing" << std::endl
+          << "  --horizon-mins N      Simulated minutes (default " << SimulationConfig::kDefaultHorizonMins << ")" << std::endl
+          << "  --travel-time-mins N  One way travel time (default " << SimulationConfig::kDefaultTravelTimeMins << ")" << std::endl
+          << "  --unload-time-mins N  Unload time per truck (default " << SimulationConfig::kDefaultUnloadTimeMins << ")" << std::endl
+          << "  --helium-per-min N    Helium mined per minute (default " << SimulationConfig::kDefaultHeliumPerMin << ")" << std::endl
+          << "  --min-mining-mins N   Shortest mining duration (default " << Site::kMinMiningMinutes << ")" << std::endl
+          << "  --max-mining-mins N   Longest mining duration (default " << Site::kMaxMiningMinutes << ")" << std::endl
+          << "  --seed N              Seed of the random streams" << std::endl
+          << "  --engine NAME         threaded, event_driven, worker_pool, coroutine, fixed_step, arrival_stream, conservative or optimistic (default threaded)" << std::endl
+          << "  --event-queue NAME    binary_heap, pairing_heap, calendar_queue or timing_wheel, for event_driven (default binary_heap)" << std::endl
+          << "  --dispatch NAME       shared_queue, join_shortest_queue, power_of_two, round_robin or least_expected_work," << std::endl
+          << "                        only shared_queue with engines other than threaded and event_driven (default shared_queue)" << std::endl
+          << "  --format NAME         text, csv or json (default text)" << std::endl
+          << "  --output FILE         Write the results to FILE instead of the default summary file or standard output" << std::endl
+          << "  --trace FILE          Record every truck state transition to the binary trace FILE, see TraceDecoder" << std::endl
+          << "  --help                Show this help" << std::endl;
+    return usage.str();
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include <algorithm>
+
+#include "../include/RunningStats.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+RunningStats::RunningStats(const int lowest, const int highest)
+    : m_lowest(lowest), m_bucketWidth(std::max(1, (highest - lowest + kNumBuckets) / kNumBuckets)), m_count(0),
+      m_min(0), m_max(0), m_sum(0), m_mean(0.0), m_sumSquaredDeviations(0.0), m_histogram{}
+{
+}
+
+void RunningStats::add(const int value)
+{
+    m_min = (m_count == 0) ? value : std::min(m_min, value);
+    m_max = (m_count == 0) ? value : std::max(m_max, value);
+    m_count++;
+    m_sum += value;
+
+    // Welford's update, stable even when the values are large compared to their spread
+    const double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_sumSquaredDeviations += delta * (value - m_mean);
+
+    const int bucket = std::clamp((value - m_lowest) / m_bucketWidth, 0, kNumBuckets - 1);
+    m_histogram[bucket]++;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "../include/SimulationConfig.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+bool SimulationConfig::validate(std::string &error) const
+{
+    if (horizonMins <= 0 || travelTimeMins <= 0 || unloadTimeMins <= 0 || heliumPerMin <= 0 || minMiningMins <= 0)
+    {
+        error = "Horizon, travel time, unload time, helium rate and mining minutes must be positive.";
+        return false;
+    }
+    if (maxMiningMins < minMiningMins)
+    {
+        error = "Maximum mining minutes must not be less than minimum mining minutes.";
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+
+#include "../include/SimulationResults.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+SimulationResults::SimulationResults(std::vector<Truck> &&trucks, std::vector<Station> &&stations)
+    : m_trucks(std::move(trucks)), m_stations(std::move(stations))
+{
+    // THREADED and COROUTINE finish Trucks and Stations in completion order
+    std::sort(m_trucks.begin(), m_trucks.end(), [](const Truck &a, const Truck &b)
+              { return a.getId() < b.getId(); });
+    std::sort(m_stations.begin(), m_stations.end(), [](const Station &a, const Station &b)
+              { return a.getId() < b.getId(); });
+}
+
+void SimulationResults::writeCsv(std::ostream &out) const
+{
+    out << "record,id,helium,unloads,mining_mins,queue_wait_mins,mining_mean_mins,mining_stddev_mins" << std::endl
+        << std::fixed << std::setprecision(2);
+    for (const Truck &truck : m_trucks)
+    {
+        out << "truck,"
+            << truck.getId() << ','
+            << truck.getTotalMinedHelium() << ','
+            << truck.getTotalNumberUnloads() << ','
+            << truck.getTotalMiningTime() << ','
+            << truck.getTotalQueueWait() << ','
+            << truck.getMiningStats().getMean() << ','
+            << truck.getMiningStats().getStdDev() << std::endl;
+    }
+    for (const Station &station : m_stations)
+    {
+        out << "station,"
+            << station.getId() << ','
+            << station.getTotalHeliumReceived() << ','
+            << station.getTotalTrucksUnloaded() << ",,,," << std::endl;
+    }
+}
+
+void SimulationResults::writeJson(std::ostream &out) const
+{
+    out << "{" << std::endl
+        << "  \"trucks\": [" << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < m_trucks.size(); ++i)
+    {
+        const Truck &truck = m_trucks[i];
+        out << ((i == 0) ? "" : ",") << std::endl
+            << "    {\"id\": " << truck.getId()
+            << ", \"helium\": " << truck.getTotalMinedHelium()
+            << ", \"unloads\": " << truck.getTotalNumberUnloads()
+            << ", \"mining_mins\": " << truck.getTotalMiningTime()
+            << ", \"queue_wait_mins\": " << truck.getTotalQueueWait()
+            << ", \"mining_mean_mins\": " << truck.getMiningStats().getMean()
+            << ", \"mining_stddev_mins\": " << truck.getMiningStats().getStdDev() << "}";
+    }
+    out << std::endl
+        << "  ]," << std::endl
+        << "  \"stations\": [";
+    for (std::size_t i = 0; i < m_stations.size(); ++i)
+    {
+        const Station &station = m_stations[i];
+        out << ((i == 0) ? "" : ",") << std::endl
+            << "    {\"id\": " << station.getId()
+            << ", \"helium\": " << station.getTotalHeliumReceived()
+            << ", \"unloads\": " << station.getTotalTrucksUnloaded() << "}";
+    }
+    out << std::endl
+        << "  ]" << std::endl
+        << "}" << std::endl;
+}
\ No newline at end of file
@@ -1,114 +1,331 @@
 #include <iostream>
-#include <sstream>
 #include <fstream>
 #include <string>
 #include <format>
 #include <chrono>
 #include <queue>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+#include <limits>
+#include <array>
+#include <barrier>
+#include <thread>
+#include <map>
+#include <deque>
 
 #include "../include/Simulator.h"
 #include "../include/Site.h"
+#include "../include/Event.h"
+#include "../include/UnloadTicket.h"
+#include "../include/WorkerPool.h"
+#include "../include/TraceFile.h"
+#include "../include/FixedStepKernel.h"
+#include "../include/WorkloadRecursion.h"
 
-// Internal variables for Simulator
-std::vector<Truck *> dataVector; // Shared vector for truck data
-std::mutex dataVectorMutex;      // Mutex to protect the shared queue
-std::mutex debugPrintMutex;      // Mutex to protect printing out statistics at the end
-std::mutex coutMutex;            // Share mutex when dumping cout debug msg
-std::mutex simulatorMutex;       // Share mutex when threads push Truck to vector
+namespace
+{
+    constexpr const char *kDebugFilePath = "../log/Mining_Simulator_Debugging_Log.txt"; // Default debugging log
+    constexpr const char *kSummaryFilePath = "../log/Mining_Simulator_Summary.txt";     // Default summary file
+
+    constexpr int kStreamPrefetchDistance = 8; // Arrivals whose mining durations are fetched ahead, their streams twice as far
+
+    constexpr int kRadixBits = 11;                 // Bits of a Truck id sorted per radix pass
+    constexpr int kRadixSize = 1 << kRadixBits;    // Counters per radix pass
+    constexpr std::size_t kMinRadixSortSize = 64;  // Smaller buckets are cheaper to sort by comparison
+
+    // Sorts a bucket of distinct Truck ids below idLimit, least significant digit first
+    void sortTruckIds(std::vector<int> &ids, std::vector<int> &scratch, const int idLimit)
+    {
+        if (ids.size() < kMinRadixSortSize)
+        {
+            std::sort(ids.begin(), ids.end());
+            return;
+        }
+        scratch.resize(ids.size());
+        for (int shift = 0; (idLimit - 1) >> shift != 0; shift += kRadixBits)
+        {
+            std::array<int, kRadixSize + 1> offsets{};
+            for (const int id : ids)
+            {
+                ++offsets[((id >> shift) & (kRadixSize - 1)) + 1];
+            }
+            for (int digit = 0; digit < kRadixSize; ++digit)
+            {
+                offsets[digit + 1] += offsets[digit];
+            }
+            for (const int id : ids)
+            {
+                scratch[offsets[(id >> shift) & (kRadixSize - 1)]++] = id;
+            }
+            ids.swap(scratch);
+        }
+    }
+
+    // Announcement of a Truck process to the Station process, sent when the Truck leaves the mining site
+    struct ArrivalMessage
+    {
+        int time;        // Minute the Truck joins the unload queue
+        int truckId;     // Arriving Truck
+        int minedHelium; // Helium the Truck brings
+    };
+
+    // Answer of the Station process, sent when a Station picks the Truck up
+    struct PickupMessage
+    {
+        int time;      // Minute the Station picks the Truck up
+        int truckId;   // Truck picked up
+        int stationId; // Station that unloads the Truck
+    };
+
+    // Logical process of CONSERVATIVE owning a contiguous range of Trucks, message buffers are indexed by window parity
+    struct TruckProcess
+    {
+        std::vector<std::vector<int>> trucksDue;           // Truck ids whose action completes in each minute
+        std::array<std::vector<ArrivalMessage>, 2> outbox; // Arrivals sent this window, read by the Station process in the next one
+        std::array<std::vector<PickupMessage>, 2> inbox;   // Pickups written by the Station process, read in the next window
+    };
+
+    constexpr int kOptimismWindowMins = 60; // OPTIMISTIC processes never run further than this past the GVT
+    constexpr int kEventsPerRound = 4096;   // Events a thread processes between two GVT computations
+    constexpr int kEventsPerDrain = 64;     // Events a thread processes between two looks at its inboxes
+
+    // Message between the logical processes of OPTIMISTIC, an anti-message cancels the message sent earlier for the same trip
+    struct TimeWarpMessage
+    {
+        int time;        // Arrival minute of an arrival, pickup minute of a pickup
+        int truckId;     // Truck of the trip
+        int arrivalTime; // Arrival minute of the trip, which identifies it
+        int value;       // Mined helium of an arrival, Station id of a pickup
+        bool isAnti;     // True to cancel the message sent for the same trip
+    };
+
+    // Messages to the logical processes of one thread, in the order they were sent
+    struct TimeWarpInbox
+    {
+        std::mutex mutex;                      // Protects messages
+        std::vector<TimeWarpMessage> messages; // Received and not yet handled
+    };
+
+    // Truck event of OPTIMISTIC, stale once its Truck was rolled back to a newer generation
+    struct TimeWarpEvent
+    {
+        int truckId;    // Truck to advance
+        int generation; // Generation of the Truck the event was scheduled in
+    };
+
+    // Truck events of one OPTIMISTIC thread by minute, Trucks are independent so the order within a minute is free
+    struct TimeWarpCalendar
+    {
+        std::vector<std::vector<TimeWarpEvent>> dueEvents; // Events completing in each minute
+        int cursor = 0;                                    // No events before this minute, moved back by rollbacks
+    };
+
+    // Truck state saved before a pickup is applied, restored if the pickup is cancelled
+    struct TruckSnapshot
+    {
+        TimeWarpMessage pickup; // Applied pickup
+        Truck truck;            // Truck before the pickup
+    };
+
+    // Uncommitted history of the logical process of one Truck
+    struct TruckHistory
+    {
+        int awaitedArrival = -1;              // Arrival minute of the trip waiting for its pickup, -1 if none
+        int generation = 0;                   // Bumped by every rollback so events of undone actions are skipped
+        std::vector<TruckSnapshot> snapshots; // Applied pickups that may still be cancelled, oldest first
+        std::vector<int> sentArrivals;        // Arrival minutes sent that may still be cancelled, oldest first
+        std::vector<TimeWarpMessage> pickups; // Received pickups not applied, waiting for their trip or their anti-message
+    };
 
-std::condition_variable dataCond;  // Condition variable for synchronization
-std::atomic<bool> finished(false); // Atomic flag to signal that producers have finished
+    // Arrival served by the Station process, undone newest first by a rollback
+    struct ServedArrival
+    {
+        int time;        // Arrival minute
+        int truckId;     // Arriving Truck
+        int minedHelium; // Helium the Truck brings
+        int pickupTime;  // Minute the Truck is picked up
+        int stationId;   // Station that unloads the Truck
+    };
 
-std::ofstream debugFile("../log/Mining_Simulator_Debugging_Log.txt");
-std::ofstream summaryOutFile("../log/Mining_Simulator_Summary.txt");
+    // Per-Truck counters of ARRIVAL_STREAM, packed so an arrival touches one cache line
+    struct TruckStream
+    {
+        int numDraws;       // Mining durations used, the first at minute 0
+        int totalHelium;    // Helium unloaded so far
+        int totalQueueWait; // Minutes waited for a Station so far
+        int numUnloads;     // Unloads so far
+    };
+}
 
 // --------------------------------------------------------
 // Public Member Functions
 // --------------------------------------------------------
-void Simulator::startSimulator()
+bool Simulator::startSimulator(std::string &error)
 {
-    summaryOutFile << "Starting mining simulation! Number of trucks = " << m_numTrucks
-                   << ". Number of stations = " << m_numStations << std::endl
-                   << std::endl;
+    if (m_numTrucks < 0 || m_numStations <= 0)
+    {
+        error = "Number of trucks must not be negative and number of stations must be positive.";
+        return false;
+    }
+    if (!m_config.validate(error) || !validateDispatchPolicy(m_engineMode, m_dispatchKind, error))
+    {
+        return false;
+    }
 
-    // Start truck mining threads
-    for (int i = 0; i < m_numTrucks; ++i)
+    // A trace that cannot be written fails the run before anything is simulated or printed
+    if (!m_traceFilePath.empty())
     {
-        // Capture current instance and call private
-        // simulateTruck() member function
-        m_miningTruckThreads.emplace_back([this, i]()
-                                          { this->simulateTruck(i); });
+        m_traceFile = std::make_unique<TraceFile>(m_traceFilePath);
+        if (!m_traceFile->isOpen())
+        {
+            m_traceFile.reset();
+            error = "Cannot open trace file " + m_traceFilePath + ".";
+            return false;
+        }
     }
 
-    // Start station threads
-    for (int i = 0; i < m_numStations; ++i)
+    // Every run starts from a clean context so a Simulator can be started again
+    m_trucks.clear();
+    m_stations.clear();
+    m_timeWarpStats = TimeWarpStats{};
+    m_miningTruckThreads.clear();
+    m_unloadStationThreads.clear();
+    m_isFinished = false;
+#ifdef DEBUG
+    m_summaryMutex.resetProfile();
+    m_resultsMutex.resetProfile();
+    m_truckUnloadWaits.reset();
+    m_stationIdleWaits.reset();
+#endif
+
+    // Write to the injected sinks, otherwise to this instance's own log files
+    m_summaryOut = m_summarySink;
+    if (m_isSummaryWritten && m_summaryOut == nullptr)
     {
-        // Capture current instance and call private
-        // simulateStation() member function
-        m_unloadStationThreads.emplace_back([this, i]()
-                                            { this->simulateStation(i); });
+        m_summaryFile.open(kSummaryFilePath);
+        m_summaryOut = &m_summaryFile;
+    }
+#ifdef DEBUG
+    if (m_debugSink != nullptr)
+    {
+        m_debugLogger = std::make_unique<AsyncLogger>(*m_debugSink);
+    }
+    else if (m_isSummaryWritten)
+    {
+        m_debugFile.open(kDebugFilePath);
+        m_debugLogger = std::make_unique<AsyncLogger>(m_debugFile);
     }
+#endif
 
-    // Wait for all trucks to finish
-    for (auto &truckThread : m_miningTruckThreads)
+    if (m_summaryOut != nullptr)
     {
-        truckThread.join();
+        *m_summaryOut << "Starting mining simulation! Number of trucks = " << m_numTrucks
+                      << ". Number of stations = " << m_numStations
+                      << ". Seed = " << m_seed << std::endl
+                      << std::endl;
     }
 
-    // Signal mining simulation is finished
-    finished = true;
-    dataCond.notify_all();
+    m_pacer.start();
 
-    // Wait for all stations to finish
-    for (auto &stationThread : m_unloadStationThreads)
+    switch (m_engineMode)
     {
-        stationThread.join();
+    case EngineMode::EVENT_DRIVEN:
+        simulateEventDriven();
+        break;
+    case EngineMode::WORKER_POOL:
+        simulateWorkerPool();
+        break;
+    case EngineMode::COROUTINE:
+        simulateCoroutines();
+        break;
+    case EngineMode::FIXED_STEP:
+        simulateFixedStep();
+        break;
+    case EngineMode::ARRIVAL_STREAM:
+        simulateArrivalStream();
+        break;
+    case EngineMode::CONSERVATIVE:
+        simulateConservative();
+        break;
+    case EngineMode::OPTIMISTIC:
+        simulateOptimistic();
+        break;
+    case EngineMode::THREADED:
+    default:
+        simulateThreaded();
+        break;
     }
 
+#ifdef DEBUG
+    printLockResults(); // Every thread has finished, only the debug logger still drains
+#endif
+
     // Close file
-    summaryOutFile.close();
-    debugFile.close();
+    m_traceFile.reset();
+    m_debugLogger.reset(); // Writes every buffered debug message before returning
+    if (m_summaryOut != nullptr)
+    {
+        m_summaryOut->flush();
+    }
+    if (m_summaryFile.is_open())
+    {
+        m_summaryFile.close();
+    }
+    if (m_debugFile.is_open())
+    {
+        m_debugFile.close();
+    }
+    return true;
 }
 
-int Simulator::calcMinTripsPossible()
+int Simulator::calcMinTripsPossible(const SimulationConfig &config)
 {
-    return std::floor(Simulator::kMaxMiningDurationMins / Simulator::kMaxOneCycleTimeMins);
+    return std::floor(config.horizonMins / config.getMaxCycleMins());
 }
 
-int Simulator::calcMaxTripsPossible()
+int Simulator::calcMaxTripsPossible(const SimulationConfig &config)
 {
-    return std::floor(Simulator::kMaxMiningDurationMins / Simulator::kMinOneCycleTimeMins); // How many times the truck can do a completecycle
-                                                                                            //  of mining -> unloading -> back at mine site
+    return std::floor(config.horizonMins / config.getMinCycleMins()); // How many times the truck can do a completecycle
+                                                                      //  of mining -> unloading -> back at mine site
 }
 
-int Simulator::calcMinHeliumPossible()
+int Simulator::calcMinHeliumPossible(const SimulationConfig &config)
 {
     // This assumes there is no waiting time at the stations
-    return (Simulator::calcMinTripsPossible() * Site::kMinMiningMinutes * Simulator::kHeliumMiningRatePerMin);
+    return (Simulator::calcMinTripsPossible(config) * config.minMiningMins * config.heliumPerMin);
 }
 
-int Simulator::calcMaxHeliumPossible()
+bool Simulator::validateDispatchPolicy(const EngineMode engineMode, const Dispatcher::Kind dispatchKind, std::string &error)
+{
+    // Only THREADED and EVENT_DRIVEN model per-station queues, the other engines are built on the shared FIFO
+    if (dispatchKind == Dispatcher::Kind::SHARED_QUEUE || engineMode == EngineMode::THREADED || engineMode == EngineMode::EVENT_DRIVEN)
+    {
+        return true;
+    }
+    error = std::string("Dispatch policy ") + Dispatcher::getName(dispatchKind) + " needs the threaded or event_driven engine.";
+    return false;
+}
+
+int Simulator::calcMaxHeliumPossible(const SimulationConfig &config)
 {
     // Maximum helium a truck can mine in the best case scenario
     int maximumHeliumPossible = 0;
 
-    int numberCompleteCycles = std::floor(Simulator::kMaxMiningDurationMins / Simulator::kMaxOneCycleTimeMins); // How many times the truck can do a completecycle
-                                                                                                                //  of mining -> unloading -> back at mine site
+    int numberCompleteCycles = std::floor(config.horizonMins / config.getMaxCycleMins()); // How many times the truck can do a completecycle
+                                                                                          //  of mining -> unloading -> back at mine site
 
     // Update maximumHeliumPossible with the number of full cycles a truck can complete
-    maximumHeliumPossible += (numberCompleteCycles * Site::kMaxMiningMinutes * Simulator::kHeliumMiningRatePerMin);
+    maximumHeliumPossible += (numberCompleteCycles * config.maxMiningMins * config.heliumPerMin);
 
-    int leftoverTime = (Simulator::kMaxMiningDurationMins - (Simulator::kMaxOneCycleTimeMins * numberCompleteCycles)); // Remainder time to determine maximum helium
-                                                                                                                       // truck can do on last iteration
+    int leftoverTime = (config.horizonMins - (config.getMaxCycleMins() * numberCompleteCycles)); // Remainder time to determine maximum helium
+                                                                                                 // truck can do on last iteration
 
-    int lastIterMaxMiningDur = (leftoverTime - Simulator::kTruckTravelTimeMins - Simulator::kUnloadTimeMins); // Time truck can spend on last iteration to be able to
-                                                                                                              // unload before totalSimulationTime is complete
-    maximumHeliumPossible += (lastIterMaxMiningDur * Simulator::kHeliumMiningRatePerMin);
+    int lastIterMaxMiningDur = (leftoverTime - config.travelTimeMins - config.unloadTimeMins); // Time truck can spend on last iteration to be able to
+                                                                                              // unload before totalSimulationTime is complete
+    maximumHeliumPossible += (std::max(lastIterMaxMiningDur, 0) * config.heliumPerMin);
 
     return maximumHeliumPossible;
 }
@@ -116,138 +333,123 @@ int Simulator::calcMaxHeliumPossible()
 // --------------------------------------------------------
 // Private Member Functions
 // --------------------------------------------------------
+void Simulator::simulateThreaded()
+{
+    // Without a dispatcher every station pulls from one shared lane, otherwise each station has its own
+    // Every truck is in an unload queue at most once, so no lane can ever be full
+    m_dispatcher = Dispatcher::create(m_dispatchKind, m_numStations, m_config.unloadTimeMins);
+    m_unloadLanes.clear();
+    for (int i = 0; i < (m_dispatcher ? m_numStations : 1); ++i)
+    {
+        m_unloadLanes.push_back(std::make_unique<UnloadLane>(m_numTrucks));
+    }
+    m_unloadTickets = std::make_unique<UnloadTicket[]>(m_numTrucks);
+
+    // Start truck mining threads
+    for (int i = 0; i < m_numTrucks; ++i)
+    {
+        // Capture current instance and call private
+        // simulateTruck() member function
+        m_miningTruckThreads.emplace_back([this, i]()
+                                          { this->simulateTruck(i); });
+    }
+
+    // Start station threads
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        // Capture current instance and call private
+        // simulateStation() member function
+        m_unloadStationThreads.emplace_back([this, i]()
+                                            { this->simulateStation(i); });
+    }
+
+    // Wait for all trucks to finish
+    for (auto &truckThread : m_miningTruckThreads)
+    {
+        truckThread.join();
+    }
+
+    // Signal mining simulation is finished and wake every station so it can drain its lane and exit
+    m_isFinished = true;
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        m_unloadLanes[m_dispatcher ? i : 0]->signal.release();
+    }
+
+    // Wait for all stations to finish
+    for (auto &stationThread : m_unloadStationThreads)
+    {
+        stationThread.join();
+    }
+
+    printPacingResults();
+}
+
 void Simulator::simulateTruck(int id)
 {
     int elapsedTime = 0; // Initialize to 0 to simulate the start of simulation time
     int sleepTime = 0;
 
-    Truck miningTruck(id);
+    Truck miningTruck = makeTruck(id);
+    RandomStream dispatchStream(m_seed, static_cast<std::uint64_t>(m_numTrucks) + id); // Dispatch draws, apart from the mining durations
+#ifdef DEBUG
+    HdrHistogram unloadWaits; // Time this thread blocked until unloaded, merged once at the end
+#endif
     // addTruck(miningTruck); // Need this for unit test later
-    printMessage(composeDebugMsg(std::format("Truck thread started and Truck ID = {}", id)));
+    debugLog("Truck thread started and Truck ID = {}", id);
 
-    while (elapsedTime < kMaxMiningDurationMins)
+    while (elapsedTime < m_config.horizonMins)
     {
-        printMessage(composeDebugMsg(std::format("Beginning of while loop, truck id = {}; elapsed time = {}",
-                                                 miningTruck.getId(), elapsedTime)));
+        debugLog("Beginning of while loop, truck id = {}; elapsed time = {}",
+                 miningTruck.getId(), elapsedTime);
         Truck::State currentState = miningTruck.getCurrentState();
-        switch (currentState)
-        {
-        case Truck::State::MINING:
-        {
-            // Update truck's member vars accordingly
-            miningTruck.setCurrentMiningTime(Site::getRandomMinedDuration());                                           // Set randomly generated mining duration
-            miningTruck.setCurrentMinedHelium(miningTruck.getCurrentMiningTime() * Simulator::kHeliumMiningRatePerMin); // Set helium mined during duration
-            miningTruck.setTotalMiningTime(miningTruck.getCurrentMiningTime() + miningTruck.getTotalMiningTime());      // Update total mining time
-            miningTruck.saveMiningDuration(miningTruck.getCurrentMiningTime());                                         // Add timing time to vector for unit testing
-
-            sleepTime = miningTruck.getCurrentMiningTime(); // Use member var for sleepTime
-            printMessage(composeDebugMsg(std::format("Mining truck id = {}; state = MINING state; mining time = {}; "
-                                                     "current helium = {}; total mining time = {}; elapsed time = {}.",
-                                                     miningTruck.getId(), sleepTime,
-                                                     miningTruck.getCurrentMinedHelium(),
-                                                     miningTruck.getTotalMiningTime(), elapsedTime)));
-            miningTruck.setCurrentState(Truck::State::TRAVEL_TO_UNLOAD_STATION); // Update trucks state the next state
-            break;
-        }
-        case Truck::State::TRAVEL_TO_MINING_SITE:
-        {
-            sleepTime = Simulator::kTruckTravelTimeMins;
-            printMessage(composeDebugMsg(std::format("Mining truck id = {}; state = TRAVEL_TO_MINING_SITE; "
-                                                     "sleep time = {}; elapsed time = {}.",
-                                                     miningTruck.getId(), sleepTime, elapsedTime)));
-            miningTruck.setCurrentState(Truck::State::MINING); // Update trucks state the next state
-            break;
-        }
-        case Truck::State::TRAVEL_TO_UNLOAD_STATION:
-        {
-            sleepTime = Simulator::kTruckTravelTimeMins;
-            printMessage(composeDebugMsg(std::format(
-                "Mining truck id = {}; state = TRAVEL_TO_UNLOAD_STATION; "
-                "sleepTime = {}; elapsed time = {}.",
-                miningTruck.getId(), sleepTime, elapsedTime)));
-            miningTruck.setCurrentState(Truck::State::UNLOADING); // Update trucks state the next state
-            break;
-        }
-        case Truck::State::UNLOADING:
-        {
-            sleepTime = Simulator::kUnloadTimeMins;
-            miningTruck.setTotalMinedHelium(miningTruck.getTotalMinedHelium() + miningTruck.getCurrentMinedHelium());
-            printMessage(composeDebugMsg(std::format(
-                "Mining truck id = {}; state = UNLOADING; current_helium = {}; "
-                "total_helium = {}; total mining time = {}; elapsed time = {}.",
-                miningTruck.getId(), miningTruck.getCurrentMinedHelium(),
-                miningTruck.getTotalMinedHelium(), miningTruck.getTotalMiningTime(), elapsedTime)));
+        sleepTime = advanceTruckState(miningTruck, elapsedTime);
 
-            miningTruck.setCurrentState(Truck::State::TRAVEL_TO_MINING_SITE); // Update trucks state the next state
-            break;
-        }
-        default:
-        {
-            sleepTime = 0;
-            printMessage(composeDebugMsg(std::format(
-                "Error! Mining truck id = {} unknown truck state.", miningTruck.getId())));
-            break;
-        }
-        }
         if (currentState == Truck::State::UNLOADING)
         {
-            // Push truck to dataQueue
-            std::unique_lock<std::mutex> lock(dataVectorMutex);
-            dataVector.push_back(&miningTruck);
-            int truckPositionInVector = dataVector.size() - 1; // will use this later to see if a station processed any truck before us.
-            printMessage(composeDebugMsg(std::format(
-                "Pushing mining truck id = {} to vector position = {}; with helium amount = {} "
-                "at elapsed time = {} to dataQueue to unload helium.",
-                miningTruck.getId(), truckPositionInVector, miningTruck.getCurrentMinedHelium(), elapsedTime)));
-
+            // Push truck's ticket to its lane, flag first so a station can never clear it before it is set
+            UnloadTicket &ticket = m_unloadTickets[id];
+            UnloadLane &lane = *m_unloadLanes[m_dispatcher ? m_dispatcher->dispatch(elapsedTime, dispatchStream) : 0];
             miningTruck.setIsInDataQueue(true);
-            dataCond.notify_one(); // Notify a station that new helium is available for unloading
-            lock.unlock();         // Unlock shared data queue so station can check if there is a truck on it
+            ticket.issue(miningTruck);
+            lane.queue.tryPush(&ticket);
+            debugLog(
+                "Pushing mining truck id = {} with helium amount = {} "
+                "at elapsed time = {} to dataQueue to unload helium.",
+                miningTruck.getId(), miningTruck.getCurrentMinedHelium(), elapsedTime);
+            lane.signal.release(); // Notify a station that new helium is available for unloading
 
-            // Now sleep until station processed this truck before truck can continue.
-            while (miningTruck.getIsInDataQueue())
-            {
-                if (didStationProcessTruck(miningTruck, truckPositionInVector)) // handle common case where Station has not wake up to process
-                {
-                    if (miningTruck.getIsInDataQueue())
-                    {
-                        int waitTime = 1; // Wait as little as possible to satisfied shortest wait queue requirement.
-                        int currentTripQueueWait = miningTruck.getCurrentTripQueueWait();
-                        miningTruck.setCurrentTripQueueWait(miningTruck.getCurrentTripQueueWait() + waitTime); // Update truck's current queue wait
-                        printMessage(composeDebugMsg(std::format(
-                            "Need to unload helium but must wait. Mining truck id = {}; "
-                            "helium amount = {}; current queue wait time = {}; elapsed time = {}.",
-                            miningTruck.getId(), miningTruck.getCurrentMinedHelium(),
-                            currentTripQueueWait, elapsedTime)));
-
-                        std::this_thread::sleep_for(std::chrono::milliseconds(waitTime));
-                        elapsedTime += waitTime;
-                    }
-                }
-                else
-                {
-                    printMessage(composeDebugMsg(std::format(
-                        "Mining truck id = {} was pushed to vector but "
-                        "no station processed other truck yet.",
-                        miningTruck.getId())));
-                }
-            }
+            // Now block until a station processed this truck before truck can continue.
+#ifdef DEBUG
+            const ProfiledMutex::Clock::time_point waitStart = ProfiledMutex::Clock::now();
+#endif
+            ticket.waitForCompletion();
+#ifdef DEBUG
+            unloadWaits.record(static_cast<std::uint64_t>((ProfiledMutex::Clock::now() - waitStart).count()));
+#endif
+            elapsedTime += ticket.getQueueWaitMins();
+            debugLog(
+                "Mining truck id = {} was picked up by a station after a queue wait time = {}; elapsed time = {}.",
+                miningTruck.getId(), ticket.getQueueWaitMins(), elapsedTime);
         }
         // Corner case check - if during last iteration a truck is mining for
         // a time that will be greater than 72 hours, cap the sleep duration so that it is 72 hours
-        if ((elapsedTime + sleepTime) > kMaxMiningDurationMins)
+        if ((elapsedTime + sleepTime) > m_config.horizonMins)
         {
             // Overwrite sleepTime to ensure truck simulate over 72 hour
-            sleepTime = (kMaxMiningDurationMins - elapsedTime);
+            sleepTime = (m_config.horizonMins - elapsedTime);
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime)); // Must simulate truck's action
         elapsedTime += sleepTime;
+        m_pacer.sleepUntilMinute(elapsedTime); // Absolute deadline, so oversleeping does not add up over the cycles
     }
 
     // Lock so that another thread will not access the vector at the same time and overwrite miningTruck
-    std::unique_lock<std::mutex> simLock(simulatorMutex);
+    std::unique_lock<ProfiledMutex> simLock(m_resultsMutex);
     addTruck(miningTruck); // Need this for unit test later
+#ifdef DEBUG
+    m_truckUnloadWaits.add(unloadWaits);
+#endif
     simLock.unlock();
 
     // Print results for each truck after 72 hour period is over
@@ -257,134 +459,1517 @@ void Simulator::simulateTruck(int id)
 void Simulator::simulateStation(int id)
 {
     Station unloadStation(id);
+    UnloadLane &lane = *m_unloadLanes[m_dispatcher ? id : 0];
 
-    printMessage(composeDebugMsg(std::format("Station thread started and Station ID = {}", id)));
+    debugLog("Station thread started and Station ID = {}", id);
+#ifdef DEBUG
+    HdrHistogram idleWaits; // Time this thread blocked until a truck arrived, merged once at the end
+#endif
 
     while (true)
     {
-        std::unique_lock<std::mutex> lock(dataVectorMutex);
-        dataCond.wait(lock, []
-                      { return !dataVector.empty() || finished; });
+        // Sleep until a truck is pushed or the simulation is finished
+#ifdef DEBUG
+        const ProfiledMutex::Clock::time_point waitStart = ProfiledMutex::Clock::now();
+#endif
+        lane.signal.acquire();
+#ifdef DEBUG
+        idleWaits.record(static_cast<std::uint64_t>((ProfiledMutex::Clock::now() - waitStart).count()));
+#endif
 
-        // If there's any truck on the data queue, then we know it's waiting to unload helium
-        while (!dataVector.empty())
+        UnloadTicket *ticket = nullptr;
+        bool hasTruck = lane.queue.tryPop(ticket);
+        while (!hasTruck)
         {
-            Truck *truck = dataVector.front();
-            dataVector.erase(dataVector.begin()); // Process truck and remove it from dataVector
-
-            // Successful unloading of truck, update station accordingly
-            unloadStation.incrementTotalTrucksUnloaded();
-            unloadStation.setTotalHeliumReceived(unloadStation.getTotalHeliumReceived() + truck->getCurrentMinedHelium());
+            // A push may still be publishing its cell, read the flag before retrying so a late push is never missed
+            const bool trucksFinished = m_isFinished;
+            hasTruck = lane.queue.tryPop(ticket);
+            if (hasTruck || trucksFinished)
+            {
+                break;
+            }
+            std::this_thread::yield();
+        }
 
-            // Update truck so that truck thread can see that it has been successfully unloaded at station
-            truck->incrementTotalNumberUnloads();
-            truck->setTotalQueueWait(truck->getTotalQueueWait() + truck->getCurrentTripQueueWait());
-            printMessage(composeDebugMsg(std::format("Station id = {}; unloading truck id = {}; currentTripQueueWait = {}; "
-                                                     "current helium collected = {}; total helium collected = {}; totalQueueWait = {}; "
-                                                     "totalSuccessfulUnloads = {}.",
-                                                     unloadStation.getId(), truck->getId(), truck->getCurrentMinedHelium(),
-                                                     truck->getTotalMinedHelium(), truck->getCurrentTripQueueWait(), truck->getTotalQueueWait(),
-                                                     truck->getTotalNumberUnloads())));
-            truck->setCurrentTripQueueWait(0); // Reset truck's current queue wait back to 0
-            truck->setIsInDataQueue(false);    // Reset flag so that Truck sees it has been processed
-            lock.unlock();                     // Unlock the mutex while simulating unloading time
+        if (!hasTruck)
+        {
+            break; // Exit if simulation time is finished and queue is empty
+        }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(Simulator::kUnloadTimeMins)); // Simulate unloading time
+        // Queue wait is the time between the truck's push and this pickup, in simulated minutes
+        Truck *truck = &ticket->getTruck();
+        const RealTimePacer::Clock::time_point pickupTime = RealTimePacer::Clock::now();
+        const int queueWaitMins = m_pacer.toMinutes(pickupTime - ticket->getArrivalTime());
 
-            lock.lock(); // Re-lock the mutex before checking the condition again
-        }
+        recordUnload(m_pacer.getCurrentMinute(), *truck, unloadStation, queueWaitMins);
+        ticket->complete(queueWaitMins); // Wake the truck thread, truck must not be touched after this
 
-        if (finished && dataVector.empty())
+        m_pacer.sleepUntil(pickupTime + m_pacer.getWallTimePerMinute() * m_config.unloadTimeMins); // Simulate unloading time
+        if (m_dispatcher)
         {
-            break; // Exit if simulation time is finished and vector is empty
+            m_dispatcher->completeUnload(id);
         }
     }
 
     // Lock so that another thread will not access the vector at the same time and overwrite unloadStation
-    std::unique_lock<std::mutex> simLock(simulatorMutex);
+    std::unique_lock<ProfiledMutex> simLock(m_resultsMutex);
     addStation(unloadStation); // Need this for unit test later
+#ifdef DEBUG
+    m_stationIdleWaits.add(idleWaits);
+#endif
     simLock.unlock();
 
     // Print out results from each station after simulation is complete
     printStationResults(unloadStation);
 }
 
-bool Simulator::didStationProcessTruck(const Truck truck, const int position)
+void Simulator::simulateEventDriven()
 {
-    std::unique_lock<std::mutex> lock(dataVectorMutex);
-    // Check if Truck position in case Station has already processed it and it is no
-    // longer in the shared dataVector and will return out of range exception
-    if (dataVector.size() > position)
+    std::vector<Truck> trucks;                                                                                         // Trucks indexed by id, owned by the event loop
+    std::vector<Station> stations;                                                                                     // Stations indexed by id, owned by the event loop
+    std::vector<int> queueArrivalTime(m_numTrucks, 0);                                                                 // Time each waiting truck joined the unload queue
+    std::queue<int> unloadQueue;                                                                                       // FIFO of truck ids waiting for a station
+    std::priority_queue<int, std::vector<int>, std::greater<int>> idleStations;                                        // Idle station ids, lowest id first
+    std::unique_ptr<EventQueue> calendar = EventQueue::create(m_eventQueueKind);                                       // Future event list ordered by time
+    std::unique_ptr<Dispatcher> dispatcher = Dispatcher::create(m_dispatchKind, m_numStations, m_config.unloadTimeMins); // Commits trucks to a station, nullptr for the shared FIFO
+    std::vector<std::queue<int>> stationQueues(dispatcher ? m_numStations : 0);                                        // FIFO of truck ids committed to each station
+    std::vector<RandomStream> dispatchStreams;                                                                         // Dispatch draws per truck, apart from the mining durations
+    long long sequence = 0;                                                                                            // Insertion counter for tie breaking
+
+    trucks.reserve(m_numTrucks);
+    for (int i = 0; i < m_numTrucks; ++i)
     {
-        Truck *truckInVector = dataVector.at(position);
-        lock.unlock();
-        if (truckInVector != NULL && truckInVector->getId() == truck.getId())
+        trucks.push_back(makeTruck(i));
+        calendar->push(Event(0, sequence++, Event::TRUCK_STATE_COMPLETE, i)); // All trucks start mining simultaneously
+        if (dispatcher)
+        {
+            dispatchStreams.emplace_back(m_seed, static_cast<std::uint64_t>(m_numTrucks) + i);
+        }
+    }
+    stations.reserve(m_numStations);
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        stations.emplace_back(i);
+        idleStations.push(i);
+    }
+
+    // Both the station and the truck are busy for the unload time, the truck is still capped at 72 hours
+    auto unloadTruck = [&](Station &unloadStation, Truck &truck, const int now)
+    {
+        // Queue wait is the time between joining the queue and being picked up
+        recordUnload(now, truck, unloadStation, now - queueArrivalTime[truck.getId()]);
+
+        calendar->push(Event(now + m_config.unloadTimeMins, sequence++, Event::STATION_UNLOAD_COMPLETE, unloadStation.getId()));
+        calendar->push(Event(std::max(now, std::min(now + m_config.unloadTimeMins, m_config.horizonMins)), sequence++,
+                             Event::TRUCK_STATE_COMPLETE, truck.getId()));
+    };
+
+    while (!calendar->empty())
+    {
+        const Event event = calendar->pop();
+        const int now = event.getTime();
+
+        if (event.getType() == Event::TRUCK_STATE_COMPLETE)
+        {
+            Truck &truck = trucks[event.getId()];
+            if (now >= m_config.horizonMins)
+            {
+                // Truck is done, hand it over the same way the threaded engine does
+                addTruck(truck);
+                printTruckResults(truck, m_config.horizonMins);
+                continue;
+            }
+
+            Truck::State currentState = truck.getCurrentState();
+            int sleepTime = advanceTruckState(truck, now);
+
+            if (currentState == Truck::State::UNLOADING)
+            {
+                // Truck resumes once a station picks it up, see the dispatch below
+                truck.setIsInDataQueue(true);
+                queueArrivalTime[truck.getId()] = now;
+                if (!dispatcher)
+                {
+                    unloadQueue.push(truck.getId());
+                }
+                else
+                {
+                    // A committed truck waits for its own station only, even if another one is idle
+                    const int stationId = dispatcher->dispatch(now, dispatchStreams[truck.getId()]);
+                    if (dispatcher->getNumTrucks(stationId) == 1)
+                    {
+                        unloadTruck(stations[stationId], truck, now); // Station had nothing committed, so it is idle
+                    }
+                    else
+                    {
+                        stationQueues[stationId].push(truck.getId());
+                    }
+                }
+            }
+            else
+            {
+                // Same 72 hour cap as the threaded engine
+                calendar->push(Event(std::min(now + sleepTime, m_config.horizonMins), sequence++,
+                                     Event::TRUCK_STATE_COMPLETE, truck.getId()));
+            }
+        }
+        else if (!dispatcher)
         {
-            return false; // No truck has been unloaded
+            idleStations.push(event.getId());
         }
         else
         {
-            return true; // A truck has been unloaded
+            // Station takes the next truck committed to it, if any
+            std::queue<int> &stationQueue = stationQueues[event.getId()];
+            dispatcher->completeUnload(event.getId());
+            if (!stationQueue.empty())
+            {
+                Truck &truck = trucks[stationQueue.front()];
+                stationQueue.pop();
+                unloadTruck(stations[event.getId()], truck, now);
+            }
+        }
+
+        // Hand waiting trucks of the shared FIFO to idle stations
+        while (!unloadQueue.empty() && !idleStations.empty())
+        {
+            Station &unloadStation = stations[idleStations.top()];
+            idleStations.pop();
+            Truck &truck = trucks[unloadQueue.front()];
+            unloadQueue.pop();
+            unloadTruck(unloadStation, truck, now);
         }
     }
-    else
+
+    // Print out results from each station after simulation is complete
+    for (const auto &station : stations)
     {
-        lock.unlock();
-        return true; // A truck has been unloaded
+        addStation(station);
+        printStationResults(station);
     }
 }
 
-void Simulator::printTruckResults(const Truck &truck, const int truckElapsedTime) const
+void Simulator::simulateWorkerPool()
 {
-    double averageQueueTime = truck.calculateAverageQueueTime(truck.getTotalQueueWait(), kMaxMiningDurationMins);
-    double truckEfficiency = static_cast<double>((truck.getTotalMinedHelium()) / static_cast<double>(Simulator::calcMaxHeliumPossible()));
-    std::lock_guard<std::mutex> lock(debugPrintMutex);
-
-    summaryOutFile << "TRUCK " << truck.getId() << " FINAL RESULTS:" << std::endl
-                   << "Total Helium Mined                       = " << truck.getTotalMinedHelium() << std::endl
-                   << "Total Mining Duration                    = " << truck.getTotalMiningTime() << " minutes" << std::endl
-                   << "Calculated Mining Duration for Checking  = " << truck.calculateTotalMiningDuration() << " minutes" << std::endl
-                   << "Total Successful Unloaded Trips          = " << truck.getTotalNumberUnloads() << std::endl
-                   << "Total Time Spent Waiting in Queue        = " << truck.getTotalQueueWait() << " minutes" << std::endl
-                   << "Average Time Spent Waiting in Queue      = "
-                   << std::fixed << std::setprecision(2) << truck.convertToPercent(averageQueueTime) << "%" << std::endl
-                   << "Maximum Helium Possible                  = " << Simulator::calcMaxHeliumPossible() << std::endl
-                   << "Maximum Unloaded Trips Possible          = " << Simulator::calcMaxTripsPossible() << std::endl
-                   << "Truck Efficiency                         = "
-                   << std::fixed << std::setprecision(2) << truck.convertToPercent(truckEfficiency) << "%" << std::endl
-                   << "Truck Ending Elapsed Time                = " << truckElapsedTime
-                   << std::endl
-                   << std::endl;
-}
+    static constexpr int kInUnloadQueue = -1; // nextActionTime marker for a truck waiting for a station
 
-void Simulator::printStationResults(const Station &station) const
-{
-    std::lock_guard<std::mutex> lock(debugPrintMutex);
-    summaryOutFile << "STATION " << station.getId() << " FINAL RESULTS:" << std::endl
-                   << "Total Helium Received                    = " << station.getTotalHeliumReceived() << std::endl
-                   << "Total Trucks Unloaded                    = " << station.getTotalTrucksUnloaded() << std::endl
-                   << std::endl;
-}
+    WorkerPool pool(m_numWorkerThreads);
+    Fleet fleet = makeFleet();                                       // Trucks stored column by column, indexed by id
+    std::vector<Station> stations;                                   // Stations indexed by id
+    std::vector<int> stationFreeTime(m_numStations, 0);              // Minute each station finishes its current unload
+    std::vector<int> &nextActionTime = fleet.getNextEventTimes();    // Minute each truck's current action completes
+    std::vector<int> queueArrivalTime(m_numTrucks, 0);               // Time each waiting truck joined the unload queue
+    std::vector<std::vector<int>> trucksDue(m_config.horizonMins);   // Truck ids whose action completes in each minute
+    std::queue<int> unloadQueue;                                     // FIFO of truck ids waiting for a station
 
-#ifdef DEBUG
-void Simulator::printMessage(const std::string &message)
-{
-    // Lock the mutex before writing to std::cout
-    std::lock_guard<std::mutex> guard(coutMutex);
+    trucksDue[0].reserve(m_numTrucks);
+    for (int i = 0; i < m_numTrucks; ++i)
+    {
+        trucksDue[0].push_back(i); // All trucks start mining simultaneously
+    }
+    stations.reserve(m_numStations);
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        stations.emplace_back(i);
+    }
 
-    // Now it's safe to write to std::cout without interference from other threads
-    debugFile << message << std::endl;
-}
-#else
-void Simulator::printMessage(const std::string &message)
-{
-    // do nothing
-}
-#endif
+    // Queue the truck's next action or hand it over if it has reached 72 hours
+    auto scheduleTruck = [&](const Fleet::TruckRef truck, const int time)
+    {
+        if (time < m_config.horizonMins)
+        {
+            trucksDue[time].push_back(truck.getId());
+        }
+        else
+        {
+            const Truck finishedTruck = fleet.toTruck(truck.getId());
+            addTruck(finishedTruck);
+            printTruckResults(finishedTruck, m_config.horizonMins);
+        }
+    };
 
-std::string Simulator::composeDebugMsg(const std::string message)
-{
-    std::ostringstream oss;
-    oss << message;
-    return oss.str();
+    // Stations keep unloading trucks that queued before 72 hours
+    for (int now = 0; now < m_config.horizonMins || !unloadQueue.empty(); ++now)
+    {
+        if (now < m_config.horizonMins)
+        {
+            std::vector<int> dueTrucks;
+            dueTrucks.swap(trucksDue[now]); // Releases the bucket's memory once processed
+
+            // Truck state transitions are independent of each other, run them as tasks on the pool
+            pool.parallelFor(static_cast<int>(dueTrucks.size()), [&](int first, int last)
+                             {
+                for (int i = first; i < last; ++i)
+                {
+                    Fleet::TruckRef truck = fleet[dueTrucks[i]];
+                    Truck::State currentState = truck.getCurrentState();
+                    int sleepTime = advanceTruckState(truck, now);
+                    nextActionTime[truck.getId()] = (currentState == Truck::State::UNLOADING)
+                                                        ? kInUnloadQueue
+                                                        : std::min(now + sleepTime, m_config.horizonMins);
+                } });
+
+            for (const int truckId : dueTrucks)
+            {
+                if (nextActionTime[truckId] == kInUnloadQueue)
+                {
+                    fleet[truckId].setIsInDataQueue(true);
+                    queueArrivalTime[truckId] = now;
+                    unloadQueue.push(truckId);
+                }
+                else
+                {
+                    scheduleTruck(fleet[truckId], nextActionTime[truckId]);
+                }
+            }
+        }
+
+        // Hand waiting trucks to idle stations, lowest station id first
+        for (int i = 0; i < m_numStations && !unloadQueue.empty(); ++i)
+        {
+            if (stationFreeTime[i] > now)
+            {
+                continue;
+            }
+            Station &unloadStation = stations[i];
+            Fleet::TruckRef truck = fleet[unloadQueue.front()];
+            unloadQueue.pop();
+
+            // Queue wait is the time between joining the queue and being picked up
+            recordUnload(now, truck, unloadStation, now - queueArrivalTime[truck.getId()]);
+
+            stationFreeTime[i] = now + m_config.unloadTimeMins;
+            scheduleTruck(truck, now + m_config.unloadTimeMins);
+        }
+    }
+
+    // Print out results from each station after simulation is complete
+    for (const auto &station : stations)
+    {
+        addStation(station);
+        printStationResults(station);
+    }
+}
+
+void Simulator::simulateFixedStep()
+{
+    static constexpr int kInUnloadQueue = std::numeric_limits<int>::max(); // Next event time of a truck waiting for a station, never due
+    static constexpr int kPrefetchDistance = 8;                            // Rare trucks whose columns are fetched ahead
+#ifdef DEBUG
+    const bool isEveryTransitionRecorded = true;
+#else
+    const bool isEveryTransitionRecorded = (m_traceFile != nullptr);
+#endif
+
+    Fleet fleet = makeFleet();                                  // Trucks stored column by column, all MINING at minute 0
+    std::vector<Station> stations;                              // Stations indexed by id
+    std::vector<int> stationFreeTime(m_numStations, 0);         // Minute each station finishes its current unload
+    std::vector<int> queueArrivalTime(m_numTrucks, 0);          // Time each waiting truck joined the unload queue
+    std::vector<int> rareTruckIds;                              // Due trucks that need the scalar path this minute
+    std::queue<int> unloadQueue;                                // FIFO of truck ids waiting for a station
+    int *nextEventTimes = fleet.getNextEventTimes().data();     // Next event time column scanned by the kernel
+    FixedStepKernel kernel(fleet.getStates().data(), nextEventTimes, m_numTrucks, m_config.travelTimeMins);
+
+    stations.reserve(m_numStations);
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        stations.emplace_back(i);
+    }
+
+    // Stations keep unloading trucks that queued before 72 hours
+    for (int now = 0; now < m_config.horizonMins || !unloadQueue.empty(); ++now)
+    {
+        if (now < m_config.horizonMins)
+        {
+            rareTruckIds.clear();
+            if (isEveryTransitionRecorded)
+            {
+                for (int id = 0; id < m_numTrucks; ++id)
+                {
+                    if (nextEventTimes[id] == now)
+                    {
+                        rareTruckIds.push_back(id);
+                    }
+                }
+            }
+            else
+            {
+                kernel.advanceTravellingTrucks(now, rareTruckIds);
+            }
+
+            const int numRareTrucks = static_cast<int>(rareTruckIds.size());
+            for (int i = 0; i < numRareTrucks; ++i)
+            {
+                if (i + kPrefetchDistance < numRareTrucks)
+                {
+                    fleet.prefetch(rareTruckIds[i + kPrefetchDistance]); // Columns of a truck a few ids ahead
+                }
+                const int id = rareTruckIds[i];
+                Fleet::TruckRef truck = fleet[id];
+                Truck::State currentState = truck.getCurrentState();
+                int sleepTime = advanceTruckState(truck, now);
+                if (currentState == Truck::State::UNLOADING)
+                {
+                    truck.setIsInDataQueue(true);
+                    truck.setNextEventTime(kInUnloadQueue);
+                    queueArrivalTime[id] = now;
+                    unloadQueue.push(id);
+                }
+                else
+                {
+                    truck.setNextEventTime(now + sleepTime);
+                }
+                kernel.refreshTruck(id);
+            }
+        }
+
+        // Hand waiting trucks to idle stations, lowest station id first
+        for (int i = 0; i < m_numStations && !unloadQueue.empty(); ++i)
+        {
+            if (stationFreeTime[i] > now)
+            {
+                continue;
+            }
+            Station &unloadStation = stations[i];
+            Fleet::TruckRef truck = fleet[unloadQueue.front()];
+            unloadQueue.pop();
+
+            // Queue wait is the time between joining the queue and being picked up
+            recordUnload(now, truck, unloadStation, now - queueArrivalTime[truck.getId()]);
+
+            stationFreeTime[i] = now + m_config.unloadTimeMins;
+            truck.setNextEventTime(now + m_config.unloadTimeMins);
+            kernel.refreshTruck(truck.getId());
+        }
+    }
+
+    // Every truck has reached 72 hours, print results in id order
+    for (int id = 0; id < m_numTrucks; ++id)
+    {
+        const Truck finishedTruck = fleet.toTruck(id);
+        addTruck(finishedTruck);
+        printTruckResults(finishedTruck, m_config.horizonMins);
+    }
+
+    // Print out results from each station after simulation is complete
+    for (const auto &station : stations)
+    {
+        addStation(station);
+        printStationResults(station);
+    }
+}
+
+void Simulator::simulateArrivalStream()
+{
+#ifdef DEBUG
+    const bool isEveryTransitionRecorded = true;
+#else
+    const bool isEveryTransitionRecorded = (m_traceFile != nullptr);
+#endif
+    if (isEveryTransitionRecorded)
+    {
+        simulateFixedStep(); // Same results, with every transition going through advanceTruckState()
+        return;
+    }
+
+    // Mining starts are at least one shortest cycle apart and only draw before the horizon
+    const int horizon = m_config.horizonMins;
+    const int maxDraws = (horizon - 1) / m_config.getMinCycleMins() + 1;
+    const int tripTimeMins = m_config.unloadTimeMins + m_config.travelTimeMins; // Pickup to the next mining start
+
+    Fleet fleet = makeFleet();                                                      // Trucks stored column by column
+    std::vector<int> miningTimes(static_cast<std::size_t>(m_numTrucks) * maxDraws); // Every Truck's mining durations in draw order
+    std::vector<TruckStream> streams(m_numTrucks, TruckStream{1, 0, 0, 0});         // Counters per Truck
+    std::vector<std::vector<int>> arrivals(horizon);                                // Trucks joining the unload queue each minute
+    std::vector<Station> stations;                                                  // Stations indexed by id
+    WorkloadRecursion recursion(m_numStations, m_config.unloadTimeMins);            // FIFO queue of the Stations
+    std::vector<int> sortScratch;                                                   // Second buffer of the radix sort
+
+    // Arrival streams: each Truck's draws come from its own random stream, one Truck at a time
+    for (int id = 0; id < m_numTrucks; ++id)
+    {
+        RandomStream &randomStream = fleet[id].getRandomStream();
+        int *truckMiningTimes = miningTimes.data() + static_cast<std::size_t>(id) * maxDraws;
+        for (int draw = 0; draw < maxDraws; ++draw)
+        {
+            truckMiningTimes[draw] = Site::getRandomMinedDuration(randomStream, m_config.minMiningMins, m_config.maxMiningMins);
+        }
+
+        const int firstArrival = truckMiningTimes[0] + m_config.travelTimeMins;
+        if (firstArrival < horizon)
+        {
+            arrivals[firstArrival].push_back(id); // Ids ascend, so the first bucket entries are already in order
+        }
+    }
+    stations.reserve(m_numStations);
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        stations.emplace_back(i);
+    }
+
+    // Merge the streams minute by minute, same-minute arrivals queue in id order like FIXED_STEP
+    for (int now = 0; now < horizon; ++now)
+    {
+        std::vector<int> &bucket = arrivals[now];
+        sortTruckIds(bucket, sortScratch, m_numTrucks);
+        const int numArrivals = static_cast<int>(bucket.size());
+        for (int i = 0; i < numArrivals; ++i)
+        {
+            // Trucks are scattered over memory, so fetch the ones a few arrivals ahead
+            if (i + 2 * kStreamPrefetchDistance < numArrivals)
+            {
+                __builtin_prefetch(&streams[bucket[i + 2 * kStreamPrefetchDistance]], 1);
+            }
+            if (i + kStreamPrefetchDistance < numArrivals)
+            {
+                const int aheadId = bucket[i + kStreamPrefetchDistance];
+                __builtin_prefetch(miningTimes.data() + static_cast<std::size_t>(aheadId) * maxDraws + streams[aheadId].numDraws - 1);
+            }
+
+            const int id = bucket[i];
+            TruckStream &stream = streams[id];
+            const int *truckMiningTimes = miningTimes.data() + static_cast<std::size_t>(id) * maxDraws;
+            const int minedHelium = truckMiningTimes[stream.numDraws - 1] * m_config.heliumPerMin;
+            int stationId = 0;
+            const int pickupTime = recursion.serve(now, stationId);
+
+            Station &unloadStation = stations[stationId];
+            unloadStation.incrementTotalTrucksUnloaded();
+            unloadStation.setTotalHeliumReceived(unloadStation.getTotalHeliumReceived() + minedHelium);
+            stream.totalHelium += minedHelium;
+            stream.totalQueueWait += pickupTime - now;
+            ++stream.numUnloads;
+
+            // Feed the pickup back into the Truck's stream
+            const int nextMiningStart = pickupTime + tripTimeMins;
+            if (nextMiningStart < horizon)
+            {
+                const int nextArrival = nextMiningStart + truckMiningTimes[stream.numDraws++] + m_config.travelTimeMins;
+                if (nextArrival < horizon)
+                {
+                    arrivals[nextArrival].push_back(id);
+                }
+            }
+        }
+        std::vector<int>().swap(bucket); // Minute is done, release its memory
+    }
+
+    // Only the durations a Truck actually started count towards its mining totals
+    m_trucks.reserve(m_trucks.size() + m_numTrucks);
+    for (int id = 0; id < m_numTrucks; ++id)
+    {
+        Fleet::TruckRef truck = fleet[id];
+        const TruckStream &stream = streams[id];
+        const int *truckMiningTimes = miningTimes.data() + static_cast<std::size_t>(id) * maxDraws;
+        int totalMiningTime = 0;
+        for (int draw = 0; draw < stream.numDraws; ++draw)
+        {
+            totalMiningTime += truckMiningTimes[draw];
+            truck.saveMiningDuration(truckMiningTimes[draw]);
+        }
+        truck.setTotalMiningTime(totalMiningTime);
+        truck.setCurrentMiningTime(truckMiningTimes[stream.numDraws - 1]);
+        truck.setCurrentMinedHelium(truck.getCurrentMiningTime() * m_config.heliumPerMin);
+        truck.setTotalMinedHelium(stream.totalHelium);
+        truck.setTotalQueueWait(stream.totalQueueWait);
+        fleet.getUnloadCounts()[id] = stream.numUnloads;
+
+        const Truck finishedTruck = fleet.toTruck(id);
+        addTruck(finishedTruck);
+        printTruckResults(finishedTruck, horizon);
+    }
+
+    // Print out results from each station after simulation is complete
+    for (const auto &station : stations)
+    {
+        addStation(station);
+        printStationResults(station);
+    }
+}
+
+void Simulator::simulateConservative()
+{
+    // A Truck announces its arrival when it leaves the mining site, travelTimeMins ahead, and a Station
+    // announces the end of an unload when it picks the Truck up, unloadTimeMins ahead. Within a window of
+    // the smaller of the two no process can receive a message it has not been sent yet.
+    const int lookahead = std::min(m_config.travelTimeMins, m_config.unloadTimeMins);
+    const int horizon = m_config.horizonMins;
+    const int numWindows = (horizon + lookahead - 1) / lookahead;
+    const int numProcesses = std::clamp(m_numWorkerThreads, 1, std::max(m_numTrucks, 1)); // Truck processes, one thread each
+    const int trucksPerProcess = (m_numTrucks + numProcesses - 1) / numProcesses;
+
+    Fleet fleet = makeFleet();                                           // Trucks stored column by column, each range owned by one process
+    std::vector<int> queueArrivalTime(m_numTrucks, 0);                   // Time each waiting truck joined the unload queue
+    std::vector<TruckProcess> processes(numProcesses);                   // Truck processes, the Station process runs on the thread of the first
+    std::vector<std::vector<ArrivalMessage>> stationArrivals(horizon);   // Announced arrivals per minute, owned by the Station process
+    std::vector<Station> stations;                                       // Stations indexed by id, owned by the Station process
+    WorkloadRecursion recursion(m_numStations, m_config.unloadTimeMins); // FIFO queue of the Stations
+    std::barrier windowBarrier(numProcesses);                            // Ends every window
+
+    for (int k = 0; k < numProcesses; ++k)
+    {
+        processes[k].trucksDue.resize(horizon);
+        for (int id = k * trucksPerProcess; id < std::min((k + 1) * trucksPerProcess, m_numTrucks); ++id)
+        {
+            processes[k].trucksDue[0].push_back(id); // All trucks start mining simultaneously
+        }
+    }
+    stations.reserve(m_numStations);
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        stations.emplace_back(i);
+    }
+
+    // Station process: serve the window's arrivals in (minute, id) order, the same order as FIXED_STEP
+    auto runStationWindow = [&](const int first, const int last, const int parity)
+    {
+        for (int now = first; now < last; ++now)
+        {
+            std::vector<ArrivalMessage> &bucket = stationArrivals[now];
+            std::sort(bucket.begin(), bucket.end(), [](const ArrivalMessage &a, const ArrivalMessage &b)
+                      { return a.truckId < b.truckId; });
+            for (const ArrivalMessage &arrival : bucket)
+            {
+                int stationId = 0;
+                const int pickupTime = recursion.serve(now, stationId);
+                Station &unloadStation = stations[stationId];
+                unloadStation.incrementTotalTrucksUnloaded();
+                unloadStation.setTotalHeliumReceived(unloadStation.getTotalHeliumReceived() + arrival.minedHelium);
+                processes[arrival.truckId / trucksPerProcess].inbox[parity].push_back({pickupTime, arrival.truckId, stationId});
+            }
+            std::vector<ArrivalMessage>().swap(bucket); // Minute is done, release its memory
+        }
+    };
+
+    // Truck process: a pickup ends the Truck's wait, it leaves the Station unloadTimeMins later
+    auto receivePickup = [&](TruckProcess &process, const PickupMessage &pickup)
+    {
+        Fleet::TruckRef truck = fleet[pickup.truckId];
+        recordUnload(pickup.time, truck, pickup.stationId, pickup.time - queueArrivalTime[pickup.truckId]);
+
+        const int leaveTime = pickup.time + m_config.unloadTimeMins;
+        if (leaveTime < horizon)
+        {
+            process.trucksDue[leaveTime].push_back(pickup.truckId);
+        }
+    };
+
+    // Truck process: advance the window's due Trucks, announcing every departure to the Station process
+    auto runTruckWindow = [&](TruckProcess &process, const int first, const int last, const int parity)
+    {
+        for (int now = first; now < last; ++now)
+        {
+            std::vector<int> dueTrucks;
+            dueTrucks.swap(process.trucksDue[now]); // Releases the bucket's memory once processed
+            for (const int id : dueTrucks)
+            {
+                Fleet::TruckRef truck = fleet[id];
+                const Truck::State currentState = truck.getCurrentState();
+                const int nextTime = now + advanceTruckState(truck, now);
+                if (currentState == Truck::State::UNLOADING)
+                {
+                    truck.setIsInDataQueue(true); // Waits for its PickupMessage
+                    queueArrivalTime[id] = now;
+                    continue;
+                }
+                if (nextTime < horizon)
+                {
+                    if (currentState == Truck::State::TRAVEL_TO_UNLOAD_STATION)
+                    {
+                        process.outbox[parity].push_back({nextTime, id, truck.getCurrentMinedHelium()});
+                    }
+                    process.trucksDue[nextTime].push_back(id);
+                }
+            }
+        }
+    };
+
+    // Each window first takes in the messages of the previous one, the last window only does that
+    auto runProcess = [&](const int k)
+    {
+        TruckProcess &process = processes[k];
+        for (int window = 0; window <= numWindows; ++window)
+        {
+            const int parity = window & 1;
+            if (k == 0)
+            {
+                for (TruckProcess &sender : processes)
+                {
+                    for (const ArrivalMessage &arrival : sender.outbox[parity ^ 1])
+                    {
+                        stationArrivals[arrival.time].push_back(arrival);
+                    }
+                    sender.inbox[parity].clear(); // Read by its process in the window before last
+                }
+            }
+            for (const PickupMessage &pickup : process.inbox[parity ^ 1])
+            {
+                receivePickup(process, pickup);
+            }
+            process.outbox[parity].clear(); // Read by the Station process in the window before last
+            if (window == numWindows)
+            {
+                break;
+            }
+
+            const int first = window * lookahead;
+            const int last = std::min(first + lookahead, horizon);
+            if (k == 0)
+            {
+                runStationWindow(first, last, parity);
+            }
+            runTruckWindow(process, first, last, parity);
+            windowBarrier.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int k = 1; k < numProcesses; ++k)
+    {
+        threads.emplace_back(runProcess, k);
+    }
+    runProcess(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every truck has reached 72 hours, print results in id order
+    for (int id = 0; id < m_numTrucks; ++id)
+    {
+        const Truck finishedTruck = fleet.toTruck(id);
+        addTruck(finishedTruck);
+        printTruckResults(finishedTruck, horizon);
+    }
+
+    // Print out results from each station after simulation is complete
+    for (const auto &station : stations)
+    {
+        addStation(station);
+        printStationResults(station);
+    }
+}
+
+void Simulator::simulateOptimistic()
+{
+#ifdef DEBUG
+    const bool isEveryTransitionRecorded = true;
+#else
+    const bool isEveryTransitionRecorded = (m_traceFile != nullptr);
+#endif
+    if (isEveryTransitionRecorded)
+    {
+        simulateConservative(); // Same results, without output that a rollback would have to take back
+        return;
+    }
+
+    using ArrivalKey = std::pair<int, int>;                                  // (arrival minute, truck id), the order Stations serve in
+    using Outbox = std::vector<TimeWarpMessage>;                             // Messages of one thread to one destination
+    static constexpr int kNeverRolledBack = std::numeric_limits<int>::max(); // GVT once no event or message is left
+    const int horizon = m_config.horizonMins;
+    const int numGroups = std::clamp(m_numWorkerThreads, 1, std::max(m_numTrucks, 1)); // Threads, each running a range of Truck processes
+    const int trucksPerGroup = (m_numTrucks + numGroups - 1) / numGroups;
+
+    std::vector<Truck> trucks;                                                                // Current state of every Truck, possibly speculative
+    std::vector<TruckHistory> histories(m_numTrucks);                                         // Uncommitted history of every Truck process
+    std::vector<TimeWarpCalendar> calendars(numGroups);                                       // Truck events of each thread
+    std::vector<TimeWarpInbox> groupInboxes(numGroups);                                       // Pickups for the Trucks of each thread
+    TimeWarpInbox stationInbox;                                                               // Arrivals for the Station process, which runs on thread 0
+    std::vector<std::vector<Outbox>> outboxes(numGroups, std::vector<Outbox>(numGroups + 1)); // Undelivered messages of each thread, the Station process last
+    std::vector<TimeWarpStats> groupStats(numGroups, TimeWarpStats{});                        // Counters of each thread
+    std::vector<long long> groupSavedStates(numGroups, 0);                                    // Truck snapshots held by each thread
+    std::vector<int> localMinimums(numGroups, 0);                                             // Earliest unprocessed time of each thread at a GVT round
+    std::vector<long long> localSavedStates(numGroups, 0);                                    // Saved states of each thread at a GVT round
+    std::barrier gvtBarrier(numGroups);                                                       // Stops every thread for a GVT round
+
+    std::vector<Station> stations;                                                            // Stations indexed by id, committed serves only
+    WorkloadRecursion recursion(m_numStations, m_config.unloadTimeMins);                      // FIFO queue of the Stations, serves logged for rollback
+    std::map<ArrivalKey, int> pendingArrivals;                                                // Arrivals not served yet, with their helium
+    std::deque<ServedArrival> servedArrivals;                                                 // Serves not committed yet, in serve order
+    std::map<ArrivalKey, std::array<int, 2>> lazyPickups;                                     // Pickup minute and Station sent for arrivals a rollback took back
+
+    for (TimeWarpCalendar &calendar : calendars)
+    {
+        calendar.dueEvents.resize(horizon);
+    }
+    trucks.reserve(m_numTrucks);
+    for (int id = 0; id < m_numTrucks; ++id)
+    {
+        trucks.push_back(makeTruck(id));
+        calendars[id / trucksPerGroup].dueEvents[0].push_back({id, 0}); // All trucks start mining simultaneously
+    }
+    stations.reserve(m_numStations);
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        stations.emplace_back(i);
+    }
+
+    // Messages are batched per destination and delivered once per drain, always before a GVT round
+    auto sendToStation = [&](const int group, const TimeWarpMessage &message)
+    {
+        outboxes[group][numGroups].push_back(message);
+    };
+    auto sendToTruck = [&](const TimeWarpMessage &message)
+    {
+        outboxes[0][message.truckId / trucksPerGroup].push_back(message); // Only the Station process on thread 0 sends pickups
+    };
+    auto deliver = [&](const int group)
+    {
+        for (int destination = 0; destination <= numGroups; ++destination)
+        {
+            Outbox &outbox = outboxes[group][destination];
+            if (outbox.empty())
+            {
+                continue;
+            }
+            TimeWarpInbox &inbox = (destination == numGroups) ? stationInbox : groupInboxes[destination];
+            std::lock_guard<std::mutex> lock(inbox.mutex);
+            inbox.messages.insert(inbox.messages.end(), outbox.begin(), outbox.end());
+            outbox.clear();
+        }
+    };
+    auto schedule = [&](const int group, const int time, const int id)
+    {
+        TimeWarpCalendar &calendar = calendars[group];
+        calendar.dueEvents[time].push_back({id, histories[id].generation});
+        calendar.cursor = std::min(calendar.cursor, time);
+    };
+
+    // Station process: undo the serves from the newest back to the given arrival
+    auto rollbackStation = [&](const ArrivalKey &key, const bool isKeyUndone)
+    {
+        TimeWarpStats &stats = groupStats[0];
+        bool isRolledBack = false;
+        while (!servedArrivals.empty())
+        {
+            const ServedArrival &served = servedArrivals.back();
+            const ArrivalKey servedKey{served.time, served.truckId};
+            if (servedKey < key || (servedKey == key && !isKeyUndone))
+            {
+                break;
+            }
+            recursion.undoLastServe();
+            pendingArrivals.emplace(servedKey, served.minedHelium);
+            lazyPickups[servedKey] = {served.pickupTime, served.stationId}; // Cancelled only if serving again changes it
+            servedArrivals.pop_back();
+            ++stats.numUndoneServes;
+            isRolledBack = true;
+        }
+        if (isRolledBack)
+        {
+            ++stats.numRollbacks;
+        }
+    };
+
+    // Station process: an arrival behind a served one is a straggler, an anti-message takes its arrival back
+    auto receiveAtStation = [&](const TimeWarpMessage &message)
+    {
+        const ArrivalKey key{message.arrivalTime, message.truckId};
+        rollbackStation(key, message.isAnti);
+        if (!message.isAnti)
+        {
+            pendingArrivals.emplace(key, message.value);
+            return;
+        }
+        pendingArrivals.erase(key);
+        const auto lazy = lazyPickups.find(key);
+        if (lazy != lazyPickups.end())
+        {
+            sendToTruck({lazy->second[0], message.truckId, message.arrivalTime, lazy->second[1], true});
+            ++groupStats[0].numAntiMessages;
+            lazyPickups.erase(lazy);
+        }
+    };
+
+    // Station process: serve the earliest pending arrival
+    auto serveNextArrival = [&]()
+    {
+        const auto next = pendingArrivals.begin();
+        const ArrivalKey key = next->first;
+        const int minedHelium = next->second;
+        pendingArrivals.erase(next);
+
+        int stationId = 0;
+        const int pickupTime = recursion.serveReversibly(key.first, stationId);
+        servedArrivals.push_back({key.first, key.second, minedHelium, pickupTime, stationId});
+
+        const auto lazy = lazyPickups.find(key);
+        if (lazy != lazyPickups.end())
+        {
+            const bool isUnchanged = (lazy->second == std::array<int, 2>{pickupTime, stationId});
+            if (!isUnchanged)
+            {
+                sendToTruck({lazy->second[0], key.second, key.first, lazy->second[1], true});
+                ++groupStats[0].numAntiMessages;
+            }
+            lazyPickups.erase(lazy);
+            if (isUnchanged)
+            {
+                return; // The Truck already holds this pickup
+            }
+        }
+        sendToTruck({pickupTime, key.second, key.first, stationId, false});
+    };
+
+    // Station process: serves before the GVT are final, count them at their Stations
+    auto commitStation = [&](const int gvt)
+    {
+        std::size_t numCommitted = 0;
+        while (numCommitted < servedArrivals.size() && servedArrivals[numCommitted].time < gvt)
+        {
+            const ServedArrival &served = servedArrivals[numCommitted++];
+            Station &unloadStation = stations[served.stationId];
+            unloadStation.incrementTotalTrucksUnloaded();
+            unloadStation.setTotalHeliumReceived(unloadStation.getTotalHeliumReceived() + served.minedHelium);
+        }
+        servedArrivals.erase(servedArrivals.begin(), servedArrivals.begin() + numCommitted);
+        recursion.commitServes(numCommitted);
+    };
+
+    // Truck process: save the Truck, then end its wait; snapshots before the GVT can no longer be restored
+    auto applyPickup = [&](const int group, const TimeWarpMessage &pickup, const int gvt)
+    {
+        TruckHistory &history = histories[pickup.truckId];
+        Truck &truck = trucks[pickup.truckId];
+        std::size_t numCommitted = 0;
+        while (numCommitted < history.snapshots.size() && history.snapshots[numCommitted].pickup.time < gvt)
+        {
+            ++numCommitted;
+        }
+        history.snapshots.erase(history.snapshots.begin(), history.snapshots.begin() + numCommitted);
+        history.snapshots.push_back({pickup, truck});
+        groupSavedStates[group] += 1 - static_cast<long long>(numCommitted);
+
+        recordUnload(pickup.time, truck, pickup.value, pickup.time - pickup.arrivalTime);
+        history.awaitedArrival = -1;
+
+        const int leaveTime = pickup.time + m_config.unloadTimeMins;
+        if (leaveTime < horizon)
+        {
+            schedule(group, leaveTime, pickup.truckId);
+        }
+    };
+
+    // Truck process: apply the pickup of the trip the Truck waits for, if it came already
+    auto applyAwaitedPickup = [&](const int group, const int id, const int gvt)
+    {
+        TruckHistory &history = histories[id];
+        if (history.awaitedArrival < 0)
+        {
+            return;
+        }
+        for (auto pickup = history.pickups.begin(); pickup != history.pickups.end(); ++pickup)
+        {
+            if (pickup->arrivalTime == history.awaitedArrival)
+            {
+                const TimeWarpMessage awaited = *pickup;
+                history.pickups.erase(pickup);
+                applyPickup(group, awaited, gvt);
+                return;
+            }
+        }
+    };
+
+    // Truck process: an anti-message annihilates a pickup still waiting, or rolls the Truck back to before it
+    auto receiveAtTruck = [&](const int group, const TimeWarpMessage &message, const int gvt)
+    {
+        TruckHistory &history = histories[message.truckId];
+        if (!message.isAnti)
+        {
+            history.pickups.push_back(message);
+            applyAwaitedPickup(group, message.truckId, gvt);
+            return;
+        }
+        for (auto pickup = history.pickups.begin(); pickup != history.pickups.end(); ++pickup)
+        {
+            if (pickup->arrivalTime == message.arrivalTime)
+            {
+                history.pickups.erase(pickup);
+                return;
+            }
+        }
+
+        std::size_t index = history.snapshots.size();
+        while (index > 0 && history.snapshots[index - 1].pickup.arrivalTime != message.arrivalTime)
+        {
+            --index;
+        }
+        if (index == 0)
+        {
+            return; // Every message is sent before its anti-message, so this cannot happen
+        }
+        --index;
+
+        // Pickups of later trips go back to wait for their own anti-messages
+        for (std::size_t later = index + 1; later < history.snapshots.size(); ++later)
+        {
+            history.pickups.push_back(history.snapshots[later].pickup);
+        }
+        trucks[message.truckId] = history.snapshots[index].truck;
+        history.awaitedArrival = message.arrivalTime;
+        ++history.generation;
+        groupSavedStates[group] -= static_cast<long long>(history.snapshots.size() - index);
+        history.snapshots.erase(history.snapshots.begin() + index, history.snapshots.end());
+        while (!history.sentArrivals.empty() && history.sentArrivals.back() > history.awaitedArrival)
+        {
+            sendToStation(group, {history.sentArrivals.back(), message.truckId, history.sentArrivals.back(), 0, true});
+            ++groupStats[group].numAntiMessages;
+            history.sentArrivals.pop_back();
+        }
+        ++groupStats[group].numRollbacks;
+        applyAwaitedPickup(group, message.truckId, gvt);
+    };
+
+    // Truck process: advance a Truck, announcing every departure to the Station process
+    auto processTruckEvent = [&](const int group, const int now, const TimeWarpEvent &event, const int gvt)
+    {
+        TruckHistory &history = histories[event.truckId];
+        Truck &truck = trucks[event.truckId];
+        const Truck::State currentState = truck.getCurrentState();
+        const int nextTime = now + advanceTruckState(truck, now);
+        if (currentState == Truck::State::UNLOADING)
+        {
+            truck.setIsInDataQueue(true); // Waits for its pickup
+            history.awaitedArrival = now;
+            applyAwaitedPickup(group, event.truckId, gvt);
+            return;
+        }
+        if (nextTime < horizon)
+        {
+            if (currentState == Truck::State::TRAVEL_TO_UNLOAD_STATION)
+            {
+                const auto committed = std::find_if(history.sentArrivals.begin(), history.sentArrivals.end(), [gvt](const int arrivalTime)
+                                                    { return arrivalTime >= gvt; });
+                history.sentArrivals.erase(history.sentArrivals.begin(), committed);
+                history.sentArrivals.push_back(nextTime);
+                sendToStation(group, {nextTime, event.truckId, nextTime, truck.getCurrentMinedHelium(), false});
+            }
+            schedule(group, nextTime, event.truckId);
+        }
+    };
+
+    // Minute of the earliest live event of a thread's Trucks, stale events of rolled back Trucks are dropped on the way
+    auto peekTruckEvent = [&](const int group)
+    {
+        TimeWarpCalendar &calendar = calendars[group];
+        for (; calendar.cursor < horizon; ++calendar.cursor)
+        {
+            std::vector<TimeWarpEvent> &due = calendar.dueEvents[calendar.cursor];
+            while (!due.empty() && due.back().generation != histories[due.back().truckId].generation)
+            {
+                due.pop_back();
+            }
+            if (!due.empty())
+            {
+                return calendar.cursor;
+            }
+        }
+        return kNeverRolledBack;
+    };
+
+    // Rounds of speculative events, each ended by a GVT computation and fossil collection
+    auto runGroup = [&](const int group)
+    {
+        TimeWarpInbox &inbox = groupInboxes[group];
+        std::vector<TimeWarpMessage> received;
+        int gvt = 0;
+        while (true)
+        {
+            const int limit = (gvt > kNeverRolledBack - kOptimismWindowMins) ? kNeverRolledBack : gvt + kOptimismWindowMins;
+            for (int numProcessed = 0; numProcessed < kEventsPerRound;)
+            {
+                if (group == 0)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(stationInbox.mutex);
+                        received.swap(stationInbox.messages);
+                    }
+                    for (const TimeWarpMessage &message : received)
+                    {
+                        receiveAtStation(message);
+                    }
+                    received.clear();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(inbox.mutex);
+                    received.swap(inbox.messages);
+                }
+                for (const TimeWarpMessage &message : received)
+                {
+                    receiveAtTruck(group, message, gvt);
+                }
+                received.clear();
+
+                // Lowest timestamp first across the thread's processes, so only other threads cause stragglers
+                int numDrainProcessed = 0;
+                for (; numDrainProcessed < kEventsPerDrain; ++numDrainProcessed)
+                {
+                    const int truckTime = peekTruckEvent(group);
+                    const int arrivalTime = (group == 0 && !pendingArrivals.empty()) ? pendingArrivals.begin()->first.first : kNeverRolledBack;
+                    if (std::min(truckTime, arrivalTime) >= limit)
+                    {
+                        break;
+                    }
+                    if (arrivalTime < truckTime)
+                    {
+                        serveNextArrival();
+                        continue;
+                    }
+                    const TimeWarpEvent event = calendars[group].dueEvents[truckTime].back();
+                    calendars[group].dueEvents[truckTime].pop_back();
+                    processTruckEvent(group, truckTime, event, gvt);
+                }
+                deliver(group);
+                if (numDrainProcessed == 0)
+                {
+                    break; // Nothing left before the limit, wait for the GVT to move
+                }
+                numProcessed += numDrainProcessed;
+            }
+
+            // No thread sends while the others take their minimum, so no message is in flight
+            gvtBarrier.arrive_and_wait();
+            int localMinimum = peekTruckEvent(group);
+            {
+                std::lock_guard<std::mutex> lock(inbox.mutex);
+                for (const TimeWarpMessage &message : inbox.messages)
+                {
+                    localMinimum = std::min(localMinimum, message.time);
+                }
+            }
+            localSavedStates[group] = groupSavedStates[group];
+            if (group == 0)
+            {
+                if (!pendingArrivals.empty())
+                {
+                    localMinimum = std::min(localMinimum, pendingArrivals.begin()->first.first);
+                }
+                std::lock_guard<std::mutex> lock(stationInbox.mutex);
+                for (const TimeWarpMessage &message : stationInbox.messages)
+                {
+                    localMinimum = std::min(localMinimum, message.time);
+                }
+                localSavedStates[group] += static_cast<long long>(servedArrivals.size());
+            }
+            localMinimums[group] = localMinimum;
+            gvtBarrier.arrive_and_wait();
+
+            gvt = *std::min_element(localMinimums.begin(), localMinimums.end());
+            if (group == 0)
+            {
+                TimeWarpStats &stats = groupStats[0];
+                ++stats.numGvtRounds;
+                long long savedStates = 0;
+                for (const long long groupStates : localSavedStates)
+                {
+                    savedStates += groupStates;
+                }
+                stats.peakSavedStates = std::max(stats.peakSavedStates, savedStates);
+                commitStation(gvt);
+            }
+            if (gvt == kNeverRolledBack)
+            {
+                break; // Every process is done and nothing can roll it back
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int group = 1; group < numGroups; ++group)
+    {
+        threads.emplace_back(runGroup, group);
+    }
+    runGroup(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const TimeWarpStats &stats : groupStats)
+    {
+        m_timeWarpStats.numRollbacks += stats.numRollbacks;
+        m_timeWarpStats.numUndoneServes += stats.numUndoneServes;
+        m_timeWarpStats.numAntiMessages += stats.numAntiMessages;
+        m_timeWarpStats.numGvtRounds += stats.numGvtRounds;
+        m_timeWarpStats.peakSavedStates += stats.peakSavedStates;
+    }
+
+    // Every truck has reached 72 hours, print results in id order
+    for (const Truck &finishedTruck : trucks)
+    {
+        addTruck(finishedTruck);
+        printTruckResults(finishedTruck, horizon);
+    }
+
+    // Print out results from each station after simulation is complete
+    for (const auto &station : stations)
+    {
+        addStation(station);
+        printStationResults(station);
+    }
+}
+
+void Simulator::simulateCoroutines()
+{
+    VirtualScheduler scheduler;
+    StationQueue stationQueue(scheduler);
+    std::vector<Truck> trucks;     // Trucks indexed by id, referenced by their actors
+    std::vector<Station> stations; // Stations indexed by id, referenced by their actors
+    int activeTrucks = m_numTrucks;
+
+    trucks.reserve(m_numTrucks);
+    for (int i = 0; i < m_numTrucks; ++i)
+    {
+        trucks.push_back(makeTruck(i));
+        scheduler.spawn(truckActor(scheduler, stationQueue, trucks.back(), activeTrucks));
+    }
+    stations.reserve(m_numStations);
+    for (int i = 0; i < m_numStations; ++i)
+    {
+        stations.emplace_back(i);
+        scheduler.spawn(stationActor(scheduler, stationQueue, stations.back()));
+    }
+    // Without trucks no actor would ever close the queue, so the stations would never report
+    if (activeTrucks == 0)
+    {
+        stationQueue.close();
+    }
+
+    scheduler.run();
+}
+
+SimTask Simulator::truckActor(VirtualScheduler &scheduler, StationQueue &stationQueue, Truck &miningTruck, int &activeTrucks)
+{
+    int elapsedTime = 0; // Initialize to 0 to simulate the start of simulation time
+    int sleepTime = 0;
+
+    while (elapsedTime < m_config.horizonMins)
+    {
+        Truck::State currentState = miningTruck.getCurrentState();
+        sleepTime = advanceTruckState(miningTruck, elapsedTime);
+
+        if (currentState == Truck::State::UNLOADING)
+        {
+            // Suspend until a station picks this truck up
+            miningTruck.setIsInDataQueue(true);
+            elapsedTime += co_await stationQueue.push(miningTruck);
+        }
+        // Corner case check - cap the sleep duration so that the truck stops at 72 hours
+        if ((elapsedTime + sleepTime) > m_config.horizonMins)
+        {
+            sleepTime = (m_config.horizonMins - elapsedTime);
+        }
+
+        co_await scheduler.delay(sleepTime); // Must simulate truck's action
+        elapsedTime += sleepTime;
+    }
+
+    addTruck(miningTruck);
+    printTruckResults(miningTruck, elapsedTime);
+
+    // Last truck lets the stations finish once the queue is drained
+    if (--activeTrucks == 0)
+    {
+        stationQueue.close();
+    }
+}
+
+SimTask Simulator::stationActor(VirtualScheduler &scheduler, StationQueue &stationQueue, Station &unloadStation)
+{
+    while (true)
+    {
+        StationQueue::Pickup pickup = co_await stationQueue.pop();
+        if (pickup.truck == nullptr)
+        {
+            break; // Simulation time is finished and queue is empty
+        }
+        Truck *truck = pickup.truck;
+
+        recordUnload(scheduler.now(), *truck, unloadStation, pickup.queueWaitMins);
+
+        co_await scheduler.delay(m_config.unloadTimeMins); // Simulate unloading time
+    }
+
+    addStation(unloadStation);
+    printStationResults(unloadStation);
+}
+
+template <typename TruckType>
+int Simulator::advanceTruckState(TruckType &truck, const int elapsedTime)
+{
+    int sleepTime = 0;
+    const Truck::State oldState = truck.getCurrentState();
+
+    switch (oldState)
+    {
+    case Truck::State::MINING:
+    {
+        // Update truck's member vars accordingly
+        const int miningTime = Site::getRandomMinedDuration(truck.getRandomStream(), m_config.minMiningMins, m_config.maxMiningMins);
+        truck.setCurrentMiningTime(miningTime);                                              // Set randomly generated mining duration from the truck's own stream
+        truck.setCurrentMinedHelium(truck.getCurrentMiningTime() * m_config.heliumPerMin);   // Set helium mined during duration
+        truck.setTotalMiningTime(truck.getCurrentMiningTime() + truck.getTotalMiningTime()); // Update total mining time
+        truck.saveMiningDuration(truck.getCurrentMiningTime());                              // Add timing time to vector for unit testing
+
+        sleepTime = truck.getCurrentMiningTime(); // Use member var for sleepTime
+        debugLog("Mining truck id = {}; state = MINING state; mining time = {}; "
+                 "current helium = {}; total mining time = {}; elapsed time = {}.",
+                 truck.getId(), sleepTime,
+                 truck.getCurrentMinedHelium(),
+                 truck.getTotalMiningTime(), elapsedTime);
+        truck.setCurrentState(Truck::State::TRAVEL_TO_UNLOAD_STATION); // Update trucks state the next state
+        break;
+    }
+    case Truck::State::TRAVEL_TO_MINING_SITE:
+    {
+        sleepTime = m_config.travelTimeMins;
+        debugLog("Mining truck id = {}; state = TRAVEL_TO_MINING_SITE; "
+                 "sleep time = {}; elapsed time = {}.",
+                 truck.getId(), sleepTime, elapsedTime);
+        truck.setCurrentState(Truck::State::MINING); // Update trucks state the next state
+        break;
+    }
+    case Truck::State::TRAVEL_TO_UNLOAD_STATION:
+    {
+        sleepTime = m_config.travelTimeMins;
+        debugLog(
+            "Mining truck id = {}; state = TRAVEL_TO_UNLOAD_STATION; "
+            "sleepTime = {}; elapsed time = {}.",
+            truck.getId(), sleepTime, elapsedTime);
+        truck.setCurrentState(Truck::State::UNLOADING); // Update trucks state the next state
+        break;
+    }
+    case Truck::State::UNLOADING:
+    {
+        sleepTime = m_config.unloadTimeMins;
+        truck.setTotalMinedHelium(truck.getTotalMinedHelium() + truck.getCurrentMinedHelium());
+        debugLog(
+            "Mining truck id = {}; state = UNLOADING; current_helium = {}; "
+            "total_helium = {}; total mining time = {}; elapsed time = {}.",
+            truck.getId(), truck.getCurrentMinedHelium(),
+            truck.getTotalMinedHelium(), truck.getTotalMiningTime(), elapsedTime);
+
+        truck.setCurrentState(Truck::State::TRAVEL_TO_MINING_SITE); // Update trucks state the next state
+        break;
+    }
+    default:
+    {
+        sleepTime = 0;
+        debugLog(
+            "Error! Mining truck id = {} unknown truck state.", truck.getId());
+        break;
+    }
+    }
+
+    // Leaving UNLOADING is traced by the station that picks the truck up
+    if (oldState != Truck::State::UNLOADING)
+    {
+        traceTransition(elapsedTime, truck, -1, oldState, 0);
+    }
+
+    return sleepTime;
+}
+
+template <typename TruckType>
+void Simulator::recordUnload(const int time, TruckType &truck, Station &unloadStation, const int queueWaitMins)
+{
+    // Successful unloading of truck, update station accordingly
+    unloadStation.incrementTotalTrucksUnloaded();
+    unloadStation.setTotalHeliumReceived(unloadStation.getTotalHeliumReceived() + truck.getCurrentMinedHelium());
+    recordUnload(time, truck, unloadStation.getId(), queueWaitMins);
+}
+
+template <typename TruckType>
+void Simulator::recordUnload(const int time, TruckType &truck, const int stationId, const int queueWaitMins)
+{
+    truck.setCurrentTripQueueWait(queueWaitMins);
+    truck.incrementTotalNumberUnloads();
+    truck.setTotalQueueWait(truck.getTotalQueueWait() + truck.getCurrentTripQueueWait());
+    debugLog("Station id = {}; unloading truck id = {}; currentTripQueueWait = {}; "
+             "current helium = {}; totalQueueWait = {}; "
+             "totalSuccessfulUnloads = {}; elapsed time = {}.",
+             stationId, truck.getId(), truck.getCurrentTripQueueWait(),
+             truck.getCurrentMinedHelium(), truck.getTotalQueueWait(),
+             truck.getTotalNumberUnloads(), time);
+    traceTransition(time, truck, stationId, Truck::State::UNLOADING, queueWaitMins);
+    truck.setCurrentTripQueueWait(0); // Reset truck's current queue wait back to 0
+    truck.setIsInDataQueue(false);    // Reset flag so that Truck sees it has been processed
+}
+
+template <typename TruckType>
+void Simulator::traceTransition(const int time, const TruckType &truck, const int stationId,
+                                const Truck::State oldState, const int queueWait)
+{
+    if (!m_traceFile)
+    {
+        return;
+    }
+
+    TraceRecord record{};
+    record.timestamp = time;
+    record.truckId = truck.getId();
+    record.stationId = stationId;
+    record.helium = truck.getCurrentMinedHelium();
+    record.queueWait = queueWait;
+    record.oldState = static_cast<std::uint8_t>(oldState);
+    record.newState = static_cast<std::uint8_t>(truck.getCurrentState());
+    m_traceFile->write(record);
+}
+
+void Simulator::printTruckResults(const Truck &truck, const int truckElapsedTime) const
+{
+    if (m_summaryOut == nullptr)
+    {
+        return;
+    }
+
+    double averageQueueTime = truck.calculateAverageQueueTime(truck.getTotalQueueWait(), m_config.horizonMins);
+    double truckEfficiency = static_cast<double>((truck.getTotalMinedHelium()) / static_cast<double>(Simulator::calcMaxHeliumPossible(m_config)));
+    const RunningStats &miningStats = truck.getMiningStats();
+    std::lock_guard<ProfiledMutex> lock(m_summaryMutex);
+
+    *m_summaryOut << "TRUCK " << truck.getId() << " FINAL RESULTS:" << std::endl
+                  << "Total Helium Mined                       = " << truck.getTotalMinedHelium() << std::endl
+                  << "Total Mining Duration                    = " << truck.getTotalMiningTime() << " minutes" << std::endl
+                  << "Calculated Mining Duration for Checking  = " << truck.calculateTotalMiningDuration() << " minutes" << std::endl
+                  << "Mining Duration Mean / Std Dev           = "
+                  << std::fixed << std::setprecision(2) << miningStats.getMean() << " / " << miningStats.getStdDev() << " minutes" << std::endl
+                  << "Mining Duration Min / Max                = " << miningStats.getMin() << " / " << miningStats.getMax() << " minutes" << std::endl
+                  << "Total Successful Unloaded Trips          = " << truck.getTotalNumberUnloads() << std::endl
+                  << "Total Time Spent Waiting in Queue        = " << truck.getTotalQueueWait() << " minutes" << std::endl
+                  << "Average Time Spent Waiting in Queue      = "
+                  << std::fixed << std::setprecision(2) << truck.convertToPercent(averageQueueTime) << "%" << std::endl
+                  << "Maximum Helium Possible                  = " << Simulator::calcMaxHeliumPossible(m_config) << std::endl
+                  << "Maximum Unloaded Trips Possible          = " << Simulator::calcMaxTripsPossible(m_config) << std::endl
+                  << "Truck Efficiency                         = "
+                  << std::fixed << std::setprecision(2) << truck.convertToPercent(truckEfficiency) << "%" << std::endl
+                  << "Truck Ending Elapsed Time                = " << truckElapsedTime
+                  << std::endl
+                  << std::endl;
+}
+
+Truck Simulator::makeTruck(const int id) const
+{
+    Truck truck(id, m_seed);
+    truck.setKeepMiningHistory(m_isMiningHistoryKept);
+    truck.setMiningStats(RunningStats(m_config.minMiningMins, m_config.maxMiningMins)); // Histogram over the configured durations
+    return truck;
+}
+
+Fleet Simulator::makeFleet() const
+{
+    Fleet fleet(m_numTrucks, m_seed);
+    fleet.setKeepMiningHistory(m_isMiningHistoryKept);
+    fleet.setMiningStatsRange(m_config.minMiningMins, m_config.maxMiningMins);
+    return fleet;
+}
+
+void Simulator::printPacingResults() const
+{
+    if (m_summaryOut == nullptr)
+    {
+        return;
+    }
+
+    const RealTimePacer::DriftReport report = m_pacer.getDriftReport();
+    const auto toMicroseconds = [](const std::chrono::nanoseconds duration)
+    { return std::chrono::duration<double, std::micro>(duration).count(); };
+    std::lock_guard<ProfiledMutex> lock(m_summaryMutex);
+    *m_summaryOut << "REAL-TIME PACING RESULTS:" << std::endl
+                  << std::fixed << std::setprecision(2)
+                  << "Wall Time per Simulated Minute           = " << toMicroseconds(m_pacer.getWallTimePerMinute()) << " us" << std::endl
+                  << "Deadlines Slept Until                    = " << report.numWakeUps << std::endl
+                  << "Mean Wake-up Drift                       = " << toMicroseconds(report.meanDrift) << " us" << std::endl
+                  << "Max Wake-up Drift                        = " << toMicroseconds(report.maxDrift) << " us" << std::endl
+                  << "Wake-up Latency Compensation             = " << toMicroseconds(report.wakeUpLatency) << " us" << std::endl
+                  << std::endl;
+}
+
+#ifdef DEBUG
+void Simulator::printLockResults()
+{
+    if (m_summaryOut == nullptr)
+    {
+        return;
+    }
+
+    std::vector<ProfiledMutex::Profile> profiles;
+    profiles.push_back(m_resultsMutex.getProfile());
+    if (m_traceFile)
+    {
+        profiles.push_back(m_traceFile->getLockProfile());
+    }
+    if (m_debugLogger)
+    {
+        m_debugLogger->flush();
+        profiles.push_back(m_debugLogger->getLockProfile());
+    }
+    profiles.push_back(m_summaryMutex.getProfile()); // Taken last, so every result printed so far is counted
+
+    const auto toMicroseconds = [](const double nanoseconds)
+    { return nanoseconds / 1000.0; };
+    std::lock_guard<ProfiledMutex> lock(m_summaryMutex);
+    for (const ProfiledMutex::Profile &profile : profiles)
+    {
+        const double contendedPercent = (profile.numAcquisitions == 0) ? 0.0 : 100.0 * profile.numContended / profile.numAcquisitions;
+        const HdrHistogram &wait = profile.waitHistogram;
+        const HdrHistogram &hold = profile.holdHistogram;
+        *m_summaryOut << "LOCK " << profile.name << " CONTENTION RESULTS:" << std::endl
+                      << std::fixed << std::setprecision(2)
+                      << "Acquisitions                             = " << profile.numAcquisitions << std::endl
+                      << "Contended Acquisitions                   = " << profile.numContended << " (" << contendedPercent << "%)" << std::endl
+                      << "Total Wait Time                          = " << toMicroseconds(profile.totalWait.count()) << " us" << std::endl
+                      << "Wait p50 / p99 / Max                     = " << toMicroseconds(wait.getValueAtPercentile(50.0)) << " / "
+                      << toMicroseconds(wait.getValueAtPercentile(99.0)) << " / " << toMicroseconds(wait.getMax()) << " us" << std::endl
+                      << "Total Hold Time                          = " << toMicroseconds(profile.totalHold.count()) << " us" << std::endl
+                      << "Hold p50 / p99 / Max                     = " << toMicroseconds(hold.getValueAtPercentile(50.0)) << " / "
+                      << toMicroseconds(hold.getValueAtPercentile(99.0)) << " / " << toMicroseconds(hold.getMax()) << " us" << std::endl
+                      << std::endl;
+    }
+
+    if (m_engineMode != EngineMode::THREADED)
+    {
+        return; // Only THREADED blocks threads on its queues
+    }
+
+    struct BlockingWait
+    {
+        const char *name;          // Name the wait is reported under
+        const HdrHistogram &waits; // Nanoseconds per wait
+        int numThreads;            // Threads that wait this way
+    };
+    const BlockingWait blockingWaits[] = {{"truckUnloadWait", m_truckUnloadWaits, m_numTrucks},
+                                          {"stationIdleWait", m_stationIdleWaits, m_numStations}};
+
+    // Blocked share of the time the threads of a kind live, the paced horizon each
+    const std::chrono::nanoseconds pacedHorizon = m_pacer.getWallTimePerMinute() * m_config.horizonMins;
+    for (const BlockingWait &blockingWait : blockingWaits)
+    {
+        const HdrHistogram &waits = blockingWait.waits;
+        const double threadTime = static_cast<double>(pacedHorizon.count()) * blockingWait.numThreads;
+        const double blockedPercent = (threadTime <= 0.0) ? 0.0 : 100.0 * static_cast<double>(waits.getTotal()) / threadTime;
+        *m_summaryOut << "BLOCKING " << blockingWait.name << " RESULTS:" << std::endl
+                      << std::fixed << std::setprecision(2)
+                      << "Waits                                    = " << waits.getCount() << std::endl
+                      << "Total Wait Time                          = " << toMicroseconds(static_cast<double>(waits.getTotal())) << " us" << std::endl
+                      << "Share of Thread Time                     = " << blockedPercent << "%" << std::endl
+                      << "Wait p50 / p99 / Max                     = " << toMicroseconds(waits.getValueAtPercentile(50.0)) << " / "
+                      << toMicroseconds(waits.getValueAtPercentile(99.0)) << " / " << toMicroseconds(waits.getMax()) << " us" << std::endl
+                      << std::endl;
+    }
+}
+#endif
+
+void Simulator::printStationResults(const Station &station) const
+{
+    if (m_summaryOut == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<ProfiledMutex> lock(m_summaryMutex);
+    *m_summaryOut << "STATION " << station.getId() << " FINAL RESULTS:" << std::endl
+                  << "Total Helium Received                    = " << station.getTotalHeliumReceived() << std::endl
+                  << "Total Trucks Unloaded                    = " << station.getTotalTrucksUnloaded() << std::endl
+                  << std::endl;
 }
\ No newline at end of file
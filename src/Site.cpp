@@ -7,8 +7,19 @@
 // --------------------------------------------------------
 int Site::getRandomMinedDuration()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // One generator per thread, trucks may be advanced concurrently
+    static thread_local std::random_device rd;
+    static thread_local std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(kMinMiningMinutes, kMaxMiningMinutes);
     return dis(gen);
+}
+
+int Site::getRandomMinedDuration(RandomStream &randomStream)
+{
+    return getRandomMinedDuration(randomStream, kMinMiningMinutes, kMaxMiningMinutes);
+}
+
+int Site::getRandomMinedDuration(RandomStream &randomStream, const int minMinutes, const int maxMinutes)
+{
+    return randomStream.nextInRange(minMinutes, maxMinutes);
 }
\ No newline at end of file
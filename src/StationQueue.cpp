@@ -0,0 +1,60 @@
+#include "../include/StationQueue.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+void StationQueue::close()
+{
+    m_isClosed = true;
+    while (!m_stations.empty())
+    {
+        WaitingStation station = m_stations.front();
+        m_stations.pop_front();
+        *station.pickup = {nullptr, 0};
+        m_scheduler.schedule(station.handle, m_scheduler.now());
+    }
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+void StationQueue::pushTruck(Truck &truck, std::coroutine_handle<> handle, int *queueWaitMins)
+{
+    m_trucks.push_back({&truck, m_scheduler.now(), handle, queueWaitMins});
+
+    // Hand the truck straight to an idle station if there is one
+    if (!m_stations.empty())
+    {
+        WaitingStation station = m_stations.front();
+        m_stations.pop_front();
+        tryPopTruck(*station.pickup);
+        m_scheduler.schedule(station.handle, m_scheduler.now());
+    }
+}
+
+bool StationQueue::tryPopTruck(Pickup &pickup)
+{
+    if (m_trucks.empty())
+    {
+        if (m_isClosed)
+        {
+            pickup = {nullptr, 0};
+            return true; // Station does not need to wait, it is done
+        }
+        return false;
+    }
+
+    WaitingTruck waitingTruck = m_trucks.front();
+    m_trucks.pop_front();
+
+    // Queue wait is the time between joining the queue and being picked up
+    pickup = {waitingTruck.truck, m_scheduler.now() - waitingTruck.arrivalTime};
+    *waitingTruck.queueWaitMins = pickup.queueWaitMins;
+    m_scheduler.schedule(waitingTruck.handle, m_scheduler.now());
+    return true;
+}
+
+void StationQueue::waitForTruck(std::coroutine_handle<> handle, Pickup *pickup)
+{
+    m_stations.push_back({handle, pickup});
+}
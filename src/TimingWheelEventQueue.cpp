@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <bit>
+
+#include "../include/TimingWheelEventQueue.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+void TimingWheelEventQueue::push(const Event &event)
+{
+    place(event);
+    ++m_size;
+}
+
+Event TimingWheelEventQueue::pop()
+{
+    if (m_readyHead == m_ready.size())
+    {
+        advance();
+    }
+
+    const Event event = m_ready[m_readyHead++];
+    if (m_readyHead == m_ready.size())
+    {
+        m_ready.clear();
+        m_readyHead = 0;
+    }
+    --m_size;
+    return event;
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+void TimingWheelEventQueue::place(const Event &event)
+{
+    if (event.getTime() <= m_now)
+    {
+        // Due now, keep the ready list in firing order
+        if (m_readyHead == m_ready.size() || !(event < m_ready.back()))
+        {
+            m_ready.push_back(event);
+        }
+        else
+        {
+            m_ready.insert(std::upper_bound(m_ready.begin() + m_readyHead, m_ready.end(), event), event);
+        }
+        return;
+    }
+
+    // The highest bit that differs from the current minute picks the level
+    const std::uint32_t difference = static_cast<std::uint32_t>(event.getTime()) ^ static_cast<std::uint32_t>(m_now);
+    const int level = (std::bit_width(difference) - 1) / kSlotBits;
+    const int slot = (event.getTime() >> (level * kSlotBits)) & (kNumSlots - 1);
+    m_slots[level][slot].push_back(event);
+    m_occupied[level] |= std::uint64_t{1} << slot;
+}
+
+void TimingWheelEventQueue::advance()
+{
+    int level = 0;
+    while (m_readyHead == m_ready.size() && level < kNumLevels)
+    {
+        // Next occupied slot of this level after the one holding the current minute
+        const int shift = level * kSlotBits;
+        const int currentSlot = (m_now >> shift) & (kNumSlots - 1);
+        const std::uint64_t laterSlots = (currentSlot == kNumSlots - 1) ? 0 : m_occupied[level] & (~std::uint64_t{0} << (currentSlot + 1));
+        if (laterSlots == 0)
+        {
+            ++level;
+            continue;
+        }
+
+        const int slot = std::countr_zero(laterSlots);
+        const std::uint64_t upperBits = (static_cast<std::uint64_t>(m_now) >> (shift + kSlotBits)) << (shift + kSlotBits);
+        m_now = static_cast<int>(upperBits | (static_cast<std::uint64_t>(slot) << shift));
+        m_occupied[level] &= ~(std::uint64_t{1} << slot);
+
+        if (level == 0)
+        {
+            // Every Event of a level 0 slot is due at the new minute, the swap hands the slot the ready list's spare capacity
+            m_ready.swap(m_slots[0][slot]);
+            m_readyHead = 0;
+            std::sort(m_ready.begin(), m_ready.end());
+        }
+        else
+        {
+            // Cascade to the lower levels, then look again from level 0
+            m_cascade.swap(m_slots[level][slot]);
+            for (const Event &event : m_cascade)
+            {
+                place(event);
+            }
+            m_cascade.clear();
+            level = 0;
+        }
+    }
+}
\ No newline at end of file
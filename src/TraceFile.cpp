@@ -0,0 +1,93 @@
+#include <cstring>
+
+#include "../include/TraceFile.h"
+
+namespace
+{
+    constexpr char kMagic[4] = {'M', 'T', 'R', 'C'};
+}
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+TraceFile::TraceFile(const std::string &path) : m_file(path, std::ios::binary | std::ios::trunc), m_mutex("traceFileMutex")
+{
+    m_buffer.reserve(kBufferedRecords);
+
+    TraceFileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.recordSize = sizeof(TraceRecord);
+    m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+TraceFile::~TraceFile()
+{
+    flush();
+}
+
+void TraceFile::write(const TraceRecord &record)
+{
+    std::lock_guard<ProfiledMutex> lock(m_mutex);
+    m_buffer.push_back(record);
+    if (m_buffer.size() >= kBufferedRecords)
+    {
+        flushLocked();
+    }
+}
+
+void TraceFile::flush()
+{
+    std::lock_guard<ProfiledMutex> lock(m_mutex);
+    flushLocked();
+    m_file.flush();
+}
+
+bool TraceFile::read(const std::string &path, std::vector<TraceRecord> &records)
+{
+    std::ifstream file(path, std::ios::binary);
+    TraceFileHeader header{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion || header.recordSize != sizeof(TraceRecord))
+    {
+        return false;
+    }
+
+    TraceRecord record{};
+    while (file.read(reinterpret_cast<char *>(&record), sizeof(record)))
+    {
+        records.push_back(record);
+    }
+    return true;
+}
+
+const char *TraceFile::getStateName(const std::uint8_t state)
+{
+    switch (state)
+    {
+    case Truck::State::MINING:
+        return "MINING";
+    case Truck::State::TRAVEL_TO_UNLOAD_STATION:
+        return "TRAVEL_TO_UNLOAD_STATION";
+    case Truck::State::UNLOADING:
+        return "UNLOADING";
+    case Truck::State::TRAVEL_TO_MINING_SITE:
+        return "TRAVEL_TO_MINING_SITE";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+void TraceFile::flushLocked()
+{
+    if (!m_buffer.empty())
+    {
+        m_file.write(reinterpret_cast<const char *>(m_buffer.data()),
+                     static_cast<std::streamsize>(m_buffer.size() * sizeof(TraceRecord)));
+        m_buffer.clear();
+    }
+}
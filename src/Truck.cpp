@@ -16,10 +16,5 @@ double Truck::convertToPercent(const double value) const
 
 int Truck::calculateTotalMiningDuration() const
 {
-    int totalCalcMiningDur = 0;
-    for (const auto &miningDuration : m_miningDurations)
-    {
-        totalCalcMiningDur += miningDuration;
-    }
-    return totalCalcMiningDur;
+    return static_cast<int>(m_miningStats.getSum());
 }
\ No newline at end of file
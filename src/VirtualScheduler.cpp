@@ -0,0 +1,21 @@
+#include "../include/VirtualScheduler.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+void VirtualScheduler::schedule(std::coroutine_handle<> handle, const int time)
+{
+    m_ready.push({time, m_sequence++, handle});
+}
+
+void VirtualScheduler::run()
+{
+    while (!m_ready.empty())
+    {
+        ScheduledCoroutine next = m_ready.top();
+        m_ready.pop();
+
+        m_now = next.time; // Jump the clock straight to the next resume time
+        next.handle.resume();
+    }
+}
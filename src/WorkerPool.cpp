@@ -0,0 +1,131 @@
+#include <algorithm>
+
+#include "../include/WorkerPool.h"
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+WorkerPool::WorkerPool(const int numWorkers) : m_numWorkers(std::max(1, numWorkers)), m_body(nullptr),
+                                               m_pendingChunks(0), m_generation(0), m_isStopping(false)
+{
+    for (int i = 0; i < m_numWorkers; ++i)
+    {
+        m_deques.push_back(std::make_unique<WorkerDeque>());
+    }
+
+    // Worker 0 is whichever thread calls parallelFor()
+    for (int i = 1; i < m_numWorkers; ++i)
+    {
+        m_threads.emplace_back([this, i]()
+                               { this->workerLoop(i); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    m_isStopping = true;
+    m_generation++;
+    m_generation.notify_all();
+
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::parallelFor(const int count, const std::function<void(int, int)> &body, const int minParallelCount)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    if (m_numWorkers == 1 || count < minParallelCount)
+    {
+        body(0, count); // Not worth waking the workers
+        return;
+    }
+
+    // Deal the chunks out round robin before waking anyone
+    const int numChunks = std::min(count, m_numWorkers * kChunksPerWorker);
+    m_body = &body;
+    m_pendingChunks = numChunks;
+    for (int i = 0; i < numChunks; ++i)
+    {
+        WorkerDeque &deque = *m_deques[i % m_numWorkers];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        deque.chunks.push_back({static_cast<int>(static_cast<long long>(count) * i / numChunks),
+                                static_cast<int>(static_cast<long long>(count) * (i + 1) / numChunks)});
+    }
+    m_generation++;
+    m_generation.notify_all();
+
+    // Help out, then wait for chunks still running on other workers
+    while (runOneChunk(0))
+    {
+    }
+    while (m_pendingChunks.load(std::memory_order_acquire) > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+void WorkerPool::workerLoop(const int index)
+{
+    unsigned seenGeneration = 0;
+    while (true)
+    {
+        m_generation.wait(seenGeneration);
+        seenGeneration = m_generation.load();
+        if (m_isStopping)
+        {
+            return;
+        }
+
+        while (runOneChunk(index))
+        {
+        }
+    }
+}
+
+bool WorkerPool::runOneChunk(const int index)
+{
+    Chunk chunk{0, 0};
+    bool hasChunk = false;
+
+    // Own chunks first, newest first while it is still warm in cache
+    {
+        WorkerDeque &own = *m_deques[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty())
+        {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            hasChunk = true;
+        }
+    }
+
+    // Otherwise steal the oldest chunk of the next worker that has one
+    for (int i = 1; i < m_numWorkers && !hasChunk; ++i)
+    {
+        WorkerDeque &victim = *m_deques[(index + i) % m_numWorkers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty())
+        {
+            chunk = victim.chunks.front();
+            victim.chunks.pop_front();
+            hasChunk = true;
+        }
+    }
+
+    if (!hasChunk)
+    {
+        return false;
+    }
+
+    (*m_body)(chunk.first, chunk.last);
+    m_pendingChunks.fetch_sub(1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../include/WorkloadRecursion.h"
+
+namespace
+{
+    constexpr int kWordBits = 64;      // Stations per bitmask word
+    constexpr int kSummaryPadding = 4; // Summary words per AVX2 register, the summary is padded to a multiple
+}
+
+// --------------------------------------------------------
+// Public Member Functions
+// --------------------------------------------------------
+WorkloadRecursion::WorkloadRecursion(const int numStations, const int unloadTimeMins)
+    : m_unloadTimeMins(unloadTimeMins), m_busyFreeTimes(numStations, 0), m_busyIds(numStations, 0), m_busyHead(0), m_numBusy(0),
+      m_lastPickupTime(0), m_idleWords((numStations + kWordBits - 1) / kWordBits, 0)
+{
+    const std::size_t numSummaryWords = (m_idleWords.size() + kWordBits - 1) / kWordBits;
+    m_idleSummary.assign(((numSummaryWords + kSummaryPadding - 1) / kSummaryPadding) * kSummaryPadding, 0);
+    for (int id = 0; id < numStations; ++id)
+    {
+        setIdle(id, true);
+    }
+}
+
+int WorkloadRecursion::serve(const int arrivalTime, int &stationId)
+{
+    return serve(arrivalTime, stationId, false);
+}
+
+int WorkloadRecursion::serveReversibly(const int arrivalTime, int &stationId)
+{
+    return serve(arrivalTime, stationId, true);
+}
+
+void WorkloadRecursion::undoLastServe()
+{
+    const std::size_t numStations = m_busyFreeTimes.size();
+    const UndoRecord record = m_undoLog.back();
+    m_undoLog.pop_back();
+
+    // The served Station was appended at the back of the ring
+    --m_numBusy;
+    std::size_t back = m_busyHead + m_numBusy;
+    if (back >= numStations)
+    {
+        back -= numStations;
+    }
+    setIdle(m_busyIds[back], true);
+
+    // Released Stations go back to the front, newest first
+    for (int i = 0; i < record.numReleased; ++i)
+    {
+        const std::array<int, 2> released = m_releasedStations.back();
+        m_releasedStations.pop_back();
+        m_busyHead = (m_busyHead == 0) ? numStations - 1 : m_busyHead - 1;
+        m_busyFreeTimes[m_busyHead] = released[0];
+        m_busyIds[m_busyHead] = released[1];
+        ++m_numBusy;
+        setIdle(released[1], false);
+    }
+    m_lastPickupTime = record.lastPickupTime;
+}
+
+void WorkloadRecursion::commitServes(const std::size_t numServes)
+{
+    for (std::size_t i = 0; i < numServes; ++i)
+    {
+        m_releasedStations.erase(m_releasedStations.begin(), m_releasedStations.begin() + m_undoLog.front().numReleased);
+        m_undoLog.pop_front();
+    }
+}
+
+const char *WorkloadRecursion::getInstructionSet()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+// --------------------------------------------------------
+// Private Member Functions
+// --------------------------------------------------------
+int WorkloadRecursion::serve(const int arrivalTime, int &stationId, const bool isLogged)
+{
+    // Idle Stations were free by the previous pickup, otherwise wait for the earliest busy one; FIFO never picks up earlier
+    const std::size_t numStations = m_busyFreeTimes.size();
+    const int pickupTime = std::max(arrivalTime, (m_numBusy < numStations) ? m_lastPickupTime : m_busyFreeTimes[m_busyHead]);
+    int numReleased = 0;
+    if (isLogged)
+    {
+        m_undoLog.push_back({m_lastPickupTime, 0});
+    }
+    m_lastPickupTime = pickupTime;
+
+    // Stations that are free by the pickup become idle
+    while (m_numBusy > 0 && m_busyFreeTimes[m_busyHead] <= pickupTime)
+    {
+        if (isLogged)
+        {
+            m_releasedStations.push_back({m_busyFreeTimes[m_busyHead], m_busyIds[m_busyHead]});
+            ++numReleased;
+        }
+        setIdle(m_busyIds[m_busyHead], true);
+        m_busyHead = (m_busyHead + 1 == numStations) ? 0 : m_busyHead + 1;
+        --m_numBusy;
+    }
+
+    // This unload ends after every other one, so it goes to the back of the ring
+    stationId = findIdleStation();
+    setIdle(stationId, false);
+    std::size_t back = m_busyHead + m_numBusy;
+    if (back >= numStations)
+    {
+        back -= numStations;
+    }
+    m_busyFreeTimes[back] = pickupTime + m_unloadTimeMins;
+    m_busyIds[back] = stationId;
+    ++m_numBusy;
+    if (isLogged)
+    {
+        m_undoLog.back().numReleased = numReleased;
+    }
+    return pickupTime;
+}
+
+void WorkloadRecursion::setIdle(const int id, const bool isIdle)
+{
+    const int word = id / kWordBits;
+    const std::uint64_t bit = std::uint64_t{1} << (id % kWordBits);
+    const std::uint64_t summaryBit = std::uint64_t{1} << (word % kWordBits);
+    if (isIdle)
+    {
+        m_idleWords[word] |= bit;
+        m_idleSummary[word / kWordBits] |= summaryBit;
+    }
+    else if ((m_idleWords[word] &= ~bit) == 0)
+    {
+        m_idleSummary[word / kWordBits] &= ~summaryBit;
+    }
+}
+
+int WorkloadRecursion::findIdleStation() const
+{
+    // Lowest Stations are handed out first and stay busy, so the idle ones tend to have high ids
+    const std::uint64_t *summary = m_idleSummary.data();
+    const std::size_t numSummaryWords = m_idleSummary.size();
+    std::size_t first = 0;
+#if defined(__AVX2__)
+    for (; first + 4 <= numSummaryWords; first += 4)
+    {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(summary + first));
+        if (!_mm256_testz_si256(words, words))
+        {
+            break;
+        }
+    }
+#elif defined(__SSE2__)
+    for (; first + 2 <= numSummaryWords; first += 2)
+    {
+        const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i *>(summary + first));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(words, _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+    }
+#endif
+    while (summary[first] == 0)
+    {
+        ++first;
+    }
+
+    const int word = static_cast<int>(first) * kWordBits + std::countr_zero(summary[first]);
+    return word * kWordBits + std::countr_zero(m_idleWords[word]);
+}
\ No newline at end of file
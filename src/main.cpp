@@ -1,6 +1,15 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
 
 #include "../include/Simulator.h"
+#include "../include/FleetSweep.h"
+#include "../include/RunOptions.h"
+#include "../include/QueueingEstimator.h"
 
 // Function to get a valid integer input from the user
 int getValidIntegerInput(const std::string &prompt)
@@ -24,14 +33,207 @@ int getValidIntegerInput(const std::string &prompt)
     }
 }
 
-int main()
+// Function to parse a "first:last[:step]" range
+bool parseRange(const std::string &text, FleetSweep::Range &range)
 {
-    // To speed up simuation time, we assume 1 minute of simulation time is equal to 1 millisecond of CPU time
-    const int numTrucks = getValidIntegerInput("Enter the number of mining trucks: ");
-    const int numStations = getValidIntegerInput("Enter the number of unloading stations: ");
+    std::istringstream stream(text);
+    char separator = 0;
+    range.step = 1;
+    if (!(stream >> range.first >> separator >> range.last) || separator != ':' || range.first <= 0 || range.last < range.first)
+    {
+        return false;
+    }
+    if (stream >> separator && (separator != ':' || !(stream >> range.step) || range.step <= 0))
+    {
+        return false;
+    }
+    return true;
+}
 
-    Simulator miningSim(numTrucks, numStations);
-    miningSim.startSimulator();
+// Function to parse the "--key value" flags and config file following the positional arguments of a mode
+bool parseTrailingOptions(int argc, char *argv[], int firstOption, RunOptions &options, std::string &error)
+{
+    std::vector<const char *> arguments{argv[0]};
+    arguments.insert(arguments.end(), argv + firstOption, argv + argc);
+    return options.parseArguments(static_cast<int>(arguments.size()), arguments.data(), error) && options.config.validate(error);
+}
+
+// Function to evaluate a whole grid of fleet sizes, e.g. MiningSimulator --sweep 10:100:10 1:20 [replications] [--config FILE]
+int runSweep(int argc, char *argv[])
+{
+    const std::string csvPath = "../log/Mining_Simulator_Sweep.csv";
+    FleetSweep::Range truckRange{};
+    FleetSweep::Range stationRange{};
+    int numReplications = 1;
+    const bool hasReplications = argc > 4 && std::string(argv[4]).rfind("--", 0) != 0;
+    if (argc < 4 || !parseRange(argv[2], truckRange) || !parseRange(argv[3], stationRange) ||
+        (hasReplications && !RunOptions::parsePositiveInteger(argv[4], numReplications)))
+    {
+        std::cerr << "Usage: " << argv[0] << " --sweep <trucks first:last[:step]> <stations first:last[:step]> [replications] [--OPTION VALUE]..." << std::endl;
+        return 1;
+    }
+
+    std::string error;
+    RunOptions options;
+    if (!parseTrailingOptions(argc, argv, hasReplications ? 5 : 4, options, error))
+    {
+        std::cerr << error << std::endl
+                  << std::endl
+                  << RunOptions::getUsage(argv[0]);
+        return 1;
+    }
+
+    // Checked before the sweep, which can run for minutes
+    std::ofstream csvFile(csvPath);
+    if (!csvFile.is_open())
+    {
+        std::cerr << "Cannot open sweep file " << csvPath << "." << std::endl;
+        return 1;
+    }
+
+    FleetSweep sweep(truckRange, stationRange);
+    sweep.setNumReplications(numReplications);
+    sweep.setConfig(options.config);
+    if (options.hasSeed)
+    {
+        sweep.setMasterSeed(options.seed);
+    }
+    if (!sweep.run(error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    sweep.writeCsv(csvFile);
+    sweep.printKnees(std::cout);
+    return 0;
+}
+
+// Function to predict a whole grid of fleet sizes analytically, e.g. MiningSimulator --estimate 10:1000:10 1:40 [validate] [--config FILE]
+int runEstimate(int argc, char *argv[])
+{
+    FleetSweep::Range truckRange{};
+    FleetSweep::Range stationRange{};
+    const bool isValidated = argc > 4 && std::string(argv[4]) == "validate";
+    const bool hasOptions = argc > (isValidated ? 5 : 4);
+    if (argc < 4 || !parseRange(argv[2], truckRange) || !parseRange(argv[3], stationRange) ||
+        (hasOptions && std::string(argv[isValidated ? 5 : 4]).rfind("--", 0) != 0))
+    {
+        std::cerr << "Usage: " << argv[0] << " --estimate <trucks first:last[:step]> <stations first:last[:step]> [validate] [--OPTION VALUE]..." << std::endl;
+        return 1;
+    }
+
+    std::string error;
+    RunOptions options;
+    if (!parseTrailingOptions(argc, argv, isValidated ? 5 : 4, options, error))
+    {
+        std::cerr << error << std::endl
+                  << std::endl
+                  << RunOptions::getUsage(argv[0]);
+        return 1;
+    }
+
+    const QueueingEstimator estimator(options.config);
+    QueueingEstimator::writeCsvHeader(std::cout, isValidated);
+    for (int numTrucks = truckRange.first; numTrucks <= truckRange.last; numTrucks += truckRange.step)
+    {
+        for (int numStations = stationRange.first; numStations <= stationRange.last; numStations += stationRange.step)
+        {
+            if (isValidated)
+            {
+                QueueingEstimator::writeCsvRow(std::cout, numTrucks, numStations, estimator.validate(numTrucks, numStations, numTrucks * 1000ULL + numStations));
+            }
+            else
+            {
+                QueueingEstimator::writeCsvRow(std::cout, numTrucks, numStations, estimator.estimate(numTrucks, numStations));
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "--sweep")
+    {
+        return runSweep(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--estimate")
+    {
+        return runEstimate(argc, argv);
+    }
+
+    std::string error;
+    RunOptions options;
+    if (!options.parseArguments(argc, argv, error) || !options.config.validate(error))
+    {
+        std::cerr << error << std::endl
+                  << std::endl
+                  << RunOptions::getUsage(argv[0]);
+        return 1;
+    }
+    if (options.isHelpRequested)
+    {
+        std::cout << RunOptions::getUsage(argv[0]);
+        return 0;
+    }
+
+    // Only ask for the fleet when it was not given, so batch runs never block on input
+    // To speed up simuation time, 1 minute of simulation time is paced as 1 millisecond of wall time by default
+    const int numTrucks = (options.numTrucks > 0) ? options.numTrucks : getValidIntegerInput("Enter the number of mining trucks: ");
+    const int numStations = (options.numStations > 0) ? options.numStations : getValidIntegerInput("Enter the number of unloading stations: ");
+
+    Simulator miningSim(numTrucks, numStations, options.engineMode);
+    miningSim.setConfig(options.config);
+    miningSim.setEventQueue(options.eventQueueKind);
+    miningSim.setDispatchPolicy(options.dispatchKind);
+    miningSim.setTraceFile(options.tracePath);
+    if (options.hasSeed)
+    {
+        miningSim.setSeed(options.seed);
+    }
+
+    std::ofstream outputFile;
+    if (!options.outputPath.empty())
+    {
+        outputFile.open(options.outputPath);
+        if (!outputFile.is_open())
+        {
+            std::cerr << "Cannot open output file " << options.outputPath << "." << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &output = outputFile.is_open() ? static_cast<std::ostream &>(outputFile) : std::cout;
+
+    if (options.outputFormat == RunOptions::OutputFormat::TEXT)
+    {
+        if (outputFile.is_open())
+        {
+            miningSim.setSummaryOutput(outputFile);
+        }
+        if (!miningSim.startSimulator(error))
+        {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    miningSim.setWriteSummary(false);
+    if (!miningSim.startSimulator(error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    const SimulationResults results = miningSim.takeResults();
+    if (options.outputFormat == RunOptions::OutputFormat::CSV)
+    {
+        results.writeCsv(output);
+    }
+    else
+    {
+        results.writeJson(output);
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -4,6 +4,38 @@
 #include "../include/Site.h"
 #include "../include/Station.h"
 #include "../include/Truck.h"
+#include "../include/MpmcQueue.h"
+#include "../include/UnloadTicket.h"
+#include "../include/AsyncLogger.h"
+#include "../include/TraceFile.h"
+#include "../include/RandomStream.h"
+#include "../include/ReplicationRunner.h"
+#include "../include/FleetSweep.h"
+#include "../include/Fleet.h"
+#include "../include/FixedStepKernel.h"
+#include "../include/RunningStats.h"
+#include "../include/SimulationResults.h"
+#include "../include/RealTimePacer.h"
+#include "../include/RunOptions.h"
+#include "../include/SimulatorT.h"
+#include "../include/EventQueue.h"
+#include "../include/CalendarEventQueue.h"
+#include "../include/QueueingEstimator.h"
+#include "../include/WorkloadRecursion.h"
+#include "../include/Dispatcher.h"
+#include "../include/HdrHistogram.h"
+#include "../include/ProfiledMutex.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <type_traits>
 
 TEST_CASE("Random Number Generator.")
 {
@@ -73,4 +105,1696 @@ TEST_CASE("Mining Simulation for 30 trucks and 3 station.")
     // Check if summation of all successful unloaded trips by trucks is equal to number of trucks processed
     // by the stations
     REQUIRE(totalStationUnloadSum == totalTruckUnloadSum);
+}
+
+// Checks the per-truck bounds and the truck/station totals shared by every engine
+static void requireConsistentTotals(const Simulator &miningSim, const int numTrucks, const int numStations)
+{
+    std::vector<Truck> trucks = miningSim.getTrucks();
+    std::vector<Station> stations = miningSim.getStations();
+
+    REQUIRE(trucks.size() == static_cast<std::size_t>(numTrucks));
+    REQUIRE(stations.size() == static_cast<std::size_t>(numStations));
+
+    int totalStationHeliumSum = 0;
+    int totalTruckHeliumSum = 0;
+    int totalStationUnloadSum = 0;
+    int totalTruckUnloadSum = 0;
+
+    for (auto &truck : trucks)
+    {
+        REQUIRE(truck.getTotalMinedHelium() <= Simulator::calcMaxHeliumPossible(miningSim.getConfig()));
+        REQUIRE(truck.getTotalNumberUnloads() <= Simulator::calcMaxTripsPossible(miningSim.getConfig()));
+        REQUIRE(truck.getTotalQueueWait() >= 0);
+        REQUIRE(truck.getTotalMiningTime() == truck.calculateTotalMiningDuration());
+
+        totalTruckHeliumSum += truck.getTotalMinedHelium();
+        totalTruckUnloadSum += truck.getTotalNumberUnloads();
+    }
+
+    for (auto &station : stations)
+    {
+        totalStationHeliumSum += station.getTotalHeliumReceived();
+        totalStationUnloadSum += station.getTotalTrucksUnloaded();
+    }
+
+    REQUIRE(totalStationHeliumSum == totalTruckHeliumSum);
+    REQUIRE(totalStationUnloadSum == totalTruckUnloadSum);
+}
+
+TEST_CASE("Event-driven Mining Simulation for 30 trucks and 3 station.")
+{
+    int numTrucks = 30;
+    int numStations = 3;
+
+    Simulator miningSim(numTrucks, numStations, Simulator::EngineMode::EVENT_DRIVEN);
+    miningSim.startSimulator();
+
+    requireConsistentTotals(miningSim, numTrucks, numStations);
+
+    // Without queueing every truck must reach the minimum possible helium and unloads
+    for (auto &truck : miningSim.getTrucks())
+    {
+        REQUIRE(truck.getTotalMinedHelium() >= miningSim.calcMinHeliumPossible());
+        REQUIRE(truck.getTotalNumberUnloads() >= miningSim.calcMinTripsPossible());
+    }
+}
+
+TEST_CASE("Event-driven Mining Simulation with station contention.")
+{
+    // 200 trucks on a single station forces long queues
+    Simulator miningSim(200, 1, Simulator::EngineMode::EVENT_DRIVEN);
+    miningSim.startSimulator();
+
+    requireConsistentTotals(miningSim, 200, 1);
+
+    int totalQueueWait = 0;
+    for (auto &truck : miningSim.getTrucks())
+    {
+        totalQueueWait += truck.getTotalQueueWait();
+    }
+    REQUIRE(totalQueueWait > 0);
+
+    // One station can unload at most once every kUnloadTimeMins, plus the trucks still queued at the 72 hour mark
+    REQUIRE(miningSim.getStations()[0].getTotalTrucksUnloaded() <= (Simulator::kMaxMiningDurationMins / Simulator::kUnloadTimeMins) + 200);
+}
+
+TEST_CASE("Blocking unload tickets.")
+{
+    // A waiting truck sleeps until the station completes its ticket and then sees the recorded wait
+    Truck waitingTruck(7);
+    UnloadTicket ticket;
+    ticket.issue(waitingTruck);
+    REQUIRE(&ticket.getTruck() == &waitingTruck);
+    REQUIRE(ticket.getQueueWaitMins() == 0);
+
+    std::atomic<bool> isReleased(false);
+    int observedWait = -1;
+    std::thread truckThread([&ticket, &isReleased, &observedWait]()
+                            {
+        ticket.waitForCompletion();
+        isReleased = true;
+        observedWait = ticket.getQueueWaitMins(); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE_FALSE(isReleased.load());
+    ticket.complete(12);
+    truckThread.join();
+    REQUIRE(isReleased.load());
+    REQUIRE(observedWait == 12);
+
+    // Reissuing clears the previous trip
+    ticket.issue(waitingTruck);
+    REQUIRE(ticket.getQueueWaitMins() == 0);
+    ticket.complete(3);
+    ticket.waitForCompletion();
+    REQUIRE(ticket.getQueueWaitMins() == 3);
+
+    // 20 threaded trucks on one station have to queue for it
+    Simulator miningSim(20, 1);
+    miningSim.setSeed(3);
+    miningSim.setWriteSummary(false);
+    miningSim.setTimeScale(std::chrono::microseconds(20));
+    miningSim.startSimulator();
+
+    requireConsistentTotals(miningSim, 20, 1);
+
+    int totalQueueWait = 0;
+    for (auto &truck : miningSim.getTrucks())
+    {
+        totalQueueWait += truck.getTotalQueueWait();
+    }
+    REQUIRE(totalQueueWait > 0);
+}
+
+TEST_CASE("Lock-free unload queue.")
+{
+    MpmcQueue<int> queue(3);
+    REQUIRE(queue.getCapacity() == 4);
+
+    // Single thread: first in, first out and bounded
+    int value = 0;
+    REQUIRE_FALSE(queue.tryPop(value));
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.tryPush(i));
+    }
+    REQUIRE_FALSE(queue.tryPush(4));
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.tryPop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.tryPop(value));
+
+    // Several producers and consumers: every pushed value is popped exactly once
+    const int numThreads = 4;
+    const int numPerThread = 10000;
+    MpmcQueue<int> sharedQueue(64);
+    std::atomic<long long> poppedSum(0);
+    std::atomic<int> poppedCount(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&sharedQueue, t]()
+                             {
+            for (int i = 1; i <= numPerThread; ++i)
+            {
+                while (!sharedQueue.tryPush(t * numPerThread + i))
+                {
+                    std::this_thread::yield();
+                }
+            } });
+        threads.emplace_back([&sharedQueue, &poppedSum, &poppedCount]()
+                             {
+            int item = 0;
+            while (poppedCount.load() < numThreads * numPerThread)
+            {
+                if (sharedQueue.tryPop(item))
+                {
+                    poppedSum += item;
+                    poppedCount++;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const long long total = static_cast<long long>(numThreads) * numPerThread;
+    REQUIRE(poppedCount.load() == total);
+    REQUIRE(poppedSum.load() == total * (total + 1) / 2);
+}
+
+TEST_CASE("Worker pool Mining Simulation for 5000 trucks and 50 stations.")
+{
+    int numTrucks = 5000;
+    int numStations = 50;
+
+    Simulator miningSim(numTrucks, numStations, Simulator::EngineMode::WORKER_POOL);
+    miningSim.setNumWorkerThreads(4);
+    miningSim.startSimulator();
+
+    requireConsistentTotals(miningSim, numTrucks, numStations);
+
+    // Every truck id is reported exactly once
+    std::vector<bool> seenTruckIds(numTrucks, false);
+    for (auto &truck : miningSim.getTrucks())
+    {
+        REQUIRE_FALSE(seenTruckIds[truck.getId()]);
+        seenTruckIds[truck.getId()] = true;
+    }
+}
+
+
+TEST_CASE("Coroutine Mining Simulation for 30 trucks and 3 station.")
+{
+    int numTrucks = 30;
+    int numStations = 3;
+
+    Simulator miningSim(numTrucks, numStations, Simulator::EngineMode::COROUTINE);
+    miningSim.startSimulator();
+
+    requireConsistentTotals(miningSim, numTrucks, numStations);
+
+    for (auto &truck : miningSim.getTrucks())
+    {
+        REQUIRE(truck.getTotalMinedHelium() >= miningSim.calcMinHeliumPossible());
+        REQUIRE(truck.getTotalNumberUnloads() >= miningSim.calcMinTripsPossible());
+    }
+
+    // Contended fleet: trucks must queue and every station must drain its share
+    Simulator contendedSim(200, 2, Simulator::EngineMode::COROUTINE);
+    contendedSim.startSimulator();
+
+    requireConsistentTotals(contendedSim, 200, 2);
+    int totalQueueWait = 0;
+    for (auto &truck : contendedSim.getTrucks())
+    {
+        totalQueueWait += truck.getTotalQueueWait();
+    }
+    REQUIRE(totalQueueWait > 0);
+
+    // Without trucks the stations still finish and report
+    Simulator emptySim(0, 3, Simulator::EngineMode::COROUTINE);
+    emptySim.setWriteSummary(false);
+    emptySim.startSimulator();
+
+    requireConsistentTotals(emptySim, 0, 3);
+    for (auto &station : emptySim.getStations())
+    {
+        REQUIRE(station.getTotalTrucksUnloaded() == 0);
+    }
+}
+
+
+TEST_CASE("Asynchronous debug logger.")
+{
+    std::ostringstream output;
+    {
+        AsyncLogger logger(output);
+
+        // Several threads log at once, every line must arrive intact
+        const int numThreads = 4;
+        const int numPerThread = 1000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([&logger, t]()
+                                 {
+                for (int i = 0; i < numPerThread; ++i)
+                {
+                    logger.log("thread = {}; message = {}", t, i);
+                } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        logger.flush();
+
+        std::istringstream lines(output.str());
+        std::string line;
+        int numLines = 0;
+        while (std::getline(lines, line))
+        {
+            REQUIRE(line.rfind("thread = ", 0) == 0);
+            numLines++;
+        }
+        REQUIRE(numLines == numThreads * numPerThread); // Rings grow to hold a burst instead of dropping it
+        REQUIRE(logger.getDroppedMessages() == 0);
+
+        // Messages longer than a slot are truncated, not overflowed
+        output.str("");
+        logger.log("{}", std::string(AsyncLogger::kMaxMessageLength * 2, 'x'));
+        logger.flush();
+        REQUIRE(output.str() == std::string(AsyncLogger::kMaxMessageLength, 'x') + "\n");
+
+        // A ring that may not grow drops what does not fit and reports it on the next flush
+        std::ostringstream smallOutput;
+        AsyncLogger smallLogger(smallOutput, 2, 4);
+        const int numSmallMessages = 10000;
+        for (int i = 0; i < numSmallMessages; ++i)
+        {
+            smallLogger.log("message = {}", i);
+        }
+        const int numDropped = static_cast<int>(smallLogger.getDroppedMessages());
+        smallLogger.flush();
+
+        std::istringstream smallLines(smallOutput.str());
+        int numSmallLines = 0;
+        while (std::getline(smallLines, line))
+        {
+            if (line.rfind("message = ", 0) == 0)
+            {
+                numSmallLines++;
+            }
+            else
+            {
+                REQUIRE(line.rfind("AsyncLogger dropped " + std::to_string(numDropped) + " ", 0) == 0);
+            }
+        }
+        REQUIRE(numSmallLines + numDropped == numSmallMessages);
+        REQUIRE(smallLogger.getDroppedMessages() == 0);
+
+#ifdef DEBUG
+        // Once every thread is registered the drain thread no longer takes the registry lock
+        const std::size_t numAcquisitions = logger.getLockProfile().numAcquisitions;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        logger.flush();
+        REQUIRE(logger.getLockProfile().numAcquisitions == numAcquisitions);
+#endif
+    }
+}
+
+TEST_CASE("Binary event trace.")
+{
+    const std::string tracePath = "Mining_Simulator_Test_Trace.bin";
+    int numTrucks = 30;
+    int numStations = 3;
+
+    Simulator miningSim(numTrucks, numStations, Simulator::EngineMode::EVENT_DRIVEN);
+    miningSim.setTraceFile(tracePath);
+    REQUIRE(miningSim.startSimulator());
+
+    std::vector<TraceRecord> records;
+    REQUIRE(TraceFile::read(tracePath, records));
+    REQUIRE_FALSE(records.empty());
+
+    // Every record is a valid step of the Truck state machine
+    int numUnloadRecords = 0;
+    for (const auto &record : records)
+    {
+        REQUIRE(record.newState == (record.oldState + 1) % 4);
+        REQUIRE(record.timestamp >= 0);
+        if (record.oldState == Truck::State::UNLOADING)
+        {
+            REQUIRE(record.stationId >= 0);
+            REQUIRE(record.stationId < numStations);
+            numUnloadRecords++;
+        }
+        else
+        {
+            REQUIRE(record.stationId == -1);
+        }
+    }
+
+    // One unload record per successful unload
+    int totalTruckUnloadSum = 0;
+    for (auto &truck : miningSim.getTrucks())
+    {
+        totalTruckUnloadSum += truck.getTotalNumberUnloads();
+    }
+    REQUIRE(numUnloadRecords == totalTruckUnloadSum);
+
+    std::remove(tracePath.c_str());
+
+    // A trace that cannot be opened fails the run instead of losing the records
+    const std::string badTracePath = "Mining_Simulator_Missing_Folder/Trace.bin";
+    Simulator badTraceSim(numTrucks, numStations, Simulator::EngineMode::ARRIVAL_STREAM);
+    badTraceSim.setTraceFile(badTracePath);
+    badTraceSim.setWriteSummary(false);
+    std::string error;
+    REQUIRE_FALSE(badTraceSim.startSimulator(error));
+    REQUIRE(error.find(badTracePath) != std::string::npos);
+    REQUIRE(badTraceSim.getTrucks().empty());
+}
+
+
+TEST_CASE("Seeded random streams.")
+{
+    // Same seed and stream id replay the same numbers, always within the mining range
+    RandomStream first(42, 7);
+    RandomStream second(42, 7);
+    RandomStream otherTruck(42, 8);
+    int numDifferent = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        int value = Site::getRandomMinedDuration(first);
+        REQUIRE(value == Site::getRandomMinedDuration(second));
+        REQUIRE(value >= Site::kMinMiningMinutes);
+        REQUIRE(value <= Site::kMaxMiningMinutes);
+        if (value != Site::getRandomMinedDuration(otherTruck))
+        {
+            numDifferent++;
+        }
+    }
+    REQUIRE(numDifferent > 900);
+
+    // Two runs with the same seed produce identical results
+    Simulator firstSim(30, 3, Simulator::EngineMode::EVENT_DRIVEN);
+    Simulator secondSim(30, 3, Simulator::EngineMode::EVENT_DRIVEN);
+    firstSim.setSeed(2024);
+    secondSim.setSeed(2024);
+    firstSim.startSimulator();
+    secondSim.startSimulator();
+
+    std::vector<Truck> firstTrucks = firstSim.getTrucks();
+    std::vector<Truck> secondTrucks = secondSim.getTrucks();
+    REQUIRE(firstTrucks.size() == secondTrucks.size());
+    for (size_t i = 0; i < firstTrucks.size(); ++i)
+    {
+        REQUIRE(firstTrucks[i].getId() == secondTrucks[i].getId());
+        REQUIRE(firstTrucks[i].getTotalMinedHelium() == secondTrucks[i].getTotalMinedHelium());
+        REQUIRE(firstTrucks[i].getTotalMiningTime() == secondTrucks[i].getTotalMiningTime());
+        REQUIRE(firstTrucks[i].getTotalQueueWait() == secondTrucks[i].getTotalQueueWait());
+        REQUIRE(firstTrucks[i].getTotalNumberUnloads() == secondTrucks[i].getTotalNumberUnloads());
+    }
+}
+
+
+
+TEST_CASE("Monte Carlo replications.")
+{
+    // Known samples: mean 5, sample standard deviation 2.138, t(7) = 2.365
+    ReplicationRunner::Statistic statistic = ReplicationRunner::summarize({2, 4, 4, 4, 5, 5, 7, 9});
+    REQUIRE(statistic.mean == Approx(5.0));
+    REQUIRE(statistic.stddev == Approx(2.13809).epsilon(0.0001));
+    REQUIRE(statistic.confidenceHalfWidth == Approx(2.365 * 2.13809 / std::sqrt(8.0)).epsilon(0.0001));
+
+    ReplicationRunner singleThreaded(30, 3, 20);
+    ReplicationRunner multiThreaded(30, 3, 20);
+    singleThreaded.setMasterSeed(7);
+    multiThreaded.setMasterSeed(7);
+    singleThreaded.setNumWorkerThreads(1);
+    multiThreaded.setNumWorkerThreads(4);
+    std::string error;
+    REQUIRE(singleThreaded.run(error));
+    REQUIRE(multiThreaded.run(error));
+
+    for (int metric = 0; metric < ReplicationRunner::kNumMetrics; ++metric)
+    {
+        // Replications are independent of the number of threads they ran on
+        std::vector<double> samples = singleThreaded.getSamples(static_cast<ReplicationRunner::Metric>(metric));
+        REQUIRE(samples.size() == 20);
+        REQUIRE(samples == multiThreaded.getSamples(static_cast<ReplicationRunner::Metric>(metric)));
+    }
+
+    // Every replication got its own seed, so the samples vary
+    ReplicationRunner::Statistic helium = singleThreaded.getStatistic(ReplicationRunner::TRUCK_HELIUM_MINED);
+    REQUIRE(helium.stddev > 0.0);
+    REQUIRE(helium.confidenceHalfWidth > 0.0);
+    REQUIRE(helium.mean > Simulator::calcMinHeliumPossible());
+    REQUIRE(helium.mean < Simulator::calcMaxHeliumPossible());
+
+    // All helium mined by the trucks is received by the stations
+    ReplicationRunner::Statistic received = singleThreaded.getStatistic(ReplicationRunner::STATION_HELIUM_RECEIVED);
+    REQUIRE(received.mean * 3 == Approx(helium.mean * 30));
+
+    // A study whose replications cannot start keeps no samples instead of zeros
+    SimulationConfig badConfig;
+    badConfig.travelTimeMins = 0;
+    ReplicationRunner badReplications(30, 3, 20);
+    badReplications.setConfig(badConfig);
+    badReplications.setNumWorkerThreads(4);
+    REQUIRE_FALSE(badReplications.run(error));
+    REQUIRE(error.find("must be positive") != std::string::npos);
+    REQUIRE(badReplications.getSamples(ReplicationRunner::TRUCK_HELIUM_MINED).empty());
+}
+
+
+TEST_CASE("Fleet sizing sweep.")
+{
+    FleetSweep sweep({50, 100, 50}, {1, 8, 1});
+    sweep.setMasterSeed(11);
+    sweep.setNumWorkerThreads(4);
+    std::string error;
+    REQUIRE(sweep.run(error));
+
+    const std::vector<FleetSweep::Cell> &cells = sweep.getCells();
+    REQUIRE(cells.size() == 16);
+    for (const FleetSweep::Cell &cell : cells)
+    {
+        REQUIRE(cell.totalHelium == Approx(cell.heliumPerTruck * cell.numTrucks));
+        REQUIRE(cell.truckEfficiency > 0.0);
+        REQUIRE(cell.truckEfficiency <= 100.0);
+        REQUIRE(cell.stationBusy > 0.0);
+    }
+
+    // More stations shorten the queue
+    REQUIRE(cells[0].queueWaitMins > cells[7].queueWaitMins);
+    REQUIRE(cells[8].queueWaitMins > cells[15].queueWaitMins);
+
+    // The knee needs more stations for more trucks and stays inside the grid
+    int smallFleetKnee = sweep.findKneeStations(50);
+    int largeFleetKnee = sweep.findKneeStations(100);
+    REQUIRE(smallFleetKnee >= 1);
+    REQUIRE(largeFleetKnee <= 8);
+    REQUIRE(smallFleetKnee <= largeFleetKnee);
+    REQUIRE(sweep.findKneeStations(75) == -1);
+
+    // One CSV header plus one line per cell
+    std::ostringstream csv;
+    sweep.writeCsv(csv);
+    std::string csvText = csv.str();
+    REQUIRE(std::count(csvText.begin(), csvText.end(), '\n') == 17);
+    REQUIRE(csvText.rfind("trucks,stations,total_helium", 0) == 0);
+
+    std::ostringstream knees;
+    sweep.printKnees(knees);
+    INFO(csvText << knees.str());
+    REQUIRE(knees.str().find("Trucks = 100") != std::string::npos);
+}
+
+
+TEST_CASE("Concurrent simulators with injected output.")
+{
+    std::ostringstream firstSummary;
+    std::ostringstream secondSummary;
+    Simulator firstSim(10, 2);
+    Simulator secondSim(20, 3);
+    firstSim.setSummaryOutput(firstSummary);
+    secondSim.setSummaryOutput(secondSummary);
+
+    // Two THREADED simulators side by side in one process
+    std::thread firstThread([&firstSim]()
+                            { firstSim.startSimulator(); });
+    std::thread secondThread([&secondSim]()
+                             { secondSim.startSimulator(); });
+    firstThread.join();
+    secondThread.join();
+
+    requireConsistentTotals(firstSim, 10, 2);
+    requireConsistentTotals(secondSim, 20, 3);
+    REQUIRE(firstSummary.str().find("Number of trucks = 10. Number of stations = 2") != std::string::npos);
+    REQUIRE(secondSummary.str().find("Number of trucks = 20. Number of stations = 3") != std::string::npos);
+    REQUIRE(firstSummary.str().find("TRUCK 9 FINAL RESULTS") != std::string::npos);
+    REQUIRE(firstSummary.str().find("TRUCK 10 FINAL RESULTS") == std::string::npos);
+    REQUIRE(secondSummary.str().find("STATION 2 FINAL RESULTS") != std::string::npos);
+
+    // The same simulator can be started again and starts from a clean state
+    firstSummary.str("");
+    firstSim.startSimulator();
+    requireConsistentTotals(firstSim, 10, 2);
+    REQUIRE(firstSummary.str().find("STATION 1 FINAL RESULTS") != std::string::npos);
+}
+
+
+TEST_CASE("Structure-of-arrays fleet.")
+{
+    // A Fleet view draws the same random stream and stores the same fields as a Truck
+    Fleet fleet(5, 99);
+    Truck truck(3, 99);
+    Fleet::TruckRef truckRef = fleet[3];
+    REQUIRE(fleet.size() == 5);
+    REQUIRE(truckRef.getId() == 3);
+    REQUIRE(truckRef.getCurrentState() == Truck::State::MINING);
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(Site::getRandomMinedDuration(truckRef.getRandomStream()) == Site::getRandomMinedDuration(truck.getRandomStream()));
+    }
+
+    truckRef.setCurrentState(Truck::State::UNLOADING);
+    truckRef.setCurrentMinedHelium(120);
+    truckRef.setTotalMinedHelium(480);
+    truckRef.setTotalMiningTime(480);
+    truckRef.saveMiningDuration(200);
+    truckRef.saveMiningDuration(280);
+    truckRef.setTotalQueueWait(15);
+    truckRef.incrementTotalNumberUnloads();
+    truckRef.incrementTotalNumberUnloads();
+
+    // Bulk passes see the same values in the columns
+    REQUIRE(fleet.getStates()[3] == Truck::State::UNLOADING);
+    REQUIRE(fleet.getCurrentHelium()[3] == 120);
+    REQUIRE(fleet.getTotalHelium()[3] == 480);
+    REQUIRE(fleet.getTotalQueueWaits()[3] == 15);
+    REQUIRE(fleet.getUnloadCounts()[3] == 2);
+    REQUIRE(fleet.getTotalHelium()[2] == 0);
+
+    Truck copy = fleet.toTruck(3);
+    REQUIRE(copy.getId() == 3);
+    REQUIRE(copy.getCurrentState() == Truck::State::UNLOADING);
+    REQUIRE(copy.getTotalMinedHelium() == 480);
+    REQUIRE(copy.getTotalMiningTime() == copy.calculateTotalMiningDuration());
+    REQUIRE(copy.getTotalQueueWait() == 15);
+    REQUIRE(copy.getTotalNumberUnloads() == 2);
+
+    // The WORKER_POOL engine keeps its trucks in a Fleet and matches the event-driven engine
+    Simulator poolSim(100, 4, Simulator::EngineMode::WORKER_POOL);
+    Simulator eventSim(100, 4, Simulator::EngineMode::EVENT_DRIVEN);
+    poolSim.setSeed(5);
+    eventSim.setSeed(5);
+    poolSim.startSimulator();
+    eventSim.startSimulator();
+    requireConsistentTotals(poolSim, 100, 4);
+
+    std::vector<Truck> poolTrucks = poolSim.getTrucks();
+    std::vector<Truck> eventTrucks = eventSim.getTrucks();
+    auto byId = [](const Truck &a, const Truck &b)
+    { return a.getId() < b.getId(); };
+    std::sort(poolTrucks.begin(), poolTrucks.end(), byId);
+    std::sort(eventTrucks.begin(), eventTrucks.end(), byId);
+    for (size_t i = 0; i < poolTrucks.size(); ++i)
+    {
+        REQUIRE(poolTrucks[i].getTotalMinedHelium() == eventTrucks[i].getTotalMinedHelium());
+        REQUIRE(poolTrucks[i].getTotalNumberUnloads() == eventTrucks[i].getTotalNumberUnloads());
+        REQUIRE(poolTrucks[i].getTotalQueueWait() == eventTrucks[i].getTotalQueueWait());
+    }
+}
+
+TEST_CASE("Fixed-step SIMD Mining Simulation.")
+{
+    // The vectorized kernel gives exactly the same result as the scalar loop
+    RandomStream randomStream(3, 0);
+    const int numTrucks = 1003; // Not a multiple of the batch size
+    std::vector<int> vectorStates(numTrucks);
+    std::vector<int> vectorTimes(numTrucks);
+    for (int i = 0; i < numTrucks; ++i)
+    {
+        vectorStates[i] = randomStream.nextInRange(0, 3);
+        vectorTimes[i] = randomStream.nextInRange(0, 60);
+    }
+    std::vector<int> scalarStates = vectorStates;
+    std::vector<int> scalarTimes = vectorTimes;
+    FixedStepKernel kernel(vectorStates.data(), vectorTimes.data(), numTrucks, 30);
+    int numRareTrucks = 0;
+    for (int now = 0; now < 200; ++now)
+    {
+        std::vector<int> vectorRareIds;
+        std::vector<int> scalarRareIds;
+        kernel.advanceTravellingTrucks(now, vectorRareIds);
+        FixedStepKernel::advanceTravellingTrucksScalar(scalarStates.data(), scalarTimes.data(), 0, numTrucks, now, 30, scalarRareIds);
+        REQUIRE(vectorRareIds == scalarRareIds);
+
+        // Stand-in for the engine's scalar path: move rare trucks on by a few minutes
+        for (const int id : vectorRareIds)
+        {
+            vectorStates[id] = scalarStates[id] = (vectorStates[id] + 1) % 4;
+            vectorTimes[id] = scalarTimes[id] = now + 1 + id % 7;
+            kernel.refreshTruck(id);
+        }
+        numRareTrucks += static_cast<int>(vectorRareIds.size());
+    }
+    REQUIRE(vectorStates == scalarStates);
+    REQUIRE(vectorTimes == scalarTimes);
+    REQUIRE(numRareTrucks > 0);
+
+    // The traced run takes the scalar path for every transition and must match the vectorized run
+    const std::string tracePath = "Mining_Simulator_Test_Fixed_Step_Trace.bin";
+    Simulator fastSim(200, 3, Simulator::EngineMode::FIXED_STEP);
+    Simulator tracedSim(200, 3, Simulator::EngineMode::FIXED_STEP);
+    fastSim.setSeed(17);
+    tracedSim.setSeed(17);
+    tracedSim.setTraceFile(tracePath);
+    fastSim.startSimulator();
+    tracedSim.startSimulator();
+    std::remove(tracePath.c_str());
+
+    requireConsistentTotals(fastSim, 200, 3);
+    std::vector<Truck> fastTrucks = fastSim.getTrucks();
+    std::vector<Truck> tracedTrucks = tracedSim.getTrucks();
+    REQUIRE(fastTrucks.size() == tracedTrucks.size());
+    for (size_t i = 0; i < fastTrucks.size(); ++i)
+    {
+        REQUIRE(fastTrucks[i].getId() == tracedTrucks[i].getId());
+        REQUIRE(fastTrucks[i].getTotalMinedHelium() == tracedTrucks[i].getTotalMinedHelium());
+        REQUIRE(fastTrucks[i].getTotalQueueWait() == tracedTrucks[i].getTotalQueueWait());
+        REQUIRE(fastTrucks[i].getTotalNumberUnloads() == tracedTrucks[i].getTotalNumberUnloads());
+    }
+}
+
+TEST_CASE("Streaming mining statistics.")
+{
+    // Welford's running mean and variance match the two-pass formulas
+    RunningStats stats(Site::kMinMiningMinutes, Site::kMaxMiningMinutes);
+    REQUIRE(stats.getCount() == 0);
+    REQUIRE(stats.getVariance() == 0.0);
+    const std::vector<int> values = {60, 75, 300, 180, 91, 299, 60, 240, 123, 350};
+    double sum = 0.0;
+    for (const int value : values)
+    {
+        stats.add(value);
+        sum += value;
+    }
+    const double mean = sum / values.size();
+    double sumSquaredDeviations = 0.0;
+    for (const int value : values)
+    {
+        sumSquaredDeviations += (value - mean) * (value - mean);
+    }
+    REQUIRE(stats.getCount() == 10);
+    REQUIRE(stats.getSum() == 1778);
+    REQUIRE(stats.getMean() == Approx(mean));
+    REQUIRE(stats.getVariance() == Approx(sumSquaredDeviations / (values.size() - 1)));
+    REQUIRE(stats.getMin() == 60);
+    REQUIRE(stats.getMax() == 350);
+
+    // Eight 31 minute buckets from 60, values past 300 land in the last one
+    REQUIRE(stats.getBucketWidth() == 31);
+    REQUIRE(stats.getBucketLowest(7) == 277);
+    const std::array<int, RunningStats::kNumBuckets> expectedHistogram = {3, 1, 1, 1, 0, 1, 0, 3};
+    REQUIRE(stats.getHistogram() == expectedHistogram);
+
+    // A Truck only keeps its durations when the full history is switched on
+    Truck truck(0, 1);
+    truck.saveMiningDuration(100);
+    truck.saveMiningDuration(200);
+    REQUIRE(truck.getMiningDurations().empty());
+    REQUIRE(truck.getMiningStats().getCount() == 2);
+    REQUIRE(truck.calculateTotalMiningDuration() == 300);
+    truck.setKeepMiningHistory(true);
+    truck.saveMiningDuration(150);
+    REQUIRE(truck.getMiningDurations() == std::vector<int>{150});
+    REQUIRE(truck.getMiningStats().getMean() == Approx(150.0));
+
+    // Engines with Trucks and with a Fleet report the same statistics, and the history agrees with them
+    for (const Simulator::EngineMode engineMode : {Simulator::EngineMode::EVENT_DRIVEN, Simulator::EngineMode::WORKER_POOL})
+    {
+        Simulator statsSim(50, 2, engineMode);
+        Simulator historySim(50, 2, engineMode);
+        statsSim.setSeed(11);
+        historySim.setSeed(11);
+        statsSim.setWriteSummary(false);
+        historySim.setWriteSummary(false);
+        historySim.setKeepMiningHistory(true);
+        statsSim.startSimulator();
+        historySim.startSimulator();
+
+        std::vector<Truck> statsTrucks = statsSim.getTrucks();
+        std::vector<Truck> historyTrucks = historySim.getTrucks();
+        auto byId = [](const Truck &a, const Truck &b)
+        { return a.getId() < b.getId(); };
+        std::sort(statsTrucks.begin(), statsTrucks.end(), byId);
+        std::sort(historyTrucks.begin(), historyTrucks.end(), byId);
+        for (size_t i = 0; i < statsTrucks.size(); ++i)
+        {
+            const RunningStats &miningStats = statsTrucks[i].getMiningStats();
+            const std::vector<int> &history = historyTrucks[i].getMiningDurations();
+            REQUIRE(statsTrucks[i].getMiningDurations().empty());
+            REQUIRE(miningStats.getCount() == static_cast<int>(history.size()));
+            REQUIRE(miningStats.getSum() == std::accumulate(history.begin(), history.end(), 0LL));
+            REQUIRE(miningStats.getMin() == *std::min_element(history.begin(), history.end()));
+            REQUIRE(miningStats.getMax() == *std::max_element(history.begin(), history.end()));
+            REQUIRE(miningStats.getMean() == Approx(historyTrucks[i].getMiningStats().getMean()));
+            REQUIRE(statsTrucks[i].getTotalMiningTime() == statsTrucks[i].calculateTotalMiningDuration());
+        }
+    }
+}
+
+TEST_CASE("Zero-copy simulation results.")
+{
+    // Coroutine Trucks finish in completion order, not in id order
+    Simulator miningSim(40, 3, Simulator::EngineMode::COROUTINE);
+    miningSim.setSeed(21);
+    miningSim.setWriteSummary(false);
+    miningSim.startSimulator();
+
+    // Views read the Simulator's own storage instead of a copy
+    const std::span<const Truck> truckView = miningSim.getTruckView();
+    const std::span<const Station> stationView = miningSim.getStationView();
+    REQUIRE(truckView.size() == 40);
+    REQUIRE(stationView.size() == 3);
+    REQUIRE(truckView.data() == miningSim.getTruckView().data());
+    long long viewHelium = 0;
+    for (const Truck &truck : truckView)
+    {
+        viewHelium += truck.getTotalMinedHelium();
+    }
+
+    // The snapshot takes the results by move, sorted by id, and leaves the Simulator empty
+    static_assert(!std::is_copy_constructible_v<SimulationResults>);
+    SimulationResults results = miningSim.takeResults();
+    REQUIRE(miningSim.getTruckView().empty());
+    REQUIRE(miningSim.getStationView().empty());
+    REQUIRE(results.getTrucks().size() == 40);
+    REQUIRE(results.getStations().size() == 3);
+    long long resultsHelium = 0;
+    for (int id = 0; id < 40; ++id)
+    {
+        REQUIRE(results.getTruck(id).getId() == id);
+        resultsHelium += results.getTruck(id).getTotalMinedHelium();
+    }
+    REQUIRE(resultsHelium == viewHelium);
+    REQUIRE(results.getStation(2).getId() == 2);
+
+    // Moving the snapshot again keeps the same Truck storage
+    const Truck *firstTruck = results.getTrucks().data();
+    const SimulationResults movedResults = std::move(results);
+    REQUIRE(movedResults.getTrucks().data() == firstTruck);
+
+    // A restarted Simulator fills its results again
+    miningSim.startSimulator();
+    requireConsistentTotals(miningSim, 40, 3);
+}
+
+TEST_CASE("Real-time pacing with drift compensation.")
+{
+    // Deadlines are absolute, so waking late once does not push back the later ones
+    RealTimePacer pacer(std::chrono::microseconds(200));
+    pacer.start();
+    REQUIRE(pacer.toWallTime(5) - pacer.toWallTime(0) == std::chrono::microseconds(1000));
+    REQUIRE(pacer.toMinutes(std::chrono::microseconds(999)) == 4);
+    const RealTimePacer::Clock::time_point start = RealTimePacer::Clock::now();
+    for (int minute = 1; minute <= 100; ++minute)
+    {
+        pacer.sleepUntilMinute(minute);
+        if (minute == 50)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(3)); // Fall behind by 15 minutes
+        }
+    }
+    const std::chrono::duration<double, std::milli> elapsed = RealTimePacer::Clock::now() - start;
+    REQUIRE(elapsed.count() >= 19.8);
+    REQUIRE(elapsed.count() < 19.8 + 50.0); // Sleep-for pacing would add the 3 ms stall plus every oversleep
+    REQUIRE(pacer.getCurrentMinute() >= 100);
+
+    const RealTimePacer::DriftReport report = pacer.getDriftReport();
+    REQUIRE(report.numWakeUps == 100);
+    REQUIRE(report.meanDrift.count() >= 0);
+    REQUIRE(report.maxDrift >= report.meanDrift);
+    REQUIRE(report.maxDrift >= std::chrono::milliseconds(2)); // Minute 51 was already overdue after the stall
+    REQUIRE(report.wakeUpLatency <= RealTimePacer::kMaxWakeUpCompensation);
+
+    // A compressed THREADED run still gives consistent totals and reports its drift
+    std::ostringstream summary;
+    Simulator miningSim(10, 2);
+    miningSim.setSeed(4);
+    miningSim.setTimeScale(std::chrono::microseconds(100));
+    miningSim.setSummaryOutput(summary);
+    const RealTimePacer::Clock::time_point runStart = RealTimePacer::Clock::now();
+    miningSim.startSimulator();
+    const std::chrono::duration<double, std::milli> runTime = RealTimePacer::Clock::now() - runStart;
+    requireConsistentTotals(miningSim, 10, 2);
+    REQUIRE(runTime.count() >= 432.0); // 72 hours at 100 us per minute
+    REQUIRE(miningSim.getDriftReport().numWakeUps > 0);
+    REQUIRE(summary.str().find("REAL-TIME PACING RESULTS:") != std::string::npos);
+    REQUIRE(summary.str().find("Wall Time per Simulated Minute           = 100.00 us") != std::string::npos);
+}
+
+TEST_CASE("Command-line and config file options.")
+{
+    const std::string configPath = "Mining_Simulator_Test_Config.ini";
+    {
+        std::ofstream configFile(configPath);
+        configFile << "# Batch run" << std::endl
+                   << "[fleet]" << std::endl
+                   << "trucks = 25" << std::endl
+                   << "stations = 2" << std::endl
+                   << "engine = EVENT_DRIVEN" << std::endl
+                   << std::endl
+                   << "[durations]" << std::endl
+                   << "; Shorter trips and a one day horizon" << std::endl
+                   << "horizon_mins = 1440" << std::endl
+                   << "travel_time_mins = 10" << std::endl
+                   << "unload_time_mins = 8" << std::endl
+                   << "seed = 99" << std::endl
+                   << "trace = Mining_Simulator_Night_Trace.bin" << std::endl;
+    }
+
+    // Flags override the config file even when given before --config
+    RunOptions options;
+    std::string error;
+    const char *arguments[] = {"MiningSimulator", "--travel-time-mins", "20", "--config", configPath.c_str(),
+                               "--format=json", "--min-mining-mins", "30"};
+    REQUIRE(options.parseArguments(8, arguments, error));
+    REQUIRE(options.numTrucks == 25);
+    REQUIRE(options.numStations == 2);
+    REQUIRE(options.engineMode == Simulator::EngineMode::EVENT_DRIVEN);
+    REQUIRE(options.outputFormat == RunOptions::OutputFormat::JSON);
+    REQUIRE(options.hasSeed);
+    REQUIRE(options.seed == 99);
+    REQUIRE(options.tracePath == "Mining_Simulator_Night_Trace.bin");
+    REQUIRE(options.config.horizonMins == 1440);
+    REQUIRE(options.config.travelTimeMins == 20);
+    REQUIRE(options.config.unloadTimeMins == 8);
+    REQUIRE(options.config.minMiningMins == 30);
+    REQUIRE(options.config.maxMiningMins == Site::kMaxMiningMinutes);
+    REQUIRE(options.config.validate(error));
+    std::remove(configPath.c_str());
+
+    // Bad input is rejected with a reason
+    RunOptions badOptions;
+    const char *unknownOption[] = {"MiningSimulator", "--speed", "3"};
+    REQUIRE_FALSE(badOptions.parseArguments(3, unknownOption, error));
+    REQUIRE(error.find("speed") != std::string::npos);
+    const char *missingValue[] = {"MiningSimulator", "--trucks"};
+    REQUIRE_FALSE(badOptions.parseArguments(2, missingValue, error));
+    REQUIRE_FALSE(badOptions.setOption("trucks", "12x", error));
+    REQUIRE_FALSE(badOptions.setOption("stations", "0", error));
+    REQUIRE_FALSE(badOptions.setOption("seed", "-1", error));
+    REQUIRE_FALSE(badOptions.setOption("engine", "quantum", error));
+    REQUIRE_FALSE(badOptions.loadConfigFile("Mining_Simulator_Missing_Config.ini", error));
+    int numReplications = 1;
+    REQUIRE_FALSE(RunOptions::parsePositiveInteger("abc", numReplications));
+    REQUIRE_FALSE(RunOptions::parsePositiveInteger("0", numReplications));
+    REQUIRE(RunOptions::parsePositiveInteger("5", numReplications));
+    REQUIRE(numReplications == 5);
+    SimulationConfig badConfig;
+    badConfig.maxMiningMins = badConfig.minMiningMins - 1;
+    REQUIRE_FALSE(badConfig.validate(error));
+
+    // The library rejects what the command line would have rejected
+    Simulator badConfigSim(5, 1, Simulator::EngineMode::EVENT_DRIVEN);
+    badConfigSim.setConfig(badConfig);
+    badConfigSim.setWriteSummary(false);
+    REQUIRE_FALSE(badConfigSim.startSimulator(error));
+    REQUIRE(error.find("mining minutes") != std::string::npos);
+    Simulator noStationSim(5, 0, Simulator::EngineMode::WORKER_POOL);
+    noStationSim.setWriteSummary(false);
+    REQUIRE_FALSE(noStationSim.startSimulator(error));
+    REQUIRE(error.find("stations") != std::string::npos);
+    REQUIRE(noStationSim.getTrucks().empty());
+
+    // The bounds follow the configuration
+    REQUIRE(Simulator::calcMaxHeliumPossible() == Simulator::calcMaxHeliumPossible(SimulationConfig()));
+    REQUIRE(Simulator::calcMaxHeliumPossible(options.config) < Simulator::calcMaxHeliumPossible());
+
+    // A configured run stays within the configured bounds
+    Simulator miningSim(options.numTrucks, options.numStations, options.engineMode);
+    miningSim.setConfig(options.config);
+    miningSim.setSeed(options.seed);
+    miningSim.setWriteSummary(false);
+    miningSim.startSimulator();
+    requireConsistentTotals(miningSim, 25, 2);
+    for (const Truck &truck : miningSim.getTruckView())
+    {
+        REQUIRE(truck.getMiningStats().getMin() >= 30);
+        REQUIRE(truck.getMiningStats().getMax() <= options.config.maxMiningMins);
+    }
+
+    // Both machine readable formats hold one record per Truck and Station
+    const SimulationResults results = miningSim.takeResults();
+    std::ostringstream csv;
+    results.writeCsv(csv);
+    const std::string csvText = csv.str();
+    REQUIRE(std::count(csvText.begin(), csvText.end(), '\n') == 1 + 25 + 2);
+    REQUIRE(csvText.rfind("record,id,helium,", 0) == 0);
+    std::ostringstream truckRow;
+    truckRow << "truck,3," << results.getTruck(3).getTotalMinedHelium() << ',';
+    REQUIRE(csvText.find(truckRow.str()) != std::string::npos);
+
+    std::ostringstream json;
+    results.writeJson(json);
+    const std::string jsonText = json.str();
+    REQUIRE(jsonText.find("\"trucks\": [") != std::string::npos);
+    REQUIRE(jsonText.find("{\"id\": 24, ") != std::string::npos);
+    REQUIRE(jsonText.find("\"stations\": [") != std::string::npos);
+    REQUIRE(std::count(jsonText.begin(), jsonText.end(), '{') == 1 + 25 + 2);
+}
+
+// Short shifts with a quick unload, folded into SimulatorT at compile time
+struct ShortShiftScenario
+{
+    static constexpr int kHorizonMins = 12 * 60;
+    static constexpr int kTravelTimeMins = 10;
+    static constexpr int kUnloadTimeMins = 8;
+    static constexpr int kHeliumPerMin = 2;
+    static constexpr int kMinMiningMins = 30;
+    static constexpr int kMaxMiningMins = 90;
+};
+
+// Every Truck and Station of the two runs must match field by field
+static void requireSameResults(const SimulationResults &expected, const SimulationResults &actual)
+{
+    REQUIRE(actual.getTrucks().size() == expected.getTrucks().size());
+    REQUIRE(actual.getStations().size() == expected.getStations().size());
+    for (const Truck &truck : expected.getTrucks())
+    {
+        const Truck &other = actual.getTruck(truck.getId());
+        REQUIRE(other.getTotalMinedHelium() == truck.getTotalMinedHelium());
+        REQUIRE(other.getTotalNumberUnloads() == truck.getTotalNumberUnloads());
+        REQUIRE(other.getTotalMiningTime() == truck.getTotalMiningTime());
+        REQUIRE(other.getTotalQueueWait() == truck.getTotalQueueWait());
+        REQUIRE(other.getMiningStats().getCount() == truck.getMiningStats().getCount());
+    }
+    for (const Station &station : expected.getStations())
+    {
+        REQUIRE(actual.getStation(station.getId()).getTotalHeliumReceived() == station.getTotalHeliumReceived());
+        REQUIRE(actual.getStation(station.getId()).getTotalTrucksUnloaded() == station.getTotalTrucksUnloaded());
+    }
+}
+
+TEST_CASE("Compile-time scenario engine.")
+{
+    // The bounds are compile-time constants and agree with the runtime ones
+    static_assert(SimulatorT<>::calcMaxHeliumPossible() > SimulatorT<>::calcMinHeliumPossible());
+    static_assert(SimulatorT<ShortShiftScenario>::kMinCycleMins == 30 + 20 + 8);
+    static_assert(SimulatorT<ShortShiftScenario>::calcMaxTripsPossible() == 720 / 58);
+    REQUIRE(SimulatorT<>::calcMinTripsPossible() == Simulator::calcMinTripsPossible());
+    REQUIRE(SimulatorT<>::calcMaxTripsPossible() == Simulator::calcMaxTripsPossible());
+    REQUIRE(SimulatorT<>::calcMinHeliumPossible() == Simulator::calcMinHeliumPossible());
+    REQUIRE(SimulatorT<>::calcMaxHeliumPossible() == Simulator::calcMaxHeliumPossible());
+    const SimulationConfig shortShift = SimulatorT<ShortShiftScenario>::getConfig();
+    REQUIRE(SimulatorT<ShortShiftScenario>::calcMaxHeliumPossible() == Simulator::calcMaxHeliumPossible(shortShift));
+    REQUIRE(SimulatorT<ShortShiftScenario>::calcMinHeliumPossible() == Simulator::calcMinHeliumPossible(shortShift));
+
+    // Same seed and scenario give the same run as EVENT_DRIVEN, with and without queueing
+    for (const int numStations : {1, 4, 30})
+    {
+        Simulator runtimeSim(120, numStations, Simulator::EngineMode::EVENT_DRIVEN);
+        runtimeSim.setSeed(13);
+        runtimeSim.setWriteSummary(false);
+        runtimeSim.startSimulator();
+
+        SimulatorT<> compileTimeSim(120, numStations);
+        compileTimeSim.setSeed(13);
+        compileTimeSim.startSimulator();
+        REQUIRE(compileTimeSim.getTruckView().size() == 120);
+        requireSameResults(runtimeSim.takeResults(), compileTimeSim.takeResults());
+    }
+
+    Simulator runtimeSim(60, 3, Simulator::EngineMode::EVENT_DRIVEN);
+    runtimeSim.setConfig(shortShift);
+    runtimeSim.setSeed(8);
+    runtimeSim.setWriteSummary(false);
+    runtimeSim.startSimulator();
+    requireConsistentTotals(runtimeSim, 60, 3);
+
+    SimulatorT<ShortShiftScenario> compileTimeSim(60, 3);
+    compileTimeSim.setSeed(8);
+    compileTimeSim.startSimulator();
+    const SimulationResults results = compileTimeSim.takeResults();
+    for (const Truck &truck : results.getTrucks())
+    {
+        REQUIRE(truck.getTotalMinedHelium() <= SimulatorT<ShortShiftScenario>::calcMaxHeliumPossible());
+        REQUIRE(truck.getMiningStats().getMin() >= 30);
+        REQUIRE(truck.getMiningStats().getMax() <= 90);
+    }
+    requireSameResults(runtimeSim.takeResults(), results);
+}
+
+// Hold model: pop an Event and schedule its successor, as the event loop does
+static std::vector<Event> runHoldModel(EventQueue &queue, const int numEvents, const int maxDelay, const int numHolds)
+{
+    RandomStream stream(5, 0);
+    long long sequence = 0;
+    for (int i = 0; i < numEvents; ++i)
+    {
+        queue.push(Event(stream.nextInRange(0, maxDelay), sequence++, Event::TRUCK_STATE_COMPLETE, i));
+    }
+
+    std::vector<Event> popped;
+    for (int i = 0; i < numHolds; ++i)
+    {
+        const Event event = queue.pop();
+        popped.push_back(event);
+
+        // Mix zero delays, unload and travel times and long mining times
+        const int delays[] = {0, 5, 30, stream.nextInRange(60, 300), stream.nextInRange(0, maxDelay)};
+        queue.push(Event(event.getTime() + delays[stream.nextInRange(0, 4)], sequence++, event.getType(), event.getId()));
+    }
+    while (!queue.empty())
+    {
+        popped.push_back(queue.pop());
+    }
+    return popped;
+}
+
+TEST_CASE("Pluggable event queues.")
+{
+    const EventQueue::Kind kinds[] = {EventQueue::Kind::BINARY_HEAP, EventQueue::Kind::PAIRING_HEAP,
+                                      EventQueue::Kind::CALENDAR_QUEUE, EventQueue::Kind::TIMING_WHEEL};
+
+    // Every structure pops in (time, sequence) order, also for delays that reach the higher wheel levels
+    for (const int maxDelay : {10, 300, 5000000})
+    {
+        std::vector<long long> referenceOrder;
+        for (const EventQueue::Kind kind : kinds)
+        {
+            std::unique_ptr<EventQueue> queue = EventQueue::create(kind);
+            const std::vector<Event> popped = runHoldModel(*queue, 2000, maxDelay, 20000);
+            REQUIRE(queue->size() == 0);
+            REQUIRE(popped.size() == 22000);
+            REQUIRE(std::is_sorted(popped.begin(), popped.end()));
+
+            std::vector<long long> order;
+            for (const Event &event : popped)
+            {
+                order.push_back(event.getSequence());
+            }
+            if (referenceOrder.empty())
+            {
+                referenceOrder = order;
+            }
+            REQUIRE(order == referenceOrder);
+        }
+    }
+
+    // The calendar grows and shrinks its buckets and picks a width from the event spacing
+    CalendarEventQueue calendar;
+    for (int i = 0; i < 1000; ++i)
+    {
+        calendar.push(Event(i * 10, i, Event::TRUCK_STATE_COMPLETE, i));
+    }
+    REQUIRE(calendar.getNumBuckets() >= 500);
+    REQUIRE(calendar.getBucketWidth() == 30);
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(calendar.pop().getTime() == i * 10);
+    }
+    REQUIRE(calendar.getNumBuckets() == CalendarEventQueue::kMinBuckets);
+
+    REQUIRE(std::string(EventQueue::getName(EventQueue::Kind::TIMING_WHEEL)) == "timing_wheel");
+
+    // EVENT_DRIVEN gives the same results on every structure
+    Simulator referenceSim(150, 4, Simulator::EngineMode::EVENT_DRIVEN);
+    referenceSim.setSeed(31);
+    referenceSim.setWriteSummary(false);
+    referenceSim.startSimulator();
+    const SimulationResults reference = referenceSim.takeResults();
+    for (const EventQueue::Kind kind : kinds)
+    {
+        Simulator miningSim(150, 4, Simulator::EngineMode::EVENT_DRIVEN);
+        miningSim.setSeed(31);
+        miningSim.setWriteSummary(false);
+        miningSim.setEventQueue(kind);
+        miningSim.startSimulator();
+        requireConsistentTotals(miningSim, 150, 4);
+        requireSameResults(reference, miningSim.takeResults());
+    }
+}
+
+TEST_CASE("Analytic queueing estimator.")
+{
+    // Erlang C against known values
+    REQUIRE(QueueingEstimator::calcErlangC(0.5, 1) == Approx(0.5));
+    REQUIRE(QueueingEstimator::calcErlangC(2.0, 3) == Approx(4.0 / 9.0));
+    REQUIRE(QueueingEstimator::calcErlangC(3.0, 3) == 1.0);
+
+    // Waits fall with more Stations and rise with more Trucks, the Stations never exceed full utilization
+    const QueueingEstimator estimator;
+    for (const int numTrucks : {10, 100, 1000})
+    {
+        double previousWait = std::numeric_limits<double>::infinity();
+        for (int numStations = 1; numStations <= 40; ++numStations)
+        {
+            const QueueingEstimator::Estimate estimate = estimator.estimate(numTrucks, numStations);
+            REQUIRE(estimate.utilization > 0.0);
+            REQUIRE(estimate.utilization <= 1.0);
+            REQUIRE(estimate.meanQueueWait <= previousWait);
+            REQUIRE(estimate.meanQueueLength == Approx(estimate.arrivalRate * estimate.meanQueueWait));
+            REQUIRE(estimate.arrivalRate == Approx(numTrucks / estimate.cycleTime));
+            previousWait = estimate.meanQueueWait;
+        }
+    }
+    REQUIRE(estimator.estimate(200, 4).meanQueueWait > estimator.estimate(100, 4).meanQueueWait);
+    REQUIRE(estimator.estimate(1000, 40).meanQueueWait < 0.01);
+
+    // Light, moderate and heavy load agree with the simulator
+    const QueueingEstimator::Validation light = estimator.validate(50, 4, 3, 2);
+    REQUIRE(std::abs(light.utilizationError) < 0.02);
+    REQUIRE(std::abs(light.queueWaitError) < 0.1);
+    REQUIRE(std::abs(light.unloadsError) < 0.2);
+
+    const QueueingEstimator::Validation moderate = estimator.validate(100, 4, 5, 2);
+    REQUIRE(std::abs(moderate.utilizationError) < 0.02);
+    REQUIRE(std::abs(moderate.queueWaitError) < 0.2);
+    REQUIRE(std::abs(moderate.unloadsError) < 0.2);
+
+    const QueueingEstimator::Validation heavy = estimator.validate(1000, 16, 7, 2);
+    REQUIRE(std::abs(heavy.utilizationError) < 0.03);
+    REQUIRE(std::abs(heavy.queueWaitError) < 0.1 * heavy.simulatedQueueWait);
+    REQUIRE(std::abs(heavy.unloadsError) < 0.05 * heavy.simulatedUnloadsPerTruck);
+    REQUIRE(heavy.estimateMicros < heavy.simulationMillis * 1000.0);
+
+    std::ostringstream csv;
+    QueueingEstimator::writeCsvHeader(csv, true);
+    QueueingEstimator::writeCsvRow(csv, 1000, 16, heavy);
+    const std::string text = csv.str();
+    REQUIRE(std::count(text.begin(), text.end(), '\n') == 2);
+    REQUIRE(text.find("\n1000,16,") != std::string::npos);
+}
+
+TEST_CASE("Arrival-stream Mining Simulation.")
+{
+    // The recursion picks up and assigns Stations like a brute-force scan of every Station's free time
+    for (const int numStations : {1, 3, 70, 5000})
+    {
+        WorkloadRecursion recursion(numStations, 5);
+        std::vector<int> freeTimes(numStations, 0);
+        RandomStream randomStream(11, 0);
+        int arrivalTime = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            arrivalTime += randomStream.nextInRange(0, 2) * randomStream.nextInRange(0, 1); // Many ties and bursts
+            const int pickupTime = std::max(arrivalTime, *std::min_element(freeTimes.begin(), freeTimes.end()));
+            const int expectedStation = static_cast<int>(std::find_if(freeTimes.begin(), freeTimes.end(), [&](const int freeTime)
+                                                                      { return freeTime <= pickupTime; }) -
+                                                         freeTimes.begin());
+            freeTimes[expectedStation] = pickupTime + 5;
+
+            int stationId = -1;
+            REQUIRE(recursion.serve(arrivalTime, stationId) == pickupTime);
+            REQUIRE(stationId == expectedStation);
+        }
+    }
+
+    // Same seed gives exactly the FIXED_STEP run, with and without queueing, large buckets and another configuration
+    SimulationConfig shortShift;
+    shortShift.horizonMins = 720;
+    shortShift.travelTimeMins = 10;
+    shortShift.unloadTimeMins = 8;
+    shortShift.minMiningMins = 30;
+    shortShift.maxMiningMins = 90;
+    const std::array<std::array<int, 2>, 4> fleets = {{{30, 3}, {200, 1}, {150, 9}, {20000, 800}}};
+    for (const std::array<int, 2> &fleet : fleets)
+    {
+        for (const bool isShortShift : {false, true})
+        {
+            Simulator fixedStepSim(fleet[0], fleet[1], Simulator::EngineMode::FIXED_STEP);
+            Simulator arrivalStreamSim(fleet[0], fleet[1], Simulator::EngineMode::ARRIVAL_STREAM);
+            for (Simulator *miningSim : {&fixedStepSim, &arrivalStreamSim})
+            {
+                miningSim->setSeed(23);
+                miningSim->setWriteSummary(false);
+                if (isShortShift)
+                {
+                    miningSim->setConfig(shortShift);
+                }
+                miningSim->startSimulator();
+            }
+            requireConsistentTotals(arrivalStreamSim, fleet[0], fleet[1]);
+            requireSameResults(fixedStepSim.takeResults(), arrivalStreamSim.takeResults());
+        }
+    }
+
+    // A traced run replays every transition on FIXED_STEP and still gives the same results
+    const std::string tracePath = "Mining_Simulator_Test_Arrival_Stream_Trace.bin";
+    Simulator fastSim(60, 2, Simulator::EngineMode::ARRIVAL_STREAM);
+    Simulator tracedSim(60, 2, Simulator::EngineMode::ARRIVAL_STREAM);
+    fastSim.setSeed(29);
+    tracedSim.setSeed(29);
+    fastSim.setWriteSummary(false);
+    tracedSim.setWriteSummary(false);
+    tracedSim.setTraceFile(tracePath);
+    fastSim.startSimulator();
+    tracedSim.startSimulator();
+    std::vector<TraceRecord> records;
+    REQUIRE(TraceFile::read(tracePath, records));
+    std::remove(tracePath.c_str());
+    REQUIRE(!records.empty());
+    requireSameResults(fastSim.takeResults(), tracedSim.takeResults());
+}
+
+TEST_CASE("Conservative parallel Mining Simulation.")
+{
+    // Travel shorter than unload makes the travel time the lookahead, a one minute lookahead syncs every minute
+    SimulationConfig shortTravel;
+    shortTravel.horizonMins = 600;
+    shortTravel.travelTimeMins = 3;
+    shortTravel.unloadTimeMins = 8;
+    shortTravel.minMiningMins = 20;
+    shortTravel.maxMiningMins = 60;
+    SimulationConfig minuteLookahead = shortTravel;
+    minuteLookahead.travelTimeMins = 1;
+    minuteLookahead.unloadTimeMins = 2;
+    const std::array<SimulationConfig, 3> configs = {SimulationConfig(), shortTravel, minuteLookahead};
+
+    // Same seed gives exactly the FIXED_STEP run for every number of Truck processes, including more processes than trucks
+    const std::array<std::array<int, 2>, 4> fleets = {{{3, 1}, {30, 3}, {200, 1}, {2000, 80}}};
+    for (const std::array<int, 2> &fleet : fleets)
+    {
+        for (const SimulationConfig &config : configs)
+        {
+            Simulator fixedStepSim(fleet[0], fleet[1], Simulator::EngineMode::FIXED_STEP);
+            fixedStepSim.setSeed(31);
+            fixedStepSim.setWriteSummary(false);
+            fixedStepSim.setConfig(config);
+            fixedStepSim.startSimulator();
+            const SimulationResults expected = fixedStepSim.takeResults();
+
+            for (const int numThreads : {1, 2, 3, 4})
+            {
+                Simulator conservativeSim(fleet[0], fleet[1], Simulator::EngineMode::CONSERVATIVE);
+                conservativeSim.setSeed(31);
+                conservativeSim.setWriteSummary(false);
+                conservativeSim.setConfig(config);
+                conservativeSim.setNumWorkerThreads(numThreads);
+                conservativeSim.startSimulator();
+                requireConsistentTotals(conservativeSim, fleet[0], fleet[1]);
+                requireSameResults(expected, conservativeSim.takeResults());
+            }
+        }
+    }
+
+    // Every transition is traced, exactly as many as FIXED_STEP records
+    const std::string fixedStepTracePath = "Mining_Simulator_Test_Conservative_Fixed_Step_Trace.bin";
+    const std::string conservativeTracePath = "Mining_Simulator_Test_Conservative_Trace.bin";
+    Simulator fixedStepSim(60, 2, Simulator::EngineMode::FIXED_STEP);
+    Simulator conservativeSim(60, 2, Simulator::EngineMode::CONSERVATIVE);
+    fixedStepSim.setTraceFile(fixedStepTracePath);
+    conservativeSim.setTraceFile(conservativeTracePath);
+    conservativeSim.setNumWorkerThreads(4);
+    for (Simulator *miningSim : {&fixedStepSim, &conservativeSim})
+    {
+        miningSim->setSeed(37);
+        miningSim->setWriteSummary(false);
+        miningSim->startSimulator();
+    }
+    std::vector<TraceRecord> fixedStepRecords;
+    std::vector<TraceRecord> conservativeRecords;
+    REQUIRE(TraceFile::read(fixedStepTracePath, fixedStepRecords));
+    REQUIRE(TraceFile::read(conservativeTracePath, conservativeRecords));
+    std::remove(fixedStepTracePath.c_str());
+    std::remove(conservativeTracePath.c_str());
+    REQUIRE(!conservativeRecords.empty());
+    REQUIRE(conservativeRecords.size() == fixedStepRecords.size());
+    requireSameResults(fixedStepSim.takeResults(), conservativeSim.takeResults());
+}
+
+TEST_CASE("Optimistic Time Warp Mining Simulation.")
+{
+    // Serves undone newest first restore the recursion exactly, checked against a recursion that never served them
+    for (const int numStations : {1, 3, 70})
+    {
+        RandomStream randomStream(41, static_cast<std::uint64_t>(numStations));
+        WorkloadRecursion reversible(numStations, 5);
+        WorkloadRecursion reference(numStations, 5);
+        std::vector<int> arrivals;
+        int arrivalTime = 0;
+        for (int step = 0; step < 5000; ++step)
+        {
+            arrivalTime += randomStream.nextInRange(0, 2) * randomStream.nextInRange(0, 1);
+            int stationId = -1;
+            reversible.serveReversibly(arrivalTime, stationId);
+            arrivals.push_back(arrivalTime);
+
+            // Now and then take back a few serves and serve later arrivals instead
+            if (randomStream.nextInRange(0, 9) == 0)
+            {
+                const int numUndone = std::min(static_cast<int>(reversible.getNumLoggedServes()), randomStream.nextInRange(1, 8));
+                for (int i = 0; i < numUndone; ++i)
+                {
+                    reversible.undoLastServe();
+                    arrivals.pop_back();
+                }
+            }
+            if (reversible.getNumLoggedServes() > 16)
+            {
+                // The oldest serves are final, replay them on the reference
+                for (int i = 0; i < 8; ++i)
+                {
+                    int referenceStation = -1;
+                    reference.serve(arrivals[arrivals.size() - reversible.getNumLoggedServes()], referenceStation);
+                    reversible.commitServes(1);
+                }
+            }
+        }
+
+        // Both recursions serve every further arrival alike
+        for (std::size_t i = arrivals.size() - reversible.getNumLoggedServes(); i < arrivals.size(); ++i)
+        {
+            int referenceStation = -1;
+            reference.serve(arrivals[i], referenceStation);
+        }
+        for (int step = 0; step < 1000; ++step)
+        {
+            arrivalTime += randomStream.nextInRange(0, 3);
+            int stationId = -1;
+            int referenceStation = -1;
+            REQUIRE(reversible.serveReversibly(arrivalTime, stationId) == reference.serve(arrivalTime, referenceStation));
+            REQUIRE(stationId == referenceStation);
+        }
+    }
+
+    // Same seed gives exactly the FIXED_STEP run for every number of threads, on low and high contention fleets
+    SimulationConfig shortShift;
+    shortShift.horizonMins = 720;
+    shortShift.travelTimeMins = 10;
+    shortShift.unloadTimeMins = 8;
+    shortShift.minMiningMins = 30;
+    shortShift.maxMiningMins = 90;
+    const std::array<std::array<int, 2>, 5> fleets = {{{3, 1}, {30, 3}, {1000, 3}, {200, 1}, {2000, 80}}};
+    for (const std::array<int, 2> &fleet : fleets)
+    {
+        for (const bool isShortShift : {false, true})
+        {
+            Simulator fixedStepSim(fleet[0], fleet[1], Simulator::EngineMode::FIXED_STEP);
+            fixedStepSim.setSeed(43);
+            fixedStepSim.setWriteSummary(false);
+            if (isShortShift)
+            {
+                fixedStepSim.setConfig(shortShift);
+            }
+            fixedStepSim.startSimulator();
+            const SimulationResults expected = fixedStepSim.takeResults();
+
+            for (const int numThreads : {1, 2, 4})
+            {
+                Simulator optimisticSim(fleet[0], fleet[1], Simulator::EngineMode::OPTIMISTIC);
+                optimisticSim.setSeed(43);
+                optimisticSim.setWriteSummary(false);
+                if (isShortShift)
+                {
+                    optimisticSim.setConfig(shortShift);
+                }
+                optimisticSim.setNumWorkerThreads(numThreads);
+                optimisticSim.startSimulator();
+                requireConsistentTotals(optimisticSim, fleet[0], fleet[1]);
+                requireSameResults(expected, optimisticSim.takeResults());
+
+                const Simulator::TimeWarpStats stats = optimisticSim.getTimeWarpStats();
+#ifndef DEBUG
+                REQUIRE(stats.numGvtRounds > 0);
+                REQUIRE(stats.peakSavedStates > 0);
+#endif
+                REQUIRE(stats.numAntiMessages >= 0);
+            }
+        }
+    }
+
+    // Traces cannot be rolled back, a traced run is conservative and still gives the same results
+    const std::string tracePath = "Mining_Simulator_Test_Optimistic_Trace.bin";
+    Simulator fastSim(60, 2, Simulator::EngineMode::OPTIMISTIC);
+    Simulator tracedSim(60, 2, Simulator::EngineMode::OPTIMISTIC);
+    tracedSim.setTraceFile(tracePath);
+    for (Simulator *miningSim : {&fastSim, &tracedSim})
+    {
+        miningSim->setSeed(47);
+        miningSim->setWriteSummary(false);
+        miningSim->setNumWorkerThreads(2);
+        miningSim->startSimulator();
+    }
+    std::vector<TraceRecord> records;
+    REQUIRE(TraceFile::read(tracePath, records));
+    std::remove(tracePath.c_str());
+    REQUIRE(!records.empty());
+    REQUIRE(tracedSim.getTimeWarpStats().numGvtRounds == 0);
+    requireSameResults(fastSim.takeResults(), tracedSim.takeResults());
+}
+
+TEST_CASE("Per-station dispatch policies.")
+{
+    // Policies choose from the loads, which count waiting and unloading Trucks and their expected work
+    RandomStream randomStream(9);
+    REQUIRE(Dispatcher::create(Dispatcher::Kind::SHARED_QUEUE, 3, 5) == nullptr);
+    std::unique_ptr<Dispatcher> shortestQueue = Dispatcher::create(Dispatcher::Kind::JOIN_SHORTEST_QUEUE, 3, 5);
+    REQUIRE(shortestQueue->dispatch(0, randomStream) == 0);
+    REQUIRE(shortestQueue->dispatch(0, randomStream) == 1);
+    REQUIRE(shortestQueue->dispatch(0, randomStream) == 2);
+    REQUIRE(shortestQueue->dispatch(1, randomStream) == 0);
+    REQUIRE(shortestQueue->getNumTrucks(0) == 2);
+    REQUIRE(shortestQueue->getExpectedWorkMins(0, 1) == 9);
+    REQUIRE(shortestQueue->getExpectedWorkMins(1, 7) == 0);
+    shortestQueue->completeUnload(1);
+    REQUIRE(shortestQueue->dispatch(2, randomStream) == 1);
+
+    std::unique_ptr<Dispatcher> leastWork = Dispatcher::create(Dispatcher::Kind::LEAST_EXPECTED_WORK, 2, 5);
+    REQUIRE(leastWork->dispatch(0, randomStream) == 0);
+    REQUIRE(leastWork->dispatch(0, randomStream) == 1);
+    REQUIRE(leastWork->dispatch(3, randomStream) == 0);
+    REQUIRE(leastWork->dispatch(4, randomStream) == 1);
+
+    std::unique_ptr<Dispatcher> roundRobin = Dispatcher::create(Dispatcher::Kind::ROUND_ROBIN, 3, 5);
+    for (int i = 0; i < 7; ++i)
+    {
+        REQUIRE(roundRobin->dispatch(i, randomStream) == i % 3);
+    }
+
+    // Of two Stations both are always compared, so the loads never differ by more than one Truck
+    std::unique_ptr<Dispatcher> twoChoices = Dispatcher::create(Dispatcher::Kind::POWER_OF_TWO, 2, 5);
+    for (int i = 0; i < 11; ++i)
+    {
+        twoChoices->dispatch(i, randomStream);
+        REQUIRE(std::abs(twoChoices->getNumTrucks(0) - twoChoices->getNumTrucks(1)) <= 1);
+    }
+    std::unique_ptr<Dispatcher> manyChoices = Dispatcher::create(Dispatcher::Kind::POWER_OF_TWO, 8, 5);
+    std::vector<int> numDispatched(8, 0);
+    for (int i = 0; i < 8000; ++i)
+    {
+        const int stationId = manyChoices->dispatch(i, randomStream);
+        REQUIRE(stationId >= 0);
+        REQUIRE(stationId < 8);
+        ++numDispatched[stationId];
+    }
+    REQUIRE(*std::min_element(numDispatched.begin(), numDispatched.end()) > 900);
+
+    RunOptions options;
+    std::string error;
+    REQUIRE(options.setOption("dispatch", "Power_Of_Two", error));
+    REQUIRE(options.dispatchKind == Dispatcher::Kind::POWER_OF_TWO);
+    REQUIRE_FALSE(options.setOption("dispatch", "nearest", error));
+    const char *unsupportedEngine[] = {"MiningSimulator", "--engine", "optimistic", "--dispatch", "round_robin"};
+    REQUIRE_FALSE(options.parseArguments(5, unsupportedEngine, error));
+    REQUIRE(error.find("round_robin") != std::string::npos);
+    const char *supportedEngine[] = {"MiningSimulator", "--dispatch", "round_robin", "--engine", "event_driven"};
+    RunOptions supportedOptions;
+    REQUIRE(supportedOptions.parseArguments(5, supportedEngine, error));
+    REQUIRE(std::string(Dispatcher::getName(Dispatcher::Kind::LEAST_EXPECTED_WORK)) == "least_expected_work");
+
+    auto runEventDriven = [](const int numTrucks, const int numStations, const Dispatcher::Kind kind)
+    {
+        Simulator miningSim(numTrucks, numStations, Simulator::EngineMode::EVENT_DRIVEN);
+        miningSim.setSeed(53);
+        miningSim.setWriteSummary(false);
+        miningSim.setDispatchPolicy(kind);
+        miningSim.startSimulator();
+        requireConsistentTotals(miningSim, numTrucks, numStations);
+        return miningSim.takeResults();
+    };
+
+    const SimulationResults singleStation = runEventDriven(40, 1, Dispatcher::Kind::SHARED_QUEUE);
+    const SimulationResults sharedQueue = runEventDriven(200, 4, Dispatcher::Kind::SHARED_QUEUE);
+    for (const Dispatcher::Kind kind : {Dispatcher::Kind::JOIN_SHORTEST_QUEUE, Dispatcher::Kind::POWER_OF_TWO,
+                                        Dispatcher::Kind::ROUND_ROBIN, Dispatcher::Kind::LEAST_EXPECTED_WORK})
+    {
+        // A single Station's queue is the shared FIFO, and every run replays from its seed
+        requireSameResults(singleStation, runEventDriven(40, 1, kind));
+        const SimulationResults dispatched = runEventDriven(200, 4, kind);
+        requireSameResults(dispatched, runEventDriven(200, 4, kind));
+
+        // Engines without per-station queues refuse the policy instead of running another engine
+        Simulator coroutineSim(200, 4, Simulator::EngineMode::COROUTINE);
+        coroutineSim.setWriteSummary(false);
+        coroutineSim.setDispatchPolicy(kind);
+        REQUIRE_FALSE(coroutineSim.startSimulator(error));
+        REQUIRE(error.find(Dispatcher::getName(kind)) != std::string::npos);
+        REQUIRE(coroutineSim.getTrucks().empty());
+        ReplicationRunner coroutineReplications(200, 4, 2, Simulator::EngineMode::COROUTINE);
+        REQUIRE_FALSE(coroutineReplications.setDispatchPolicy(kind, error));
+
+        if (kind == Dispatcher::Kind::ROUND_ROBIN)
+        {
+            // With a fixed unload time the k-th arrival waits for the (k - c)-th either way, so only the Stations differ
+            for (const Truck &truck : sharedQueue.getTrucks())
+            {
+                REQUIRE(dispatched.getTruck(truck.getId()).getTotalQueueWait() == truck.getTotalQueueWait());
+                REQUIRE(dispatched.getTruck(truck.getId()).getTotalMinedHelium() == truck.getTotalMinedHelium());
+            }
+            const auto [fewest, most] = std::minmax_element(dispatched.getStations().begin(), dispatched.getStations().end(),
+                                                            [](const Station &a, const Station &b)
+                                                            { return a.getTotalTrucksUnloaded() < b.getTotalTrucksUnloaded(); });
+            REQUIRE(most->getTotalTrucksUnloaded() - fewest->getTotalTrucksUnloaded() <= 1);
+        }
+    }
+
+    // Replications on the same seeds compare the policies; committing early loses the pooling of the shared FIFO
+    std::vector<ReplicationRunner::Statistic> queueWaits;
+    std::vector<ReplicationRunner::Statistic> heliumMined;
+    for (const Dispatcher::Kind kind : {Dispatcher::Kind::SHARED_QUEUE, Dispatcher::Kind::JOIN_SHORTEST_QUEUE, Dispatcher::Kind::POWER_OF_TWO})
+    {
+        ReplicationRunner replications(100, 2, 20);
+        replications.setMasterSeed(7);
+        replications.setNumWorkerThreads(2);
+        REQUIRE(replications.setDispatchPolicy(kind, error));
+        REQUIRE(replications.run(error));
+        queueWaits.push_back(replications.getStatistic(ReplicationRunner::TRUCK_QUEUE_WAIT));
+        heliumMined.push_back(replications.getStatistic(ReplicationRunner::TRUCK_HELIUM_MINED));
+    }
+    REQUIRE(queueWaits[0].mean < queueWaits[1].mean);
+    REQUIRE(queueWaits[1].mean < queueWaits[2].mean);
+    REQUIRE(heliumMined[0].mean > heliumMined[2].mean);
+
+    // THREADED stations each drain their own lane
+    for (const Dispatcher::Kind kind : {Dispatcher::Kind::JOIN_SHORTEST_QUEUE, Dispatcher::Kind::ROUND_ROBIN})
+    {
+        Simulator threadedSim(20, 3);
+        threadedSim.setSeed(53);
+        threadedSim.setWriteSummary(false);
+        threadedSim.setTimeScale(std::chrono::microseconds(20));
+        threadedSim.setDispatchPolicy(kind);
+        threadedSim.startSimulator();
+        requireConsistentTotals(threadedSim, 20, 3);
+        if (kind == Dispatcher::Kind::ROUND_ROBIN)
+        {
+            const std::vector<Station> stations = threadedSim.getStations();
+            const auto [fewest, most] = std::minmax_element(stations.begin(), stations.end(), [](const Station &a, const Station &b)
+                                                            { return a.getTotalTrucksUnloaded() < b.getTotalTrucksUnloaded(); });
+            REQUIRE(most->getTotalTrucksUnloaded() - fewest->getTotalTrucksUnloaded() <= 1);
+        }
+    }
+}
+
+TEST_CASE("Lock contention profiler.")
+{
+    // Small values are counted exactly, large ones within 1 / kSubBucketCount
+    HdrHistogram histogram;
+    REQUIRE(histogram.getValueAtPercentile(50.0) == 0);
+    for (std::uint64_t value = 1; value <= 200; ++value)
+    {
+        histogram.record(value);
+    }
+    REQUIRE(histogram.getCount() == 200);
+    REQUIRE(histogram.getTotal() == 20100);
+    REQUIRE(histogram.getMin() == 1);
+    REQUIRE(histogram.getValueAtPercentile(50.0) == 100);
+    REQUIRE(histogram.getValueAtPercentile(99.0) == 198);
+    REQUIRE(histogram.getValueAtPercentile(100.0) == 200);
+
+    HdrHistogram slowHistogram;
+    for (std::uint64_t value = 1; value <= 1000; ++value)
+    {
+        slowHistogram.record(value * 1000003);
+    }
+    slowHistogram.record(UINT64_MAX);
+    REQUIRE(slowHistogram.getMax() == UINT64_MAX);
+    for (const double percentile : {10.0, 50.0, 90.0, 99.0})
+    {
+        const double exact = std::ceil(percentile * 10.01) * 1000003.0;
+        const double value = static_cast<double>(slowHistogram.getValueAtPercentile(percentile));
+        REQUIRE(value >= exact);
+        REQUIRE(value <= exact * (1.0 + 1.0 / HdrHistogram::kSubBucketCount));
+    }
+
+    histogram.add(slowHistogram);
+    REQUIRE(histogram.getCount() == 1201);
+    REQUIRE(histogram.getMin() == 1);
+    REQUIRE(histogram.getMax() == UINT64_MAX);
+    histogram.reset();
+    REQUIRE(histogram.getCount() == 0);
+    REQUIRE(histogram.getMax() == 0);
+
+    ProfiledMutex mutex("testMutex");
+    long long counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&mutex, &counter]()
+                             {
+            for (int i = 0; i < 2000; ++i)
+            {
+                std::lock_guard<ProfiledMutex> lock(mutex);
+                ++counter;
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(counter == 8000);
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+
+    // A thread that blocks behind a 2 ms hold is contended
+    std::thread holder;
+    {
+        std::unique_lock<ProfiledMutex> lock(mutex);
+        holder = std::thread([&mutex]()
+                             { std::lock_guard<ProfiledMutex> waitingLock(mutex); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    holder.join();
+
+    std::ostringstream summary;
+    Simulator miningSim(10, 2);
+    miningSim.setSeed(5);
+    miningSim.setTimeScale(std::chrono::microseconds(20));
+    miningSim.setSummaryOutput(summary);
+    miningSim.startSimulator();
+    requireConsistentTotals(miningSim, 10, 2);
+
+#ifdef DEBUG
+    ProfiledMutex::Profile profile = mutex.getProfile();
+    REQUIRE(std::string(profile.name) == "testMutex");
+    REQUIRE(profile.numAcquisitions == 8003);
+    REQUIRE(profile.numContended >= 1);
+    REQUIRE(profile.numContended <= profile.numAcquisitions);
+    REQUIRE(profile.waitHistogram.getCount() == 8003);
+    REQUIRE(profile.holdHistogram.getCount() == 8003);
+    REQUIRE(profile.waitHistogram.getTotal() == static_cast<std::uint64_t>(profile.totalWait.count()));
+    REQUIRE(profile.holdHistogram.getTotal() == static_cast<std::uint64_t>(profile.totalHold.count()));
+    REQUIRE(profile.waitHistogram.getMax() >= 1000000);
+    REQUIRE(profile.holdHistogram.getMax() >= 2000000);
+    mutex.resetProfile();
+    REQUIRE(mutex.getProfile().numAcquisitions == 0);
+
+    // Every Truck and Station pushes its results once under the results lock
+    REQUIRE(summary.str().find("LOCK resultsMutex CONTENTION RESULTS:\n"
+                               "Acquisitions                             = 12\n") != std::string::npos);
+    REQUIRE(summary.str().find("LOCK summaryMutex CONTENTION RESULTS:") != std::string::npos);
+    REQUIRE(summary.str().find("Hold p50 / p99 / Max") != std::string::npos);
+
+    // Every unload ends one blocking wait of its Truck, and the Stations' waits for Trucks are reported too
+    int totalTruckUnloadSum = 0;
+    for (const Truck &truck : miningSim.getTruckView())
+    {
+        totalTruckUnloadSum += truck.getTotalNumberUnloads();
+    }
+    REQUIRE(summary.str().find("BLOCKING truckUnloadWait RESULTS:\n"
+                               "Waits                                    = " +
+                               std::to_string(totalTruckUnloadSum) + "\n") != std::string::npos);
+    REQUIRE(summary.str().find("BLOCKING stationIdleWait RESULTS:") != std::string::npos);
+    REQUIRE(summary.str().find("Share of Thread Time") != std::string::npos);
+#else
+    // Release builds keep nothing but the std::mutex and print no report
+    REQUIRE(sizeof(ProfiledMutex) == sizeof(std::mutex));
+    REQUIRE(summary.str().find("CONTENTION RESULTS") == std::string::npos);
+    REQUIRE(summary.str().find("BLOCKING") == std::string::npos);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+// TraceDecoder: turns a binary trace written by Simulator::setTraceFile() back into
+// the debugging log's text form or into CSV.
+//
+// Usage: TraceDecoder <trace file> [--csv]
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../include/TraceFile.h"
+
+namespace
+{
+    void printCsv(const std::vector<TraceRecord> &records)
+    {
+        std::cout << "timestamp,truck_id,station_id,old_state,new_state,helium,queue_wait" << '\n';
+        for (const auto &record : records)
+        {
+            std::cout << record.timestamp << ',' << record.truckId << ',' << record.stationId << ','
+                      << TraceFile::getStateName(record.oldState) << ',' << TraceFile::getStateName(record.newState) << ','
+                      << record.helium << ',' << record.queueWait << '\n';
+        }
+    }
+
+    void printText(const std::vector<TraceRecord> &records)
+    {
+        for (const auto &record : records)
+        {
+            switch (record.oldState)
+            {
+            case Truck::State::MINING:
+                std::cout << "Mining truck id = " << record.truckId << "; state = MINING state; current helium = "
+                          << record.helium
+                          << "; elapsed time = " << record.timestamp << "." << '\n';
+                break;
+            case Truck::State::TRAVEL_TO_UNLOAD_STATION:
+                std::cout << "Mining truck id = " << record.truckId << "; state = TRAVEL_TO_UNLOAD_STATION; "
+                          << "elapsed time = " << record.timestamp << "." << '\n';
+                break;
+            case Truck::State::UNLOADING:
+                std::cout << "Station id = " << record.stationId << "; unloading truck id = " << record.truckId
+                          << "; currentTripQueueWait = " << record.queueWait << "; current helium collected = "
+                          << record.helium << "; elapsed time = " << record.timestamp << "." << '\n';
+                break;
+            case Truck::State::TRAVEL_TO_MINING_SITE:
+                std::cout << "Mining truck id = " << record.truckId << "; state = TRAVEL_TO_MINING_SITE; "
+                          << "elapsed time = " << record.timestamp << "." << '\n';
+                break;
+            default:
+                std::cout << "Error! Mining truck id = " << record.truckId << " unknown truck state." << '\n';
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3 || (argc == 3 && std::string(argv[2]) != "--csv"))
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [--csv]" << std::endl;
+        return 1;
+    }
+
+    std::vector<TraceRecord> records;
+    if (!TraceFile::read(argv[1], records))
+    {
+        std::cerr << "Error! " << argv[1] << " is not a mining simulator trace file of version "
+                  << TraceFile::kVersion << "." << std::endl;
+        return 1;
+    }
+
+    if (argc == 3)
+    {
+        printCsv(records);
+    }
+    else
+    {
+        printText(records);
+    }
+    return 0;
+}